@@ -0,0 +1,260 @@
+#include "include/benchmark.hpp"
+#include "../../include/lammp/binsplit.hpp"
+#include "../../include/lammp/numeral_table.h"
+#include "../../include/lammp/thread_pool.hpp"
+#include <cmath>
+#include <cstring>
+#include <cstdlib>
+
+#ifdef _WIN32
+#define PSAPI_VERSION 2
+#include <windows.h>
+#include <psapi.h>
+#define popen _popen
+#define pclose _pclose
+#else
+#include <sys/resource.h>
+#endif
+
+/*
+ * 端到端基准：Chudnovsky 公式计算 pi 的十进制展开，覆盖库的全部热点路径
+ *   pi = 426880 sqrt(10005) / S，S = sum a(k) prod p(j) / q(j)
+ *   p(k) = -(6k - 5)(2k - 1)(6k - 1)，q(k) = k^3 * 640320^3 / 24，a(k) = 13591409 + 545140134k
+ * 分阶段计时：二分求和（含一次大除法）、平方根、除法、十进制转换，并给出进程的峰值内存
+ *
+ * 用法：LammpBenchPi [位数 ...] [-t 线程数,线程数,...]
+ *   默认计算 10^6、10^7、10^8 位。多个规模时每个规模重新启动自身、在单独的子进程中计算，
+ *   峰值内存因而只属于该规模；给出 -t 时对每个线程数（环境变量 LAMMP_NUM_THREADS）与规模各启动一次，
+ *   汇总各规模的总耗时与相对第一个线程数的加速比
+ */
+
+namespace {
+
+using namespace lammp;
+using namespace lammp::Arithmetic;
+
+const char* PI_PREFIX = "31415926535897932384626433832795028841971693993751";
+
+// 640320^3 / 24
+constexpr lamp_ui CHUD_C3_24 = 10939058860032000ull;
+
+// 每项约 log10(640320^3 / 1728) 位
+constexpr double CHUD_DIGITS_PER_TERM = 14.181647462725477;
+
+// x *= m，返回新的长度，x 须多留一个字
+lamp_ui _mul_word(lamp_ptr x, lamp_ui len, lamp_ui m) {
+    lamp_ui carry = 0;
+    for (lamp_ui i = 0; i < len; i++) {
+        lamp_ui lo, hi;
+        mul64x64to128(x[i], m, lo, hi);
+        lo += carry;
+        hi += lo < carry;
+        x[i] = lo;
+        carry = hi;
+    }
+    x[len] = carry;
+    return carry != 0 ? len + 1 : len;
+}
+
+BinSplitSeries chudnovsky() {
+    BinSplitSeries s;
+    s.p = [](lamp_ui k, lamp_ptr out, bool& neg) -> lamp_ui {
+        out[0] = 1;
+        if (k == 0) {
+            return 1;
+        }
+        neg = true;
+        out[0] = (6 * k - 5) * (6 * k - 1);
+        return _mul_word(out, 1, 2 * k - 1);
+    };
+    s.q = [](lamp_ui k, lamp_ptr out, bool&) -> lamp_ui {
+        out[0] = 1;
+        if (k == 0) {
+            return 1;
+        }
+        out[0] = k * k;
+        lamp_ui len = _mul_word(out, 1, k);
+        return _mul_word(out, len, CHUD_C3_24);
+    };
+    s.a = [](lamp_ui k, lamp_ptr out, bool&) -> lamp_ui {
+        out[0] = 13591409;
+        out[1] = 0;
+        lamp_ui lo, hi;
+        mul64x64to128(545140134ull, k, lo, hi);
+        out[0] += lo;
+        out[1] = hi + (out[0] < lo);
+        return out[1] != 0 ? 2 : 1;
+    };
+    return s;
+}
+
+// 进程的峰值内存（MiB），计入进程启动以来的全部分配
+double peak_memory_mib() {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS pmc;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc))) {
+        return double(pmc.PeakWorkingSetSize) / (1024.0 * 1024.0);
+    }
+    return 0;
+#else
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+    return double(usage.ru_maxrss) / (1024.0 * 1024.0);
+#else
+    return double(usage.ru_maxrss) / 1024.0;
+#endif
+#endif
+}
+
+double elapsed_ms(std::chrono::high_resolution_clock::time_point& last) {
+    auto now = std::chrono::high_resolution_clock::now();
+    double ms = std::chrono::duration<double, std::milli>(now - last).count();
+    last = now;
+    return ms;
+}
+
+// 计算 pi 的前 digits 位小数，返回总耗时（毫秒）
+double run_pi(lamp_ui digits) {
+    const lamp_ui frac_bits = lamp_ui(std::ceil(double(digits) * std::log2(10.0))) + 64;
+    const lamp_ui terms = lamp_ui(double(digits) / CHUD_DIGITS_PER_TERM) + 2;
+    auto start = std::chrono::high_resolution_clock::now();
+    auto last = start;
+
+    // 1. 二分求和：s = S * 2^frac_bits
+    BinSplitNum s;
+    binary_split_fixed(chudnovsky(), terms, frac_bits, s);
+    const double t_series = elapsed_ms(last);
+
+    // 2. 平方根：root = sqrt(10005) * 2^frac_bits
+    const lamp_ui x_len = 2 * frac_bits / 64 + 2;
+    _internal_buffer<0> x(x_len, 0);
+    lamp_ui c = 10005;
+    lshift_bits(&c, 1, x.data(), 2 * frac_bits);
+    _internal_buffer<0> root(x_len / 2 + 1, 0);
+    abs_sqrtrem64(x.data(), x_len, root.data());
+    lamp_ui root_len = rlz(root.data(), x_len / 2 + 1);
+    const double t_sqrt = elapsed_ms(last);
+
+    // 3. 除法：pi * 2^frac_bits = 426880 * root * 2^frac_bits / s
+    root_len = _mul_word(root.data(), root_len, 426880);
+    const lamp_ui num_len = root_len + frac_bits / 64 + 1;
+    _internal_buffer<0> num(num_len, 0);
+    lshift_bits(root.data(), root_len, num.data(), frac_bits);
+    const lamp_ui num_rlz = rlz(num.data(), num_len);
+    _internal_buffer<0> pi(num_rlz - s.len + 2, 0);
+    abs_div64(num.data(), num_rlz, s.buf.data(), s.len, pi.data());
+    const lamp_ui pi_len = rlz(pi.data(), num_rlz - s.len + 2);
+    const double t_div = elapsed_ms(last);
+
+    // 4. 十进制转换：pi * 10^digits = (pi * 2^frac_bits * 5^digits) >> (frac_bits - digits)
+    lamp_ui five = 5;
+    _internal_buffer<0> p5(get_pow_len(&five, 1, digits));
+    const lamp_ui p5_len = abs_pow64(&five, 1, digits, p5.data());
+    _internal_buffer<0> scaled(pi_len + p5_len + 1, 0);
+    abs_mul64(pi.data(), pi_len, p5.data(), p5_len, scaled.data());
+    lamp_ui scaled_len = rlz(scaled.data(), pi_len + p5_len);
+    rshift_bits(scaled.data(), scaled_len, scaled.data(), frac_bits - digits);
+    scaled_len = rlz(scaled.data(), scaled_len - (frac_bits - digits) / 64);
+    _internal_buffer<0> dec(Numeral::get_buffer_size(scaled_len, GET_BASE_D(10)), 0);
+    const lamp_ui dec_len = Numeral::binary2base(scaled.data(), scaled_len, 10, dec.data());
+    // 每个字为 10^19 进制的一位，高位在前写出字符
+    std::string str = std::to_string(dec.data()[dec_len - 1]);
+    const size_t head = str.size();
+    str.resize(head + 19 * (dec_len - 1));
+    for (lamp_ui i = dec_len - 1; i > 0; i--) {
+        Numeral::base_num2str(dec.data()[i - 1], 10, 19, &str[head + 19 * (dec_len - 1 - i)], true);
+    }
+    const double t_radix = elapsed_ms(last);
+    const double total = std::chrono::duration<double, std::milli>(last - start).count();
+
+    const bool ok = str.size() == digits + 1 && str.compare(0, 50, PI_PREFIX) == 0;
+    std::cout << std::fixed << std::setprecision(1) << digits << " digits, " << terms << " terms, "
+              << ThreadPool::global().concurrency() << " threads: series " << t_series << " ms, sqrt " << t_sqrt
+              << " ms, div " << t_div << " ms, radix " << t_radix << " ms, total " << total << " ms, peak "
+              << peak_memory_mib() << " MiB" << (ok ? "" : " (mismatch)") << std::endl;
+    std::cout << "  ..." << str.substr(str.size() - std::min<size_t>(str.size(), 20)) << std::endl;
+    return total;
+}
+
+// 重新启动自身计算 digits 位（threads 非 0 时设置 LAMMP_NUM_THREADS = threads），转发子进程的输出，
+// 返回总耗时，失败时返回 0
+double run_child(const std::string& self, lamp_ui digits, lamp_ui threads) {
+    if (threads != 0) {
+        std::string env = std::to_string(threads);
+#ifdef _WIN32
+        _putenv_s("LAMMP_NUM_THREADS", env.c_str());
+#else
+        setenv("LAMMP_NUM_THREADS", env.c_str(), 1);
+#endif
+    }
+    const std::string cmd = "\"" + self + "\" " + std::to_string(digits);
+    FILE* pipe = popen(cmd.c_str(), "r");
+    if (pipe == nullptr) {
+        return 0;
+    }
+    double total = 0;
+    char line[1024];
+    while (std::fgets(line, sizeof(line), pipe) != nullptr) {
+        std::cout << line;
+        const char* pos = std::strstr(line, "total ");
+        if (pos != nullptr) {
+            total = std::atof(pos + 6);
+        }
+    }
+    pclose(pipe);
+    return total;
+}
+
+};  // namespace
+
+int main(int argc, char** argv) {
+    std::vector<lamp_ui> digits;
+    std::vector<lamp_ui> threads;
+    for (int i = 1; i < argc; i++) {
+        const std::string arg = argv[i];
+        if (arg == "-t" && i + 1 < argc) {
+            const std::string list = argv[++i];
+            for (size_t pos = 0; pos < list.size();) {
+                size_t end = list.find(',', pos);
+                end = end == std::string::npos ? list.size() : end;
+                threads.push_back(std::stoull(list.substr(pos, end - pos)));
+                pos = end + 1;
+            }
+        } else {
+            digits.push_back(std::stoull(arg));
+        }
+    }
+    if (digits.empty()) {
+        digits = {1000000, 10000000, 100000000};
+    }
+    if (threads.empty()) {
+        if (digits.size() == 1) {
+            run_pi(digits[0]);
+            return 0;
+        }
+        for (lamp_ui d : digits) {
+            run_child(argv[0], d, 0);
+        }
+        return 0;
+    }
+
+    std::vector<std::vector<double>> totals(threads.size());
+    for (size_t j = 0; j < threads.size(); j++) {
+        for (lamp_ui d : digits) {
+            totals[j].push_back(run_child(argv[0], d, threads[j]));
+        }
+    }
+    std::cout << std::fixed << std::setprecision(1) << "thread scaling (total ms, speedup over " << threads[0] << " threads):" << std::endl;
+    for (size_t i = 0; i < digits.size(); i++) {
+        std::cout << "  " << digits[i] << " digits:";
+        for (size_t j = 0; j < threads.size(); j++) {
+            if (totals[j][i] > 0 && totals[0][i] > 0) {
+                std::cout << "  " << threads[j] << "t " << totals[j][i] << " (x" << std::setprecision(2)
+                          << totals[0][i] / totals[j][i] << std::setprecision(1) << ")";
+            }
+        }
+        std::cout << std::endl;
+    }
+    return 0;
+}
@@ -43,5 +43,15 @@ inline void mul64x64to128_buildin(uint64_t a, uint64_t b, uint64_t& low, uint64_
 
 void bench_barrett_2powN();
 void bench_knuth_div();
+void bench_pow_mod_batch();
+void bench_gcd();
+void bench_is_prime();
+void bench_fib();
+void bench_mod_multi();
+void bench_crt();
+void bench_binsplit();
+void bench_mat22();
+void bench_sqr_mod();
+void bench_numeral();
 
 #endif  // __BENCHMARK_HPP__
@@ -0,0 +1,67 @@
+#include "../include/benchmark.hpp"
+#include "../../../include/lammp/binsplit.hpp"
+#include <cmath>
+
+// 二分求和的端到端耗时：e = sum 1/k! 与 ln2 = 2 atanh(1/3)，分为二分与最后一次除法，与一次结果规模的乘法比较
+void bench_binsplit() {
+    using namespace lammp;
+    using namespace lammp::Arithmetic;
+
+    BinSplitSeries e_series;
+    e_series.p = [](lamp_ui, lamp_ptr out, bool&) -> lamp_ui {
+        out[0] = 1;
+        return 1;
+    };
+    e_series.q = [](lamp_ui k, lamp_ptr out, bool&) -> lamp_ui {
+        out[0] = k == 0 ? 1 : k;
+        return 1;
+    };
+    e_series.a = e_series.p;
+
+    // ln2 = sum 2 / (3 (2k + 1) 9^k)
+    BinSplitSeries ln2_series;
+    ln2_series.p = e_series.p;
+    ln2_series.q = [](lamp_ui k, lamp_ptr out, bool&) -> lamp_ui {
+        out[0] = k == 0 ? 3 : 9;
+        return 1;
+    };
+    ln2_series.a = [](lamp_ui, lamp_ptr out, bool&) -> lamp_ui {
+        out[0] = 2;
+        return 1;
+    };
+    ln2_series.b = [](lamp_ui k, lamp_ptr out, bool&) -> lamp_ui {
+        out[0] = 2 * k + 1;
+        return 1;
+    };
+
+    for (lamp_ui bits : {1000000ull, 10000000ull}) {
+        // e：log2(n!) > bits；ln2：每项约 log2(9) 位
+        lamp_ui e_terms = 1;
+        for (double acc = 0; acc < double(bits); e_terms++) {
+            acc += std::log2(double(e_terms));
+        }
+        const lamp_ui ln2_terms = lamp_ui(double(bits) / std::log2(9.0)) + 1;
+        for (int which = 0; which < 2; which++) {
+            const BinSplitSeries& series = which == 0 ? e_series : ln2_series;
+            const lamp_ui n = which == 0 ? e_terms : ln2_terms;
+
+            auto start = std::chrono::high_resolution_clock::now();
+            BinSplitNum Q, B, T;
+            binary_split(series, n, nullptr, Q, &B, T);
+            auto mid = std::chrono::high_resolution_clock::now();
+            BinSplitNum out;
+            binary_split_fixed(series, n, bits, out);
+            auto end = std::chrono::high_resolution_clock::now();
+            const lamp_ui half = (out.len + 1) / 2;
+            _internal_buffer<0> prod(2 * half);
+            abs_mul64(out.buf.data(), half, out.buf.data() + out.len - half, half, prod.data());
+            auto mul_end = std::chrono::high_resolution_clock::now();
+
+            auto split = std::chrono::duration_cast<std::chrono::microseconds>(mid - start).count();
+            auto total = std::chrono::duration_cast<std::chrono::microseconds>(end - mid).count();
+            auto mul = std::chrono::duration_cast<std::chrono::microseconds>(mul_end - end).count();
+            std::cout << (which == 0 ? "e" : "ln2") << ", " << bits << " bits, " << n << " terms: split " << split
+                      << " us, split + div " << total << " us, one mul of half size " << mul << " us" << std::endl;
+        }
+    }
+}
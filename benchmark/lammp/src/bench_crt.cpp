@@ -0,0 +1,54 @@
+#include "../include/benchmark.hpp"
+#include "../../../include/lammp/prod_tree.hpp"
+
+// 由 k 个 62 位素数重建：构造计划（乘积树与 s_i）与单次重建的耗时，与一次结果规模的乘法比较
+void bench_crt() {
+    using namespace lammp;
+    using namespace lammp::Arithmetic;
+
+    std::mt19937_64 rng(136);
+    for (lamp_ui k : {1000ull, 10000ull, 100000ull}) {
+        std::vector<lamp_ui> mods(k), res(k);
+        for (lamp_ui i = 0; i < k; i++) {
+            do {
+                mods[i] = (rng() >> 2) | (1ull << 61) | 1;
+            } while (!abs_is_prime64(&mods[i], 1));
+            res[i] = rng() % mods[i];
+        }
+        std::vector<lamp_ptr> mod_ptrs(k), res_ptrs(k);
+        std::vector<lamp_ui> lens(k, 1);
+        for (lamp_ui i = 0; i < k; i++) {
+            mod_ptrs[i] = &mods[i];
+            res_ptrs[i] = &res[i];
+        }
+
+        auto start = std::chrono::high_resolution_clock::now();
+        CrtPlan plan(mod_ptrs.data(), lens.data(), k);
+        auto mid = std::chrono::high_resolution_clock::now();
+        _internal_buffer<0> out(plan.size());
+        const lamp_ui out_len = plan.reconstruct(res_ptrs.data(), lens.data(), out.data());
+        auto end = std::chrono::high_resolution_clock::now();
+        const lamp_ui half = (out_len + 1) / 2;
+        _internal_buffer<0> prod(2 * half);
+        abs_mul64(out.data(), half, out.data() + out_len - half, half, prod.data());
+        auto mul_end = std::chrono::high_resolution_clock::now();
+
+        // 抽查几个余数
+        bool ok = true;
+        for (lamp_ui i = 0; i < k; i += k / 10) {
+            lamp_ui r = 0;
+            for (lamp_ui j = out_len; j > 0; j--) {
+                lamp_ui lo = out.data()[j - 1];
+                div128by64to64(r, lo, mods[i]);
+                r = lo;
+            }
+            ok = ok && r == res[i];
+        }
+
+        auto build = std::chrono::duration_cast<std::chrono::microseconds>(mid - start).count();
+        auto rebuild = std::chrono::duration_cast<std::chrono::microseconds>(end - mid).count();
+        auto mul = std::chrono::duration_cast<std::chrono::microseconds>(mul_end - end).count();
+        std::cout << "k = " << k << ", len = " << out_len << ": plan " << build << " us, reconstruct " << rebuild
+                  << " us, one mul of half size " << mul << " us" << (ok ? "" : " (mismatch)") << std::endl;
+    }
+}
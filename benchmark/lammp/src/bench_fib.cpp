@@ -0,0 +1,27 @@
+#include "../include/benchmark.hpp"
+
+// 按 n 测试 abs_fib64，并与同规模的一次 abs_sqr64 比较：倍增每步两次平方，总耗时应接近最后一步平方的 2~3 倍
+void bench_fib() {
+    using namespace lammp;
+    using namespace lammp::Arithmetic;
+
+    for (lamp_ui n : {10000ull, 100000ull, 1000000ull, 10000000ull, 100000000ull}) {
+        const lamp_ui cap = get_fib_len(n);
+        _internal_buffer<0> f(cap), g(cap);
+        lamp_ui g_len = 0;
+
+        auto start = std::chrono::high_resolution_clock::now();
+        const lamp_ui f_len = abs_fib64(n, f.data(), g.data(), &g_len);
+        auto mid = std::chrono::high_resolution_clock::now();
+        // F(n) 约为最后一步平方结果的长度，取一半长度的平方作对照
+        const lamp_ui half = (f_len + 1) / 2;
+        _internal_buffer<0> sq(2 * half);
+        abs_sqr64(f.data(), half, sq.data());
+        auto end = std::chrono::high_resolution_clock::now();
+
+        auto fib = std::chrono::duration_cast<std::chrono::microseconds>(mid - start).count();
+        auto sqr = std::chrono::duration_cast<std::chrono::microseconds>(end - mid).count();
+        std::cout << "n = " << n << ", len = " << f_len << ": fib " << fib << " us, one square of len " << half << " "
+                  << sqr << " us, ratio " << double(fib) / std::max<long long>(sqr, 1) << std::endl;
+    }
+}
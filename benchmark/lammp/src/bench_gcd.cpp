@@ -0,0 +1,71 @@
+#include "../include/benchmark.hpp"
+
+// 多字二进制 GCD（Stein 算法），仅作为 abs_gcd64 的性能参照，a、b 会被改写
+static lamp_ui binary_gcd(lamp_ptr a, lamp_ui a_len, lamp_ptr b, lamp_ui b_len, lamp_ptr out) {
+    using namespace lammp;
+    using namespace lammp::Arithmetic;
+    auto ctz_words = [](lamp_ptr x, lamp_ui len) -> lamp_ui {
+        lamp_ui i = 0;
+        while (i < len && x[i] == 0) i++;
+        return i == len ? len * 64 : i * 64 + lammp_ctz(x[i]);
+    };
+    lamp_ui za = ctz_words(a, a_len), zb = ctz_words(b, b_len);
+    lamp_ui k = std::min(za, zb);
+    rshift_bits(a, a_len, a, za);
+    a_len = rlz(a, a_len - za / 64);
+    rshift_bits(b, b_len, b, zb);
+    b_len = rlz(b, b_len - zb / 64);
+    while (true) {
+        int cmp = abs_compare(a, a_len, b, b_len);
+        if (cmp == 0) {
+            break;
+        }
+        if (cmp < 0) {
+            std::swap(a, b);
+            std::swap(a_len, b_len);
+        }
+        abs_sub_binary(a, a_len, b, b_len, a);
+        a_len = rlz(a, a_len);
+        lamp_ui z = ctz_words(a, a_len);
+        rshift_bits(a, a_len, a, z);
+        a_len = rlz(a, a_len - z / 64);
+    }
+    std::fill(out, out + a_len + k / 64 + 1, 0);
+    if (k % 64 == 0) {
+        std::copy(a, a + a_len, out + k / 64);
+    } else {
+        lshift_in_word(a, a_len, out + k / 64, k % 64);
+    }
+    return rlz(out, a_len + k / 64 + 1);
+}
+
+// 比较 Lehmer / 半 GCD 实现的 abs_gcd64 与二进制 GCD
+void bench_gcd() {
+    using namespace lammp;
+    using namespace lammp::Arithmetic;
+
+    // generateRandomIntVector 使用固定种子，两次调用结果相同，这里自行生成
+    std::mt19937_64 rng(120);
+    for (int len : {8, 64, 256, 1024, 4096}) {
+        _internal_buffer<0> a(len), b(len), ta(len), tb(len);
+        for (int i = 0; i < len; i++) {
+            a.set(i, rng());
+            b.set(i, rng());
+        }
+        std::copy(a.data(), a.data() + len, ta.data());
+        std::copy(b.data(), b.data() + len, tb.data());
+        _internal_buffer<0> g1(len + 1, 0), g2(len + 1, 0);
+
+        auto start = std::chrono::high_resolution_clock::now();
+        lamp_ui g1_len = abs_gcd64(a.data(), len, b.data(), len, g1.data());
+        auto mid = std::chrono::high_resolution_clock::now();
+        lamp_ui g2_len = binary_gcd(ta.data(), len, tb.data(), len, g2.data());
+        auto end = std::chrono::high_resolution_clock::now();
+
+        auto fast = std::chrono::duration_cast<std::chrono::microseconds>(mid - start).count();
+        auto binary = std::chrono::duration_cast<std::chrono::microseconds>(end - mid).count();
+        bool same = g1_len == g2_len && std::equal(g1.data(), g1.data() + g1_len, g2.data());
+        std::cout << "len = " << len << ": abs_gcd64 " << fast << " us, binary " << binary << " us"
+                  << (same ? "" : " (mismatch)") << std::endl;
+    }
+}
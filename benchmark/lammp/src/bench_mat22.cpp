@@ -0,0 +1,50 @@
+#include "../include/benchmark.hpp"
+#include "../../../include/lammp/mat22.hpp"
+#include <random>
+
+// 2x2 矩阵乘法与平方的耗时，与逐项做 8 次独立乘法（加法不计）比较
+void bench_mat22() {
+    using namespace lammp;
+    using namespace lammp::Arithmetic;
+
+    std::mt19937_64 rng(39);
+    for (lamp_ui len : {64ull, 512ull, 4096ull, 65536ull, 524288ull}) {
+        std::vector<lamp_ui> data(len * 8);
+        for (auto& w : data) {
+            w = rng();
+        }
+        Mat22 a, b;
+        for (int i = 0; i < 4; i++) {
+            a.ptr[i] = data.data() + len * i;
+            b.ptr[i] = data.data() + len * (i + 4);
+            a.len[i] = b.len[i] = len;
+            a.neg[i] = b.neg[i] = false;
+        }
+        const lamp_ui cap = get_mat22_mul_len(a, b);
+        std::vector<lamp_ui> out(cap * 4), prod(len * 2 * 8);
+        Mat22 c;
+        for (int i = 0; i < 4; i++) {
+            c.ptr[i] = out.data() + cap * i;
+        }
+
+        auto t0 = std::chrono::high_resolution_clock::now();
+        mat22_mul(a, b, c);
+        auto t1 = std::chrono::high_resolution_clock::now();
+        mat22_mul(a, a, c);
+        auto t2 = std::chrono::high_resolution_clock::now();
+        // 逐项：8 次乘法，加法不计
+        for (int r = 0; r < 2; r++) {
+            for (int k = 0; k < 2; k++) {
+                abs_mul64(a.ptr[r * 2], len, b.ptr[k], len, prod.data() + len * 2 * (r * 4 + k * 2));
+                abs_mul64(a.ptr[r * 2 + 1], len, b.ptr[k + 2], len, prod.data() + len * 2 * (r * 4 + k * 2 + 1));
+            }
+        }
+        auto t3 = std::chrono::high_resolution_clock::now();
+
+        auto mul = std::chrono::duration_cast<std::chrono::microseconds>(t1 - t0).count();
+        auto sqr = std::chrono::duration_cast<std::chrono::microseconds>(t2 - t1).count();
+        auto naive = std::chrono::duration_cast<std::chrono::microseconds>(t3 - t2).count();
+        std::cout << "len " << len << ": mat22_mul " << mul << " us, mat22 square " << sqr << " us, 8 separate muls "
+                  << naive << " us" << std::endl;
+    }
+}
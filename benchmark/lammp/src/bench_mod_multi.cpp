@@ -0,0 +1,48 @@
+#include "../include/benchmark.hpp"
+
+// 一个大数对多个模数取模：余数树与逐个 abs_mod64 比较
+void bench_mod_multi() {
+    using namespace lammp;
+    using namespace lammp::Arithmetic;
+
+    std::mt19937_64 rng(135);
+    for (lamp_ui x_len : {10000ull, 100000ull}) {
+        for (lamp_ui mod_len : {1ull, 16ull}) {
+            for (lamp_ui count : {100ull, 1000ull, 10000ull}) {
+                _internal_buffer<0> x(x_len), mods(count * mod_len), outs(count * mod_len), ref(count * mod_len);
+                for (lamp_ui i = 0; i < x_len; i++) {
+                    x.set(i, rng());
+                }
+                std::vector<lamp_ptr> mod_ptrs(count), out_ptrs(count);
+                std::vector<lamp_ui> mod_lens(count, mod_len), out_lens(count);
+                for (lamp_ui i = 0; i < count; i++) {
+                    mod_ptrs[i] = mods.data() + i * mod_len;
+                    out_ptrs[i] = outs.data() + i * mod_len;
+                    for (lamp_ui j = 0; j < mod_len; j++) {
+                        mod_ptrs[i][j] = rng();
+                    }
+                    mod_ptrs[i][mod_len - 1] |= 1ull << 63;
+                }
+
+                auto start = std::chrono::high_resolution_clock::now();
+                abs_mod_multi64(x.data(), x_len, mod_ptrs.data(), mod_lens.data(), count, out_ptrs.data(),
+                                out_lens.data());
+                auto mid = std::chrono::high_resolution_clock::now();
+                // 逐个取模太慢，只做前 100 个再按比例折算
+                const lamp_ui naive_count = std::min<lamp_ui>(count, 100);
+                bool ok = true;
+                for (lamp_ui i = 0; i < naive_count; i++) {
+                    const lamp_ui len = abs_mod64(x.data(), x_len, mod_ptrs[i], mod_len, ref.data() + i * mod_len);
+                    ok = ok && len == out_lens[i] && std::equal(out_ptrs[i], out_ptrs[i] + len, ref.data() + i * mod_len);
+                }
+                auto end = std::chrono::high_resolution_clock::now();
+
+                auto tree = std::chrono::duration_cast<std::chrono::microseconds>(mid - start).count();
+                auto naive = std::chrono::duration_cast<std::chrono::microseconds>(end - mid).count() * count /
+                             naive_count;
+                std::cout << "x_len = " << x_len << ", mod_len = " << mod_len << ", count = " << count << ": tree "
+                          << tree << " us, naive " << naive << " us" << (ok ? "" : " (mismatch)") << std::endl;
+            }
+        }
+    }
+}
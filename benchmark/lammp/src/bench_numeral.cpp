@@ -0,0 +1,51 @@
+#include "../include/benchmark.hpp"
+#include "../../../include/lammp/numeral_table.h"
+#include <random>
+
+// 十进制转换的耗时：清空基数幂缓存后的首次转换与缓存命中后的再次转换，流式输出 binary2str，以及单个 base_num 位的格式化
+void bench_numeral() {
+    using namespace lammp;
+    using namespace lammp::Arithmetic;
+
+    std::mt19937_64 rng(41);
+    for (lamp_ui len : {1000ull, 10000ull, 100000ull}) {
+        std::vector<lamp_ui> x(len), in(len), digits(Numeral::get_buffer_size(len, GET_BASE_D(10)));
+        for (auto& w : x) {
+            w = rng();
+        }
+        Numeral::clear_pow_cache();
+        double ms[3];
+        for (int round = 0; round < 3; round++) {
+            in = x;
+            auto t0 = std::chrono::high_resolution_clock::now();
+            Numeral::binary2base(in.data(), len, 10, digits.data());
+            auto t1 = std::chrono::high_resolution_clock::now();
+            ms[round] = std::chrono::duration<double, std::milli>(t1 - t0).count();
+        }
+        // 高位在前的流式输出，字符只计数不保存
+        lamp_ui chars = 0;
+        auto t0 = std::chrono::high_resolution_clock::now();
+        Numeral::binary2str(x.data(), len, 10, [&](const char*, lamp_ui n) {
+            chars += n;
+            return true;
+        });
+        auto t1 = std::chrono::high_resolution_clock::now();
+        std::cout << "len " << len << ": binary2base cold " << ms[0] << " ms, cached " << ms[1] << " ms, "
+                  << ms[2] << " ms, binary2str " << std::chrono::duration<double, std::milli>(t1 - t0).count()
+                  << " ms (" << chars << " chars)" << std::endl;
+    }
+
+    // 单个 base_num 位写成 19 个十进制字符
+    std::vector<lamp_ui> limbs(1 << 20);
+    for (auto& w : limbs) {
+        w = rng() % 10000000000000000000ull;
+    }
+    std::vector<char> out(limbs.size() * 19);
+    auto t0 = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < limbs.size(); i++) {
+        Numeral::base_num2str(limbs[i], 10, 19, out.data() + i * 19, true);
+    }
+    auto t1 = std::chrono::high_resolution_clock::now();
+    std::cout << limbs.size() << " limbs: base_num2str " << std::chrono::duration<double, std::milli>(t1 - t0).count()
+              << " ms" << std::endl;
+}
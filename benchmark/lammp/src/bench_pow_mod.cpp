@@ -0,0 +1,40 @@
+#include "../include/benchmark.hpp"
+
+// 比较逐个调用 abs_pow_mod64 与共享模数、共享指数的 abs_pow_mod64_batch
+void bench_pow_mod_batch() {
+    using namespace lammp;
+    using namespace lammp::Arithmetic;
+
+    const int count = 2000;
+    for (int mod_len : {1, 4, 16, 64}) {
+        _internal_buffer<0> mod = generateRandomIntVector(mod_len);
+        _internal_buffer<0> exp = generateRandomIntVector(mod_len);
+        mod.set(0, mod[0] | 1);
+        mod.set(mod_len - 1, mod[mod_len - 1] | (1ull << 63));
+        std::vector<_internal_buffer<0>> bases;
+        std::vector<lamp_ptr> base_ptrs, out_ptrs;
+        std::vector<lamp_ui> base_lens(count, mod_len);
+        _internal_buffer<0> outs(count * mod_len);
+        for (int i = 0; i < count; i++) {
+            bases.push_back(generateRandomIntVector(mod_len));
+            base_ptrs.push_back(bases.back().data());
+            out_ptrs.push_back(outs.data() + i * mod_len);
+        }
+        lamp_ptr exp_ptr = exp.data();
+        lamp_ui exp_len = mod_len;
+
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < count; i++) {
+            abs_pow_mod64(base_ptrs[i], mod_len, exp_ptr, exp_len, mod.data(), mod_len, out_ptrs[i]);
+        }
+        auto mid = std::chrono::high_resolution_clock::now();
+        abs_pow_mod64_batch(base_ptrs.data(), base_lens.data(), count, &exp_ptr, &exp_len, 1, mod.data(), mod_len,
+                            out_ptrs.data());
+        auto end = std::chrono::high_resolution_clock::now();
+
+        auto single = std::chrono::duration_cast<std::chrono::microseconds>(mid - start).count();
+        auto batch = std::chrono::duration_cast<std::chrono::microseconds>(end - mid).count();
+        std::cout << "mod_len = " << mod_len << ", count = " << count << ": single " << single << " us, batch "
+                  << batch << " us" << std::endl;
+    }
+}
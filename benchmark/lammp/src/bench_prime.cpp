@@ -0,0 +1,56 @@
+#include "../include/benchmark.hpp"
+#include <memory>
+
+// 按位长测试 abs_is_prime64：随机奇数（绝大多数为合数）逐个测试与批量测试，以及素数上完整的 BPSW
+void bench_is_prime() {
+    using namespace lammp;
+    using namespace lammp::Arithmetic;
+
+    std::mt19937_64 rng(120);
+    for (int bits : {64, 256, 512, 1024, 2048, 4096}) {
+        const lamp_ui len = (bits + 63) / 64;
+        const int count = bits <= 512 ? 20000 : 40000000 / (bits * bits) + 100;
+        _internal_buffer<0> nums(count * len);
+        std::vector<lamp_ptr> ptrs(count);
+        std::vector<lamp_ui> lens(count, len);
+        for (int i = 0; i < count; i++) {
+            ptrs[i] = nums.data() + i * len;
+            for (lamp_ui j = 0; j < len; j++) {
+                ptrs[i][j] = rng();
+            }
+            ptrs[i][0] |= 1;
+            ptrs[i][len - 1] |= 1ull << 63;
+        }
+        std::unique_ptr<bool[]> res(new bool[count]);
+
+        auto start = std::chrono::high_resolution_clock::now();
+        int primes = 0;
+        for (int i = 0; i < count; i++) {
+            primes += abs_is_prime64(ptrs[i], len);
+        }
+        auto mid = std::chrono::high_resolution_clock::now();
+        abs_is_prime64_batch(ptrs.data(), lens.data(), count, res.get());
+        auto end = std::chrono::high_resolution_clock::now();
+
+        // 从第一个候选开始向上找一个素数，测完整 BPSW 的耗时
+        _internal_buffer<0> p(len + 1, 0);
+        std::copy(ptrs[0], ptrs[0] + len, p.data());
+        while (!abs_is_prime64(p.data(), len)) {
+            lamp_ui two = 2;
+            abs_add_binary_half(p.data(), len, &two, 1, p.data());
+        }
+        const int reps = 5;
+        auto p_start = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < reps; i++) {
+            primes += abs_is_prime64(p.data(), len);
+        }
+        auto p_end = std::chrono::high_resolution_clock::now();
+
+        auto single = std::chrono::duration_cast<std::chrono::microseconds>(mid - start).count();
+        auto batch = std::chrono::duration_cast<std::chrono::microseconds>(end - mid).count();
+        auto prime = std::chrono::duration_cast<std::chrono::microseconds>(p_end - p_start).count() / reps;
+        std::cout << "bits = " << bits << ", count = " << count << ": single " << single << " us, batch " << batch
+                  << " us, " << double(single) / count << " us per candidate, " << prime << " us per prime ("
+                  << primes - reps << " primes)" << std::endl;
+    }
+}
@@ -0,0 +1,33 @@
+#include "../include/benchmark.hpp"
+#include <random>
+
+// 模 2^p -+ 1 的平方：回绕卷积（p = 64 * 2^k）与完整平方后分块求和比较
+void bench_sqr_mod() {
+    using namespace lammp;
+    using namespace lammp::Arithmetic;
+
+    std::mt19937_64 rng(40);
+    for (lamp_ui p : {1ull << 14, 1ull << 16, 1ull << 18, 1ull << 20, 1ull << 22, 1ull << 24}) {
+        const lamp_ui len = p / 64;
+        std::vector<lamp_ui> x(len), out(len + 1), sqr(len * 2), rem(len + 1);
+        for (auto& w : x) {
+            w = rng();
+        }
+        x[len - 1] >>= 1;
+
+        auto t0 = std::chrono::high_resolution_clock::now();
+        abs_sqr_mod_mersenne64(x.data(), len, p, out.data());
+        auto t1 = std::chrono::high_resolution_clock::now();
+        abs_sqr_mod_fermat64(x.data(), len, p, out.data());
+        auto t2 = std::chrono::high_resolution_clock::now();
+        abs_sqr64(x.data(), len, sqr.data());
+        abs_mod_mersenne64(sqr.data(), len * 2, p, rem.data());
+        auto t3 = std::chrono::high_resolution_clock::now();
+
+        auto mersenne = std::chrono::duration_cast<std::chrono::microseconds>(t1 - t0).count();
+        auto fermat = std::chrono::duration_cast<std::chrono::microseconds>(t2 - t1).count();
+        auto full = std::chrono::duration_cast<std::chrono::microseconds>(t3 - t2).count();
+        std::cout << "p = " << p << ": sqr mod 2^p - 1 " << mersenne << " us, sqr mod 2^p + 1 " << fermat
+                  << " us, full square + reduce " << full << " us" << std::endl;
+    }
+}
@@ -794,9 +794,94 @@ define_conv_sqr(1)
 define_conv_sqr(2) 
 define_conv_sqr(3)
 
+/* 单独的正变换与逆变换，与 conv_* 的变换顺序相同，变换域中的值可以在多次乘法之间共享 */
+#define define_ntt_dif_long(_i)                                                                \
+    void ntt_dif_long_##_i(mont64* in_out, ntt_short* table, size_t ntt_len) {                 \
+        assert(in_out != NULL && table != NULL);                                               \
+        if (ntt_len <= long_threshold) {                                                       \
+            dif_func(in_out, table, ntt_len, _i);                                              \
+            return;                                                                            \
+        }                                                                                      \
+        const size_t quarter_len = ntt_len / 4;                                                \
+        mont64 unit_omega1 = g_root(_i);                                                       \
+        _mont64_tomont_func(unit_omega1, _i);                                                  \
+        unit_omega1 = _mont64_qpow_func_name(_i)(unit_omega1, (g_mod(_i) - 1) / ntt_len);      \
+        mont64 unit_omega3 = _mont64_qpow_func_name(_i)(unit_omega1, 3);                       \
+        mont64 omega1 = g_one(_i), omega3 = g_one(_i);                                         \
+        for (size_t ii = 0; ii < quarter_len; ii++) {                                          \
+            mont64 temp0 = in_out[ii], temp1 = in_out[quarter_len + ii];                       \
+            mont64 temp2 = in_out[quarter_len * 2 + ii], temp3 = in_out[quarter_len * 3 + ii]; \
+            _dif_butterfly244(temp0, temp1, temp2, temp3, _i);                                 \
+            in_out[ii] = temp0, in_out[quarter_len + ii] = temp1;                              \
+            _mont64_mul_func(in_out[quarter_len * 2 + ii], temp2, omega1, _i);                 \
+            _mont64_mul_func(in_out[quarter_len * 3 + ii], temp3, omega3, _i);                 \
+            _mont64_mulinto_func(omega1, unit_omega1, _i);                                     \
+            _mont64_mulinto_func(omega3, unit_omega3, _i);                                     \
+        }                                                                                      \
+        ntt_dif_long_##_i(in_out, table, ntt_len / 2);                                         \
+        ntt_dif_long_##_i(in_out + quarter_len * 2, table, ntt_len / 4);                       \
+        ntt_dif_long_##_i(in_out + quarter_len * 3, table, ntt_len / 4);                       \
+    }
+
+#define define_ntt_idit_long(_i)                                                                \
+    void ntt_idit_long_##_i(mont64* in_out, ntt_short* table, size_t ntt_len, bool norm) {      \
+        assert(in_out != NULL && table != NULL);                                                \
+        if (ntt_len <= long_threshold) {                                                        \
+            if (norm) {                                                                         \
+                mont64 inv_len = ntt_len;                                                       \
+                _mont64_tomont_func(inv_len, _i);                                               \
+                inv_len = _mont64_qpow_func_name(_i)(inv_len, ((g_mod(_i)) - 2));               \
+                for (size_t ii = 0; ii < ntt_len; ii++) {                                       \
+                    _mont64_mulinto_func(in_out[ii], inv_len, _i);                              \
+                }                                                                               \
+            }                                                                                   \
+            idit_func(in_out, table, ntt_len, _i);                                              \
+            return;                                                                             \
+        }                                                                                       \
+        const size_t quarter_len = ntt_len / 4;                                                 \
+        ntt_idit_long_##_i(in_out, table, ntt_len / 2, false);                                  \
+        ntt_idit_long_##_i(in_out + quarter_len * 2, table, ntt_len / 4, false);                \
+        ntt_idit_long_##_i(in_out + quarter_len * 3, table, ntt_len / 4, false);                \
+        mont64 unit_omega1 = g_rootinv(_i);                                                     \
+        _mont64_tomont_func(unit_omega1, _i);                                                   \
+        unit_omega1 = _mont64_qpow_func_name(_i)(unit_omega1, (g_mod(_i) - 1) / ntt_len);       \
+        mont64 unit_omega3 = _mont64_qpow_func_name(_i)(unit_omega1, 3);                        \
+        mont64 omega1 = g_one(_i), omega3 = g_one(_i), inv_len = g_one(_i);                     \
+        if (norm) {                                                                             \
+            inv_len = ntt_len;                                                                  \
+            _mont64_tomont_func(inv_len, _i);                                                   \
+            inv_len = _mont64_qpow_func_name(_i)(inv_len, (g_mod(_i) - 2));                     \
+            omega1 = inv_len, omega3 = inv_len;                                                 \
+        }                                                                                       \
+        for (size_t ii = 0; ii < quarter_len; ii++) {                                           \
+            mont64 temp0 = in_out[ii], temp1 = in_out[quarter_len + ii], temp2, temp3;          \
+            if (norm) {                                                                         \
+                _mont64_mul_func(temp0, in_out[ii], inv_len, _i);                               \
+                _mont64_mul_func(temp1, in_out[quarter_len + ii], inv_len, _i);                 \
+            }                                                                                   \
+            _mont64_mul_func(temp2, in_out[quarter_len * 2 + ii], omega1, _i);                  \
+            _mont64_mul_func(temp3, in_out[quarter_len * 3 + ii], omega3, _i);                  \
+            _idit_butterfly244(temp0, temp1, temp2, temp3, _i);                                 \
+            in_out[ii] = temp0, in_out[quarter_len + ii] = temp1;                               \
+            in_out[quarter_len * 2 + ii] = temp2, in_out[quarter_len * 3 + ii] = temp3;         \
+            _mont64_mulinto_func(omega1, unit_omega1, _i);                                      \
+            _mont64_mulinto_func(omega3, unit_omega3, _i);                                      \
+        }                                                                                       \
+    }
+
+define_ntt_dif_long(1) 
+define_ntt_dif_long(2) 
+define_ntt_dif_long(3)
+
+define_ntt_idit_long(1) 
+define_ntt_idit_long(2) 
+define_ntt_idit_long(3)
+
 #define conv_rec_func(in1, in2, out, table, ntt_len, _i) conv_rec_##_i(in1, in2, out, table, ntt_len, true)
 #define conv_sqr_func(in1, out, table, ntt_len, _i) conv_sqr_##_i(in1, out, table, ntt_len, true)
 #define conv_single_func(const_in1, in2, out, table, ntt_len, _i) conv_single_##_i(const_in1, in2, out, table, ntt_len, true)
+#define ntt_dif_long_func(in_out, table, ntt_len, _i) ntt_dif_long_##_i(in_out, table, ntt_len)
+#define ntt_idit_long_func(in_out, table, ntt_len, _i) ntt_idit_long_##_i(in_out, table, ntt_len, true)
 
 #undef define_dif
 #undef define_idit
@@ -815,6 +900,8 @@ define_conv_sqr(3)
 #undef define_conv_rec
 #undef define_conv_single
 #undef define_conv_sqr
+#undef define_ntt_dif_long
+#undef define_ntt_idit_long
 #undef INLINE
 
 #endif  /* __LAMMP_3NTT_CRT_KERNAL_H__ */
\ No newline at end of file
@@ -0,0 +1,67 @@
+/*
+ * Copyright (C) 2025 HJimmyK/LAMINA
+ *
+ * This file is part of LAMMP, which is licensed under the GNU LGPL v2.1.
+ * See the LICENSE file in the project root for full license details, or visit:
+ * <https://www.gnu.org/licenses/old-licenses/lgpl-2.1.html>
+ */
+
+#ifndef __LAMMP_BINSPLIT_HPP__
+#define __LAMMP_BINSPLIT_HPP__
+
+#include <functional>
+
+#include "inter_buffer.hpp"
+#include "lammp.hpp"
+
+namespace lammp::Arithmetic {
+
+// 单项系数的最大字长
+constexpr lamp_ui BINSPLIT_TERM_LEN = 4;
+
+/*
+ * 级数项的系数：k 处的值写入 out（至多 BINSPLIT_TERM_LEN 个字），返回长度，值为负时将 neg 置为 true
+ * 会被多个线程同时调用
+ */
+using BinSplitTerm = std::function<lamp_ui(lamp_ui k, lamp_ptr out, bool& neg)>;
+
+/*
+ * 超几何型级数 S = sum_{k=0}^{n-1} a(k) / b(k) * prod_{j=0}^{k} p(j) / q(j)
+ * b 为空时视为 1；通常取 p(0) = q(0) = 1
+ */
+struct BinSplitSeries {
+    BinSplitTerm p;
+    BinSplitTerm q;
+    BinSplitTerm a;
+    BinSplitTerm b;
+};
+
+// 有符号大整数，二分结果 P、Q、B、T 的存储
+struct BinSplitNum {
+    _internal_buffer<0> buf;
+    lamp_ui len = 0;
+    bool neg = false;
+};
+
+/*
+ * @brief 二分求和：P = prod p(k)，Q = prod q(k)，B = prod b(k)，T 满足 S = T / (B * Q)
+ * @param P 可以为 nullptr，此时最右侧路径上不计算 P，每层省去一次乘法
+ * @param B 可以为 nullptr；series.b 为空时 B = 1
+ * @note 按各项系数的位长前缀和选择分点，使两侧规模相近；子树与合并时的乘法交给全局线程池
+ */
+void binary_split(const BinSplitSeries& series,
+                  lamp_ui n,
+                  BinSplitNum* P,
+                  BinSplitNum& Q,
+                  BinSplitNum* B,
+                  BinSplitNum& T);
+
+/*
+ * @brief 计算 out = trunc(S * 2^frac_bits)，S 取前 n 项，最后做一次大除法
+ * @param out 输出，缓冲区由函数分配
+ */
+void binary_split_fixed(const BinSplitSeries& series, lamp_ui n, lamp_ui frac_bits, BinSplitNum& out);
+
+};  // namespace lammp::Arithmetic
+
+#endif  // __LAMMP_BINSPLIT_HPP__
@@ -11,6 +11,8 @@
 
 #include <cstdint>
 #include <cassert>
+#include <functional>
+#include <memory>
 #include "base_cal.hpp"
 namespace lammp {
 namespace Arithmetic {
@@ -71,11 +73,17 @@ void abs_mul64_karatsuba_buffered(lamp_ptr in1,
                                   lamp_ptr buffer_begin,
                                   lamp_ptr buffer_end);
 void abs_mul64_karatsuba(lamp_ptr in1, lamp_ui len1, lamp_ptr in2, lamp_ui len2, lamp_ptr out);
+void abs_sqr64_classic(lamp_ptr in, lamp_ui len, lamp_ptr out, lamp_ptr work_begin, lamp_ptr work_end);
+void abs_sqr64_karatsuba_buffered(lamp_ptr in, lamp_ui len, lamp_ptr out, lamp_ptr buffer_begin, lamp_ptr buffer_end);
+void abs_sqr64_karatsuba(lamp_ptr in, lamp_ui len, lamp_ptr out);
 void abs_sqr64_ntt(lamp_ptr in, lamp_ui len, lamp_ptr out);
 void abs_mul64_ntt(lamp_ptr in1, lamp_ui len1, lamp_ptr in2, lamp_ui len2, lamp_ptr out);
 void abs_mul64_ntt_unbalanced(lamp_ptr in1, lamp_ui len1, lamp_ptr in2, lamp_ui len2, lamp_ui M, lamp_ptr out);
 void abs_sqr64_ntt_base(lamp_ptr in, lamp_ui len, lamp_ptr out, const lamp_ui base_num);
 void abs_mul64_ntt_base(lamp_ptr in1, lamp_ui len1, lamp_ptr in2, lamp_ui len2, lamp_ptr out, const lamp_ui base_num);
+// in^2 mod (2^n - 1)（negacyclic 时为 2^n + 1），n = bits * ntt_len，in < 2^n，bits <= 64
+// 长为 ntt_len 的循环（负循环）卷积，不补零；out 至少 n / 64 + 3 个字，结果同余但不一定小于模数
+void abs_sqr64_ntt_wrap(lamp_ptr in, lamp_ui len, lamp_ui bits, lamp_ui ntt_len, bool negacyclic, lamp_ptr out);
 void abs_mul64_balanced(lamp_ptr in1,
                         lamp_ui len1,
                         lamp_ptr in2,
@@ -90,6 +98,7 @@ void abs_mul64(lamp_ptr in1,
                lamp_ptr out,
                lamp_ptr work_begin = nullptr,
                lamp_ptr work_end = nullptr);
+void abs_sqr64(lamp_ptr in, lamp_ui len, lamp_ptr out, lamp_ptr work_begin = nullptr, lamp_ptr work_end = nullptr);
 
 lamp_ui abs_div_rem_num64(lamp_ptr in, lamp_ui length, lamp_ptr out, lamp_ui divisor);
 
@@ -100,6 +109,16 @@ void abs_div_knuth(lamp_ptr in,
                    lamp_ptr out,
                    lamp_ptr remainder = nullptr);
 
+// 除数与商都不短于该字长时使用分治除法
+constexpr size_t DIV_RECURSIVE_THRESHOLD = 100;
+
+void abs_div_recursive(lamp_ptr in,
+                       lamp_ui len,
+                       lamp_ptr divisor,
+                       lamp_ui divisor_len,
+                       lamp_ptr out,
+                       lamp_ptr remainder = nullptr);
+
 lamp_ui barrett_2powN_recursive(lamp_ptr in, lamp_ui len, lamp_ptr out);
 
 lamp_ui barrett_2powN(lamp_ui N, lamp_ptr in, lamp_ui len, lamp_ptr out);
@@ -107,16 +126,154 @@ lamp_ui barrett_2powN(lamp_ui N, lamp_ptr in, lamp_ui len, lamp_ptr out);
 // in1 / in2
 void abs_div64(lamp_ptr in1, lamp_ui len1, lamp_ptr in2, lamp_ui len2, lamp_ptr qr);
 
+// in1 % in2
+lamp_ui abs_mod64(lamp_ptr in1, lamp_ui len1, lamp_ptr in2, lamp_ui len2, lamp_ptr rem);
+
+// in^-1 mod 2^(64 * len)
+void inv_mod_2pow64(lamp_ptr in, lamp_ui in_len, lamp_ptr out, lamp_ui len);
+
+// 不小于该字长时 GCD 使用半 GCD，否则使用 Lehmer 双字步
+constexpr size_t HGCD_THRESHOLD = 300;
+
+// gcd(in1, in2)
+lamp_ui abs_gcd64(lamp_ptr in1, lamp_ui len1, lamp_ptr in2, lamp_ui len2, lamp_ptr out);
+
+// g = gcd(in1, in2), s * in1 = g (mod in2)
+lamp_ui abs_gcdext64(lamp_ptr in1,
+                     lamp_ui len1,
+                     lamp_ptr in2,
+                     lamp_ui len2,
+                     lamp_ptr g,
+                     lamp_ptr s,
+                     lamp_ui& s_len,
+                     bool& s_neg);
+
+// in^-1 mod mod
+bool abs_inv_mod64(lamp_ptr in, lamp_ui len, lamp_ptr mod, lamp_ui mod_len, lamp_ptr out, lamp_ui& out_len);
+
+// root = floor(sqrt(in)), rem = in - root^2
+lamp_ui abs_sqrtrem64(lamp_ptr in, lamp_ui len, lamp_ptr root, lamp_ptr rem = nullptr);
+
+// in == x^2
+bool abs_is_square64(lamp_ptr in, lamp_ui len);
+
+// root = floor(in^(1/k)), rem = in - root^k
+lamp_ui abs_rootrem64(lamp_ptr in, lamp_ui len, lamp_ui k, lamp_ptr root, lamp_ptr rem = nullptr);
+
+// in == y^k, k >= 2
+bool abs_is_perfect_power64(lamp_ptr in, lamp_ui len, bool odd_only = false);
+
+// in is a BPSW probable prime
+bool abs_is_prime64(lamp_ptr in, lamp_ui len);
+
+// outs[i] = abs_is_prime64(ins[i], lens[i])
+void abs_is_prime64_batch(lamp_ptr* ins, const lamp_ui* lens, lamp_ui count, bool* outs);
+
+// n! 的字长上界
+lamp_ui get_factorial_len(lamp_ui n);
+
+// out = n!
+lamp_ui abs_factorial64(lamp_ui n, lamp_ptr out);
+
+// F(n) 的字长上界
+lamp_ui get_fib_len(lamp_ui n);
+
+// out = F(n), out_prev = F(n - 1)
+lamp_ui abs_fib64(lamp_ui n, lamp_ptr out, lamp_ptr out_prev = nullptr, lamp_ui* prev_len = nullptr);
+
+// out = L(n)
+lamp_ui abs_lucnum64(lamp_ui n, lamp_ptr out);
+
+// base^e 的字长上界
+lamp_ui get_pow_len(const lamp_ptr base, lamp_ui base_len, lamp_ui e);
+
+// out = base^e
+lamp_ui abs_pow64(const lamp_ptr base, lamp_ui base_len, lamp_ui e, lamp_ptr out);
+
+// base^exp mod mod
+lamp_ui abs_pow_mod64(lamp_ptr base,
+                      lamp_ui base_len,
+                      lamp_ptr exp,
+                      lamp_ui exp_len,
+                      lamp_ptr mod,
+                      lamp_ui mod_len,
+                      lamp_ptr out);
+
+// bases[i]^exps[i] mod mod, exp_count == 1 means all bases share exps[0]
+void abs_pow_mod64_batch(lamp_ptr* bases,
+                         const lamp_ui* base_lens,
+                         lamp_ui count,
+                         lamp_ptr* exps,
+                         const lamp_ui* exp_lens,
+                         lamp_ui exp_count,
+                         lamp_ptr mod,
+                         lamp_ui mod_len,
+                         lamp_ptr* outs,
+                         lamp_ui* out_lens = nullptr);
+
+// outs[i] = in mod mods[i]，乘积树 + 余数树
+void abs_mod_multi64(lamp_ptr in,
+                     lamp_ui len,
+                     lamp_ptr* mods,
+                     const lamp_ui* mod_lens,
+                     lamp_ui count,
+                     lamp_ptr* outs,
+                     lamp_ui* out_lens = nullptr);
+
+// in mod (2^p - 1)、in mod (2^p + 1)，按 p 位分块求和（交错求和），out 至少 p / 64 + 1 个字，返回长度
+lamp_ui abs_mod_mersenne64(lamp_ptr in, lamp_ui len, lamp_ui p, lamp_ptr out);
+lamp_ui abs_mod_fermat64(lamp_ptr in, lamp_ui len, lamp_ui p, lamp_ptr out);
+
+// 不小于该位数且 p = bits * 2^k（bits <= 64）时，模 2^p -+ 1 的平方使用回绕的循环（负循环）卷积
+constexpr lamp_ui SQR_MOD_WRAP_MIN_BITS = 64 * 1024;
+
+// in^2 mod (2^p - 1)、in^2 mod (2^p + 1)，out 至少 p / 64 + 1 个字，返回长度
+lamp_ui abs_sqr_mod_mersenne64(lamp_ptr in, lamp_ui len, lamp_ui p, lamp_ptr out);
+lamp_ui abs_sqr_mod_fermat64(lamp_ptr in, lamp_ui len, lamp_ui p, lamp_ptr out);
+
 namespace Numeral {
 
 inline lamp_ui get_buffer_size(lamp_ui len, double base_d);
 
 constexpr lamp_ui MIN_LEN = 64;
 
+// 2^64 进制与 base 进制互相转换，返回 res 的长度；in 不会被修改，只有叶子在小块副本上计算
 lamp_ui binary2base(lamp_ptr in, lamp_ui len, const lamp_ui base, lamp_ptr res);
 
 lamp_ui base2binary(lamp_ptr in, lamp_ui len, const lamp_ui base, lamp_ptr res);
 
+// 同 binary2base，用缩放余数树计算：只求一次 base_num^N 的倒数，各层只做截断的二进制乘法，不做除法
+lamp_ui binary2base_srt(lamp_ptr in, lamp_ui len, const lamp_ui base, lamp_ptr res);
+
+// 进制转换所用的基数幂在进程内缓存，按进制增长，多线程共享；缓存总字数的默认上限（128 MiB）
+constexpr lamp_ui POW_CACHE_DEFAULT_WORDS = lamp_ui(1) << 24;
+
+// 设置缓存上限（字数），已用量超过新上限时清空缓存
+void set_pow_cache_limit(lamp_ui words);
+
+// 清空缓存，不影响正在进行的转换
+void clear_pow_cache();
+
+// 缓存当前占用的字数，包括 binary2base_srt 所用的倒数
+lamp_ui pow_cache_words();
+
+// base2binary 所用的基数幂：base_num^index 的二进制表示（base_num 为 base 对应的每字基数，index = MIN_LEN * 2^k），
+// 取自上述缓存；owner 持有该层，data 在 owner 存活期间有效且不会被修改
+struct BasePower {
+    std::shared_ptr<const void> owner;
+    const lamp_ui* data;
+    lamp_ui len;
+};
+BasePower get_base_power(lamp_ui base, lamp_ui index);
+
+// 按高位在前的顺序输出 in 在 base 进制下的字符（小写，无符号，不含前导零），每完成一个叶子调用一次 sink，
+// sink 返回 false 时中止并返回 false；in 不会被修改，峰值内存约为数本身加上幂次表（numeral_stream.cpp）
+bool binary2str(lamp_ptr in, lamp_ui len, lamp_ui base, const std::function<bool(const char*, lamp_ui)>& sink);
+
+// 把一个 base_num 位 val 写成 len 个 base 进制字符（小写，不足补零），msb_first 时高位在前，否则低位在前；
+// 十进制按 10^8、10^4 拆分后查两位数字表，不逐位做除法（numeral_digits.cpp）
+void base_num2str(lamp_ui val, lamp_ui base, lamp_ui len, char* out, bool msb_first);
+
 };  // namespace Numeral
 };  // namespace Arithmetic
 };  // namespace lammp
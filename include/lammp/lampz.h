@@ -117,7 +117,7 @@ static inline lamp_ptr __lampz_get_ptr(const lampz_t z) { return (z != nullptr &
  * @return 字长（count of lamp_ui），失败返回 0
  */
 static inline lamp_sz __lampz_get_capacity(const lampz_t z) {
-    return z != nullptr ? (lamp_sz)(z->end - z->begin + 1) : 0;
+    return (z != nullptr && z->begin != nullptr) ? (lamp_sz)(z->end - z->begin + 1) : 0;
 }
 
 /**
@@ -301,6 +301,21 @@ static inline lamp_sz __lampz_talloc(lampz_t z, lamp_sz word_len, lamp_sz talloc
     
 }
 
+/**
+ * @brief 保证大整数至少拥有 word_len 个字的容量（不保留原有数据）
+ * @param z 大整数对象
+ * @param word_len 所需字长
+ * @return 成功返回 1，失败返回 0（内存分配失败，z 保持不变）
+ * @note 容量以 end - begin 计算；容量不足时重新分配，z->len 置为 0
+ * @warning 不建议外部使用，除非你知道自己在做什么
+ */
+static inline lamp_sz __lampz_reserve(lampz_t z, lamp_sz word_len) {
+    if (z->begin != nullptr && (lamp_sz)(z->end - z->begin) >= word_len) {
+        return 1;
+    }
+    return __lampz_malloc(z, word_len);
+}
+
 /**
  * @brief 释放对象
  * @param z 大整数对象（可以是 NULL，内部安全处理）
@@ -315,6 +330,25 @@ static inline void lampz_free(lampz_t z) {
     }
 }
 
+/**
+ * @brief 将绝对值 res（res_len 个字，不含前导零）与符号写入 z，零总是非负
+ * @note 内存分配失败时 z 被置为 nan
+ * @warning 不建议外部使用，除非你知道自己在做什么
+ */
+static inline void __lampz_store_abs(lampz_t z, const lamp_ui* res, lamp_sz res_len, bool neg) {
+    if (!__lampz_reserve(z, res_len > 0 ? res_len : 1)) {
+        lampz_free(z);
+        return;
+    }
+    if (res_len == 0) {
+        z->begin[0] = 0;
+        z->len = 1;
+        return;
+    }
+    memmove(z->begin, res, res_len * sizeof(lamp_ui));
+    z->len = neg ? -(lamp_si)res_len : (lamp_si)res_len;
+}
+
 // -----------------------------------------------------------------------------
 // 大整数运算函数声明
 // -----------------------------------------------------------------------------
@@ -460,10 +494,44 @@ lamp_sz lampz_to_str_len(const lampz_t z, lamp_sz base);
  * @param base 进制 2-36
  * @return 实际写入的字符串长度
  * @note 字符串将会以小端序存储，且为绝对值，即改变 z 的符号将不影响输出结果
+ * @note 不复制 z，除 str 外只分配 base_num 进制的中间结果
  * @warning 若 str 未分配足够内存，将导致溢出。
  */
 lamp_sz lampz_to_str(char* str, const lamp_sz str_len, const lampz_t z, lamp_sz base);
 
+/**
+ * @brief 将大整数 z 以 base 进制写入文件描述符 fd
+ * @param fd 已打开的可写文件描述符
+ * @param z 目标大整数
+ * @param base 进制 2-36
+ * @return 实际写入的字节数，出错、z 为 NaN 或进制非法时返回 0
+ * @note 与 lampz_to_str 不同，输出为高位在前（可直接阅读），负数带 '-'，不写入 '\0'
+ * @note 自顶向下按基数幂分治，每完成一段即写出，不复制 z 也不生成完整字符串；
+ *       输出经 1 MiB 缓冲后整块 write，峰值内存约为 z 本身加上幂次表
+ */
+lamp_sz lampz_out_str_fd(int fd, const lampz_t z, lamp_sz base);
+
+/**
+ * @brief 从文件描述符 fd 按块读取 base 进制字符串（高位在前，与 lampz_out_str_fd 的输出相同）赋值给 z
+ * @param z 目标大整数
+ * @param fd 已打开的可读文件描述符，读到文件末尾为止
+ * @param base 进制 2-36，字母不区分大小写
+ * @param peak_block_bytes 若不为 nullptr，写入读取期间同时持有的缓冲区的最大字节数：读取缓冲、叶子、
+ *        合并栈与折叠中的块，以及所用的基数幂（包括取自幂次缓存的）；不含 base2binary 与乘法内部的临时缓冲和 z 的内存
+ * @return 读取的字节数；输入非法、没有数字或读取出错时 z 被置为 nan，返回 0
+ * @note 允许前后空白与一个前导 '-'，其余字符必须都是数字
+ * @note 每满一个叶子（MIN_LEN 个 base_num 位）即转换为二进制并与已有的块合并，
+ *       不保存整个字符串，也不生成 base_num 进制的完整副本，峰值内存约为结果本身加上幂次表
+ */
+lamp_sz lampz_inp_str_fd(lampz_t z, int fd, lamp_sz base, lamp_sz* peak_block_bytes);
+
+/**
+ * @brief 同 lampz_inp_str_fd，文件通过 mmap 映射后按块解析，已解析的页面随即释放
+ * @param path 文件路径
+ * @note Windows 下没有 mmap，退化为 lampz_inp_str_fd；peak_block_bytes 不含映射的页面
+ */
+lamp_sz lampz_set_str_mmap(lampz_t z, const char* path, lamp_sz base, lamp_sz* peak_block_bytes);
+
 /**
  * @brief 大整数 z 转整数
  * @param z 目标大整数
@@ -501,18 +569,260 @@ void lampz_move(lampz_t z1, lampz_t z2);
  */
 void lampz_swap(lampz_t z1, lampz_t z2);
 
-/*
+/**
+ * @brief 模幂：z = base^exp mod mod（z 的容量如果不够，会自动分配新内存）
+ * @note 结果取值范围为 [0, |mod|)；base 为负数时按数学意义取模，结果仍为非负
+ * @note 奇数模数使用多字蒙哥马利乘法，偶数模数拆分为 奇数 * 2^s 后由中国剩余定理合并
+ * @note exp 为负数、mod 为零或任一参数为 nan 时，z 被置为 nan
+ */
+void lampz_pow_mod(lampz_t z, const lampz_t base, const lampz_t exp, const lampz_t mod);
+
+/**
+ * @brief 批量模幂：z[i] = base[i]^exp[i] mod mod（共享模数，z[i] 的容量如果不够，会自动分配新内存）
+ * @param z 结果数组，长度为 count
+ * @param base 底数数组，长度为 count
+ * @param count 底数个数
+ * @param exp 指数数组，长度为 exp_count
+ * @param exp_count 为 1 时所有底数共用 exp[0]，否则必须等于 count
+ * @param mod 共享模数
+ * @note 模数相关的预计算只做一次，共享指数时窗口计划也只构造一次；底数分配到全局线程池并行计算
+ * @note 单个参数无效时（nan 或负指数）只将对应的 z[i] 置为 nan；mod 无效时全部置为 nan
+ * @note z[i] 可以与 base、exp 中的任一元素或 mod 是同一对象：全部结果算完之后才写入 z
+ */
+void lampz_pow_mod_batch(lampz_t z[],
+                         const lampz_t base[],
+                         lamp_sz count,
+                         const lampz_t exp[],
+                         lamp_sz exp_count,
+                         const lampz_t mod);
+
+/**
+ * @brief 一个数对多个模数取模：z[i] = x mod m[i]（z[i] 的容量如果不够，会自动分配新内存）
+ * @param z 结果数组，长度为 count
+ * @param m 模数数组，长度为 count
+ * @note 结果取值范围为 [0, |m[i]|)；x 为负数时按数学意义取模，结果仍为非负
+ * @note 先建模数的乘积树，再自顶向下求余（余数树），x 只需对树根做一次大除法，越往下被除数越短；
+ *       同一层的结点分配到全局线程池并行计算
+ * @note m[i] 为零或 nan 时只将 z[i] 置为 nan；x 为 nan 时全部置为 nan
+ * @warning z[i] 不可与 x 或 m 中的任一元素指向同一对象
+ */
+void lampz_mod_multi(lampz_t z[], const lampz_t x, const lampz_t m[], lamp_sz count);
+
+/**
+ * @brief 中国剩余定理重建：求 0 <= z < M（M = prod |m[i]|），使 z = r[i] (mod m[i])（z 的容量如果不够，会自动分配新内存）
+ * @param r 余数数组，长度为 count，可以为负数或不小于 |m[i]|
+ * @param m 模数数组，长度为 count，必须两两互素
+ * @note s_i = (M / m_i)^-1 mod m_i 由乘积树上的余数树一次求出，z = sum (r_i * s_i mod m_i) * (M / m_i)
+ *       在乘积树上自底向上合并，总代价约为 O(M(n) log count)；模数全为单字时叶子上只做单字乘除
+ * @note 模数为零、不两两互素或任一参数为 nan 时，z 被置为 nan
+ */
+void lampz_crt(lampz_t z, const lampz_t r[], const lampz_t m[], lamp_sz count);
+
+/**
+ * @brief 共享模数的批量中国剩余定理重建：z[j] 由 r[j * count, (j + 1) * count) 重建
+ * @param z 结果数组，长度为 batch
+ * @param r 余数数组，长度为 batch * count，按行存放
+ * @param m 模数数组，长度为 count，必须两两互素
+ * @note 乘积树与 s_i 只构造一次，在 batch 次重建之间复用
+ * @note 单组余数中有 nan 时只将对应的 z[j] 置为 nan；模数无效时全部置为 nan
+ * @warning z[j] 不可与 r、m 中的任一元素指向同一对象
+ */
+void lampz_crt_batch(lampz_t z[], const lampz_t r[], lamp_sz batch, const lampz_t m[], lamp_sz count);
+
+/**
+ * @brief 模 2^p - 1 的平方：z = x^2 mod (2^p - 1)（z 的容量如果不够，会自动分配新内存）
+ * @note 结果取值范围为 [0, 2^p - 1)；x 可以为负数或不小于模数，先按 p 位分块求和归约
+ * @note p 为 2 的幂与不超过 64 的数之积且足够大时，长为 p / bits 的循环卷积直接得到回绕后的结果，不必补零；
+ *       其他 p（如 Lucas-Lehmer 测试中的素数指数）完整平方后按 p 位分块求和，两种情况都不做除法
+ * @note x 为 nan 或 p = 0 时，z 被置为 nan
+ */
+void lampz_sqr_mod_mersenne(lampz_t z, const lampz_t x, lamp_ui p);
+
+/**
+ * @brief 模 2^p + 1 的平方：z = x^2 mod (2^p + 1)（z 的容量如果不够，会自动分配新内存）
+ * @note 结果取值范围为 [0, 2^p + 1)；p 为 2 的幂与不超过 64 的数之积且足够大时（如 Pépin 测试中的费马数 2^(2^m) + 1）
+ *       使用负循环（加权）卷积，其他 p 完整平方后按 p 位交错求和
+ * @note x 为 nan 或 p = 0 时，z 被置为 nan
+ */
+void lampz_sqr_mod_fermat(lampz_t z, const lampz_t x, lamp_ui p);
+
+/**
+ * @brief 最大公约数：z = gcd(a, b)（z 的容量如果不够，会自动分配新内存）
+ * @note 结果总为非负；a、b 均为零时结果为零
+ * @note 小规模使用 Lehmer 双字步，不小于 HGCD_THRESHOLD 个字时使用半 GCD
+ * @note 任一参数为 nan 时，z 被置为 nan
+ */
+void lampz_gcd(lampz_t z, const lampz_t a, const lampz_t b);
+
+/**
+ * @brief 最小公倍数：z = lcm(a, b)（z 的容量如果不够，会自动分配新内存）
+ * @note 结果总为非负；任一参数为零时结果为零
+ * @note 任一参数为 nan 时，z 被置为 nan
+ */
+void lampz_lcm(lampz_t z, const lampz_t a, const lampz_t b);
+
+/**
+ * @brief 扩展欧几里得：g = gcd(a, b)，且 a * s + b * t = g
+ * @param s 可以为 NULL，此时不输出
+ * @param t 可以为 NULL，此时不输出（t 由一次整除得到，不需要时传 NULL 可省去该开销）
+ * @note b 为零时 s = sign(a)，t = 0；a 为零时 s = 0，t = sign(b)；否则 |s| <= |b| / g
+ * @note 任一参数为 nan 时，g、s、t 均被置为 nan
+ * @warning g、s、t 不可指向同一对象
+ */
+void lampz_gcdext(lampz_t g, lampz_t s, lampz_t t, const lampz_t a, const lampz_t b);
+
+/**
+ * @brief 模逆元：z = a^-1 mod |mod|（z 的容量如果不够，会自动分配新内存）
+ * @note 结果取值范围为 [0, |mod|)，由扩展欧几里得得到
+ * @note 逆元不存在（gcd(a, mod) != 1）、mod 为零或任一参数为 nan 时，z 被置为 nan
+ */
+void lampz_inv_mod(lampz_t z, const lampz_t a, const lampz_t mod);
+
+/**
+ * @brief 平方根与余数：s = floor(sqrt(x))，r = x - s^2（s、r 的容量如果不够，会自动分配新内存）
+ * @param r 可以为 NULL，此时不输出余数
+ * @note 使用 Karatsuba 平方根（Zimmermann），大规模时代价约为一次同规模的除法加一次半规模平方
+ * @note x 为负数或 nan 时，s、r 均被置为 nan
+ * @warning s、r 不可指向同一对象
+ */
+void lampz_sqrtrem(lampz_t s, lampz_t r, const lampz_t x);
+
+/**
+ * @brief 平方根：z = floor(sqrt(x))（z 的容量如果不够，会自动分配新内存）
+ * @note x 为负数或 nan 时，z 被置为 nan
+ */
+void lampz_sqrt(lampz_t z, const lampz_t x);
+
+/**
+ * @brief 判断 x 是否为完全平方数
+ * @note 先用模 256、63、65、17、97 的二次剩余表排除，绝大多数非平方数无需开方
+ * @note x 为负数或 nan 时返回 false
+ */
+bool lampz_is_square(const lampz_t x);
+
+/**
+ * @brief k 次方根与余数：z = trunc(x^(1/k))，r = x - z^k（z、r 的容量如果不够，会自动分配新内存）
+ * @param r 可以为 NULL，此时不输出余数
+ * @note 牛顿迭代，初值由精度倍增得到（先对高半部分求根），大部分迭代在较短的数上完成
+ * @note x 为负数时 k 必须为奇数，此时 z = -root(|x|)，r 与 x 同号
+ * @note k 为零、x 为负数且 k 为偶数或 x 为 nan 时，z、r 均被置为 nan
+ * @warning z、r 不可指向同一对象
+ */
+void lampz_rootrem(lampz_t z, lampz_t r, const lampz_t x, lamp_ui k);
+
+/**
+ * @brief k 次方根：z = trunc(x^(1/k))（z 的容量如果不够，会自动分配新内存）
+ * @note 参数限制同 lampz_rootrem
+ */
+void lampz_root(lampz_t z, const lampz_t x, lamp_ui k);
+
+/**
+ * @brief 判断 x 是否为完全幂，即存在整数 y 与 k >= 2 使 x = y^k（0、1、-1 视为完全幂）
+ * @note 只检查素数 k，并先用 2 的幂次、浮点对数与模 q 的 k 次剩余筛排除，绝大多数 k 无需开方
+ * @note x 为负数时只考虑奇数 k；x 为 nan 时返回 false
+ */
+bool lampz_perfect_power_p(const lampz_t x);
+
+/**
+ * @brief 素性测试：判断 n 是否为素数（Baillie-PSW 概率素性测试）
+ * @note 依次做试除（小素数乘积逐个对 n 取余）、以 2 为底的强伪素数测试和强 Lucas 测试，
+ *       绝大多数合数在试除或第一次模幂后即被排除
+ * @note 目前没有已知的 BPSW 伪素数；n 小于 2^64 时结果是确定的
+ * @note n 小于 2（包括负数）或为 nan 时返回 false
+ */
 bool lampz_is_prime(const lampz_t n);
-void lampz_factorial(lampz_t& result, const lampz_t n);
-void lampz_fibonacci(lampz_t& result, const lampz_t n);
-void lampz_gcd(lampz_t& result, const lampz_t a, const lampz_t b);
-void lampz_lcm(lampz_t& result, const lampz_t a, const lampz_t b);
-void lampz_pow(lampz_t& result, const lampz_t base, const lampz_t exponent);
-void lampz_sqrt(lampz_t& result, const lampz_t x);
-void lampz_find_root(lampz_t& result, const lampz_t x, const lampz_t n);
-void lampz_pow_mod(lampz_t& result, const lampz_t base, const lampz_t exponent,
-const lampz_t modulus);
-*/
+
+/**
+ * @brief 批量素性测试：res[i] = lampz_is_prime(n[i])
+ * @param res 结果数组，长度为 count
+ * @param n 待测数组，长度为 count
+ * @note 所有候选先并行试除，只有剩下的候选才分配到全局线程池做 BPSW 测试
+ */
+void lampz_is_prime_batch(bool res[], const lampz_t n[], lamp_sz count);
+
+/**
+ * @brief 阶乘：z = n!（z 的容量如果不够，会自动分配新内存）
+ * @note 素数摆动算法：n! = 2^(n - popcount(n)) * oddfact(n)，oddfact(n) = oddfact(n / 2)^2 * oddswing(n)，
+ *       oddswing(n) 的素数幂因子由平衡乘积树相乘，互不依赖的子任务并行计算
+ */
+void lampz_factorial(lampz_t z, lamp_ui n);
+
+/**
+ * @brief Fibonacci 数：z = F(n)（z 的容量如果不够，会自动分配新内存）
+ * @note 倍增法，每一步只做两次平方，不做一般乘法；大规模时平方走 NTT，两次平方并行计算
+ */
+void lampz_fib(lampz_t z, lamp_ui n);
+
+/**
+ * @brief 相邻两个 Fibonacci 数：z = F(n)，z_prev = F(n - 1)（约定 F(-1) = 1）
+ * @note 与 lampz_fib 代价相同，便于继续递推
+ * @warning z、z_prev 不可指向同一对象
+ */
+void lampz_fib2(lampz_t z, lampz_t z_prev, lamp_ui n);
+
+/**
+ * @brief Lucas 数：z = L(n) = F(n) + 2F(n - 1)（z 的容量如果不够，会自动分配新内存）
+ */
+void lampz_lucnum(lampz_t z, lamp_ui n);
+
+/**
+ * @brief 整数幂：z = base^exp（z 的容量如果不够，会自动分配新内存）
+ * @note 约定 0^0 = 1；base 为负数且 exp 为奇数时结果为负
+ * @note base = odd * 2^t 中的 2^(t * exp) 由移位完成，2 的幂底数不做乘法；单字底数按窗口预计算能放进一个字的
+ *       base^j，多字底数使用滑动窗口；结果长度预先估计，整个计算只分配一次内存
+ * @note base 为 nan 时，z 被置为 nan
+ */
+void lampz_pow(lampz_t z, const lampz_t base, lamp_ui exp);
+
+/**
+ * @brief 2x2 矩阵乘法：c = a * b，矩阵按行存放 [m00, m01, m10, m11]（容量如果不够，会自动分配新内存）
+ * @note a、b 为同一数组时按平方计算，只需 5 次乘法；元素较短时用 Strassen-Winograd 形式（7 次乘法）；
+ *       元素足够长时每个元素只做一次正变换，8 个点乘在变换域中两两求和，4 个输出各做一次逆变换
+ * @note c 可以与 a、b 为同一数组；a、b 中有 nan 时，c 的元素均被置为 nan
+ */
+void lampz_mat22_mul(lampz_t c[], const lampz_t a[], const lampz_t b[]);
+
+/**
+ * @brief 2x2 矩阵幂：c = a^exp，exp = 0 时为单位阵（容量如果不够，会自动分配新内存）
+ * @note 二进制快速幂，线性递推 x(n + 2) = p x(n + 1) + q x(n) 可由 [p q; 1 0]^n 直接求出
+ * @note c 可以与 a 为同一数组；a 中有 nan 时，c 的元素均被置为 nan
+ */
+void lampz_mat22_pow(lampz_t c[], const lampz_t a[], lamp_ui exp);
+
+/**
+ * @brief 级数项系数的回调：k 处的值写入 out（至多 4 个字），返回长度，值为负时将 *neg 置为 true
+ * @note 会被多个线程同时调用，ctx 为 lampz_series_t 中的用户数据
+ */
+typedef lamp_sz (*lampz_series_term)(void* ctx, lamp_ui k, lamp_ui* out, bool* neg);
+
+/**
+ * @brief 超几何型级数 S = sum_{k=0}^{n-1} a(k) / b(k) * prod_{j=0}^{k} p(j) / q(j)
+ * @note b 可以为 NULL，此时视为 1；通常取 p(0) = q(0) = 1
+ */
+typedef struct {
+    lampz_series_term p;
+    lampz_series_term q;
+    lampz_series_term a;
+    lampz_series_term b;
+    void* ctx;
+} lampz_series_t;
+
+/**
+ * @brief 二分求和：P = prod p(k)，Q = prod q(k)，B = prod b(k)，T 满足 S = T / (B * Q)（容量如果不够，会自动分配新内存）
+ * @param P 可以为 NULL，此时最右侧路径上不计算 P，每层省去一次乘法
+ * @param B 可以为 NULL；series->b 为 NULL 时 B = 1
+ * @note 分点按各项系数位长的前缀和选取，使两侧乘法规模相近；大的子树与合并时互不依赖的乘法交给全局线程池
+ * @note series 为 NULL 或 p、q、a 中有 NULL 时，输出均被置为 nan
+ * @warning P、Q、B、T 不可指向同一对象
+ */
+void lampz_series_split(lampz_t P, lampz_t Q, lampz_t B, lampz_t T, const lampz_series_t* series, lamp_ui n);
+
+/**
+ * @brief 级数的定点值：z = trunc(S * 2^frac_bits)，S 取前 n 项（z 的容量如果不够，会自动分配新内存）
+ * @note 二分求和后只做一次大除法；q(k)、b(k) 不可为零
+ * @note series 为 NULL 或 p、q、a 中有 NULL 时，z 被置为 nan
+ */
+void lampz_series_fixed(lampz_t z, const lampz_series_t* series, lamp_ui n, lamp_ui frac_bits);
 
 #ifdef __cplusplus
 }
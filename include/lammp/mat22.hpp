@@ -0,0 +1,62 @@
+/*
+ * Copyright (C) 2025 HJimmyK/LAMINA
+ *
+ * This file is part of LAMMP, which is licensed under the GNU LGPL v2.1.
+ * See the LICENSE file in the project root for full license details, or visit:
+ * <https://www.gnu.org/licenses/old-licenses/lgpl-2.1.html>
+ */
+
+#ifndef __LAMMP_MAT22_HPP__
+#define __LAMMP_MAT22_HPP__
+
+#include <algorithm>
+
+#include "inter_buffer.hpp"
+#include "lammp.hpp"
+
+namespace lammp::Arithmetic {
+
+/*
+ * 2x2 大整数矩阵，按行存放 [m00, m01, m10, m11]
+ * ptr[i] 指向 len[i] 个字的绝对值（可以含前导零），neg[i] 为符号，只保存指针，不复制
+ */
+struct Mat22 {
+    lamp_ptr ptr[4];
+    lamp_ui len[4];
+    bool neg[4];
+};
+
+// c = a * b 时 c 的每个元素所需的缓冲区长度
+inline lamp_ui get_mat22_mul_len(const Mat22& a, const Mat22& b) {
+    const lamp_ui len_a = *std::max_element(a.len, a.len + 4);
+    const lamp_ui len_b = *std::max_element(b.len, b.len + 4);
+    return len_a + len_b + 1;
+}
+
+/*
+ * @brief c = a * b
+ * @param c c.ptr[i] 须预先分配 get_mat22_mul_len(a, b) 个字，且不可与 a、b 重叠；返回时 c.len 不含前导零，零为非负
+ * @note &a == &b 时按平方计算：A^2 = [a^2 + bc, b(a + d); c(a + d), d^2 + bc]，只需 5 次乘法
+ * @note 元素较短时用 Strassen-Winograd 形式，7 次乘法 15 次加减，互不依赖的乘法并行计算；
+ *       元素足够长时改用 mat22_mul_ntt
+ */
+void mat22_mul(const Mat22& a, const Mat22& b, Mat22& c);
+
+/*
+ * @brief c = a * b，变换域中计算（3ntt_crt.cpp）
+ * @note 每个元素只做一次正变换（平方时共 4 次，否则 8 次），点值乘积在变换域中求和后，每个输出只做一次逆变换；
+ *       点乘本身很便宜，因此变换域中直接做 8 次点乘，不用 7 次乘法的形式
+ * @note 参数要求同 mat22_mul
+ */
+void mat22_mul_ntt(const Mat22& a, const Mat22& b, Mat22& c);
+
+/*
+ * @brief c = a^exp，exp = 0 时为单位阵
+ * @param buf c 的存储，由函数分配，c.ptr 指向其中
+ * @note 二进制快速幂，平方与乘法都走 mat22_mul
+ */
+void mat22_pow(const Mat22& a, lamp_ui exp, _internal_buffer<0>& buf, Mat22& c);
+
+};  // namespace lammp::Arithmetic
+
+#endif  // __LAMMP_MAT22_HPP__
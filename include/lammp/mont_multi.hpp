@@ -0,0 +1,144 @@
+/*
+ * Copyright (C) 2025 HJimmyK/LAMINA
+ *
+ * This file is part of LAMMP, which is licensed under the GNU LGPL v2.1.
+ * See the LICENSE file in the project root for full license details, or visit:
+ * <https://www.gnu.org/licenses/old-licenses/lgpl-2.1.html>
+ */
+
+#ifndef __LAMMP_MONT_MULTI_HPP__
+#define __LAMMP_MONT_MULTI_HPP__
+
+#include "inter_buffer.hpp"
+#include "lammp.hpp"
+
+namespace lammp::Arithmetic {
+
+// 不超过该字长时使用逐字 REDC，否则使用乘法 REDC（由 abs_mul64 选择 Karatsuba 或 NTT）
+constexpr lamp_ui MONT_REDC_CLASSIC_THRESHOLD = 32;
+
+/*
+ * ============================================================
+ * 运行期多字蒙哥马利域，R = 2^(64 * size())
+ * 模数必须为奇数，域内元素固定为 size() 个字，取值范围 [0, mod)
+ * 所有运算均为 const，临时空间 work 由调用者提供（至少 workSize() 个字），
+ * 因此同一个上下文可以被多个线程同时使用
+ * ============================================================
+ */
+class MontMultiCtx {
+   private:
+    lamp_ui len_;
+    lamp_ui mod_inv_neg64_;  // -mod^-1 mod 2^64
+    _internal_buffer<0> storage_;
+    lamp_ptr mod_;          // 模数
+    lamp_ptr mod_inv_neg_;  // -mod^-1 mod R
+    lamp_ptr r_square_;     // R^2 mod mod
+    lamp_ptr one_;          // R mod mod，即 1 的蒙哥马利形式
+
+    void redcClassic(lamp_ptr in_out) const;
+    void redcMul(lamp_ptr in_out, lamp_ptr work) const;
+    void finalSub(lamp_ptr in, lamp_ptr out) const;
+
+   public:
+    MontMultiCtx(lamp_ptr mod, lamp_ui len);
+
+    // 禁用拷贝
+    MontMultiCtx(const MontMultiCtx&) = delete;
+    MontMultiCtx& operator=(const MontMultiCtx&) = delete;
+
+    lamp_ui size() const { return len_; }
+    lamp_ui workSize() const { return 6 * len_ + 2; }
+    lamp_ptr mod() const { return mod_; }
+    void one(lamp_ptr out) const { std::copy(one_, one_ + len_, out); }
+
+    // out = in / R mod mod，in 为 2 * size() + 1 个字（最高字为 0），且 in < mod * R，in 会被修改
+    void redc(lamp_ptr in, lamp_ptr out, lamp_ptr work) const;
+    // out = a * b / R mod mod，out 可以与 a 或 b 相同
+    void mul(lamp_ptr a, lamp_ptr b, lamp_ptr out, lamp_ptr work) const;
+    // out = a * a / R mod mod，out 可以与 a 相同
+    void sqr(lamp_ptr a, lamp_ptr out, lamp_ptr work) const;
+    // out = in * R mod mod，in 可以为任意长度
+    void toMont(lamp_ptr in, lamp_ui in_len, lamp_ptr out, lamp_ptr work) const;
+    // out = in / R mod mod
+    void toInt(lamp_ptr in, lamp_ptr out, lamp_ptr work) const;
+};  // class MontMultiCtx
+
+/*
+ * ============================================================
+ * 滑动窗口指数计划：从高位到低位将指数划分为若干窗口，
+ * 首个窗口给出初值 base^first()，此后每一步先平方 sqrCount(i) 次，
+ * 再乘以底数的奇数次幂 base^digit(i)（digit 为 0 时不乘）
+ * 计划只与指数有关，指数相同时可在多个底数之间复用
+ * ============================================================
+ */
+class PowWindowPlan {
+   private:
+    lamp_ui window_;
+    lamp_ui first_;
+    lamp_ui step_count_;
+    _internal_buffer<0> steps_;  // 高 32 位为平方次数，低 32 位为窗口值
+
+   public:
+    // exp 不可为零，window 为 0 时按指数位长自动选择窗口大小
+    PowWindowPlan(lamp_ptr exp, lamp_ui len, lamp_ui window = 0);
+
+    lamp_ui window() const { return window_; }
+    lamp_ui first() const { return first_; }
+    lamp_ui stepCount() const { return step_count_; }
+    lamp_ui sqrCount(lamp_ui i) const { return steps_[i] >> 32; }
+    lamp_ui digit(lamp_ui i) const { return steps_[i] & 0xffffffffull; }
+    // 预计算表的元素个数：base^1, base^3, ..., base^(2^window - 1)
+    lamp_ui tableSize() const { return 1ull << (window_ - 1); }
+
+    static lamp_ui windowSize(lamp_ui bits);
+};  // class PowWindowPlan
+
+/*
+ * @brief 按滑动窗口计划计算 out = base^exp
+ * @param ring 运算环，需提供 size()、workSize()、mul(a, b, out, work) 与 sqr(a, out, work)
+ * @param base 底数（环内元素，size() 个字）
+ * @param table 预计算表，至少 plan.tableSize() * size() 个字
+ * @param out 结果（环内元素，size() 个字），不可与 base 相同
+ * @param work 临时空间，至少 workSize() 个字
+ */
+template <typename Ring>
+void pow_window_table(const Ring& ring, const PowWindowPlan& plan, lamp_ptr base, lamp_ptr table, lamp_ptr out,
+                      lamp_ptr work) {
+    const lamp_ui n = ring.size();
+    const lamp_ui table_size = plan.tableSize();
+    std::copy(base, base + n, table);
+    if (table_size > 1) {
+        // out 暂存 base^2
+        ring.sqr(base, out, work);
+        for (lamp_ui i = 1; i < table_size; i++) {
+            ring.mul(table + (i - 1) * n, out, table + i * n, work);
+        }
+    }
+}
+
+template <typename Ring>
+void pow_window_run(const Ring& ring, const PowWindowPlan& plan, lamp_ptr table, lamp_ptr out, lamp_ptr work) {
+    const lamp_ui n = ring.size();
+    lamp_ptr first = table + (plan.first() >> 1) * n;
+    std::copy(first, first + n, out);
+    for (lamp_ui i = 0; i < plan.stepCount(); i++) {
+        for (lamp_ui j = plan.sqrCount(i); j > 0; j--) {
+            ring.sqr(out, out, work);
+        }
+        const lamp_ui digit = plan.digit(i);
+        if (digit != 0) {
+            ring.mul(out, table + (digit >> 1) * n, out, work);
+        }
+    }
+}
+
+template <typename Ring>
+void pow_window_exec(const Ring& ring, const PowWindowPlan& plan, lamp_ptr base, lamp_ptr table, lamp_ptr out,
+                     lamp_ptr work) {
+    pow_window_table(ring, plan, base, table, out, work);
+    pow_window_run(ring, plan, table, out, work);
+}
+
+};  // namespace lammp::Arithmetic
+
+#endif  // __LAMMP_MONT_MULTI_HPP__
@@ -29,7 +29,8 @@ constexpr double table2[35] = {
     1.050138148333665e+00, 1.017367169608733e+00, 1.050598140148774e+00, 1.023832099239262e+00, 1.066666666666667e+00,
     1.043842313037765e+00, 1.023199857357361e+00, 1.004411363697657e+00, 1.057728974444613e+00, 1.040778279757500e+00,
     1.025114624994631e+00, 1.010581620377160e+00, 1.073744206698002e+00, 1.060126912180660e+00, 1.047365186724249e+00,
-    1.039781450100194e+00, 1.031607485958778e+00};
+    1.035371903296751e+00, 1.024071865484354e+00, 1.013399790574447e+00, 1.003298693368646e+00, 1.076528461771199e+00,
+    1.066666666666667e+00, 1.057279270242989e+00, 1.048328705241721e+00, 1.039781450100194e+00, 1.031607485958778e+00};
 
 };  // namespace lammp::Arithmetic::Numeral::BaseTble
 
@@ -0,0 +1,104 @@
+/*
+ * Copyright (C) 2025 HJimmyK/LAMINA
+ *
+ * This file is part of LAMMP, which is licensed under the GNU LGPL v2.1.
+ * See the LICENSE file in the project root for full license details, or visit:
+ * <https://www.gnu.org/licenses/old-licenses/lgpl-2.1.html>
+ */
+
+#ifndef __LAMMP_PROD_TREE_HPP__
+#define __LAMMP_PROD_TREE_HPP__
+
+#include <vector>
+
+#include "inter_buffer.hpp"
+#include "lammp.hpp"
+
+namespace lammp::Arithmetic {
+
+/*
+ * ============================================================
+ * 乘积树：第 0 层为输入的因子（只保存指针，不复制），
+ * 每层相邻两个结点相乘得到上一层，落单的结点直接升到上一层
+ * 构造后只读，可以在多次余数树、CRT 重建之间复用，也可以被多个线程同时使用
+ * ============================================================
+ */
+class ProductTree {
+   private:
+    struct Level {
+        std::vector<lamp_ptr> ptr;
+        std::vector<lamp_ui> len;
+        _internal_buffer<0> storage;  // 本层自有结点的存储
+    };
+    std::vector<Level> levels_;
+
+    void buildLevel();
+
+   public:
+    /*
+     * @param factors 因子数组，均不可为零，构造后仍需保持有效
+     * @param limit_len 非零时，结点长度超过 limit_len / 2 后不再往上建（此时最上层可能有多个结点）
+     */
+    ProductTree(lamp_ptr* factors, const lamp_ui* lens, lamp_ui count, lamp_ui limit_len = 0);
+
+    // 禁用拷贝
+    ProductTree(const ProductTree&) = delete;
+    ProductTree& operator=(const ProductTree&) = delete;
+
+    lamp_ui depth() const { return levels_.size(); }
+    lamp_ui count(lamp_ui level) const { return levels_[level].ptr.size(); }
+    lamp_ptr node(lamp_ui level, lamp_ui i) const { return levels_[level].ptr[i]; }
+    lamp_ui nodeLen(lamp_ui level, lamp_ui i) const { return levels_[level].len[i]; }
+
+    /*
+     * @brief 余数树：outs[i] = in mod factors[i]（squared 为 true 时为 in mod factors[i]^2）
+     * @param outs outs[i] 的长度至少为 factors[i] 的长度（squared 时为两倍）
+     * @note 最上层各结点直接对 in 取模，其余结点由父结点的余数取模，同一层并行计算
+     */
+    void remainders(lamp_ptr in, lamp_ui len, lamp_ptr* outs, lamp_ui* out_lens, bool squared = false) const;
+};  // class ProductTree
+
+/*
+ * ============================================================
+ * 中国剩余定理重建：给定两两互素的模数 m_i，由余数 r_i 求 x mod M（M = prod m_i）
+ *   x = sum c_i * (M / m_i) mod M，c_i = r_i * s_i mod m_i，s_i = (M / m_i)^-1 mod m_i
+ * s_i 在构造时由 M mod m_i^2 的余数树一次求出，sum 在乘积树上自底向上合并：
+ *   结点值 = 左值 * 右积 + 右值 * 左积
+ * 模数全为单字时，叶子上的运算只用单字乘除
+ * 构造后只读，同一组模数的多次重建共享乘积树与 s_i
+ * ============================================================
+ */
+class CrtPlan {
+   private:
+    ProductTree tree_;
+    lamp_ui count_;
+    bool word_;   // 模数是否全为单字
+    bool valid_;  // 模数两两互素
+    std::vector<lamp_ui> inv_offset_;
+    _internal_buffer<0> storage_;
+    lamp_ptr inv_;  // s_i，第 i 个从 inv_offset_[i] 开始，长度与 m_i 相同
+
+   public:
+    // mods 中的模数均不可为零，构造后仍需保持有效
+    CrtPlan(lamp_ptr* mods, const lamp_ui* lens, lamp_ui count);
+
+    // 禁用拷贝
+    CrtPlan(const CrtPlan&) = delete;
+    CrtPlan& operator=(const CrtPlan&) = delete;
+
+    bool valid() const { return valid_; }
+    // M 的长度，即结果的最大长度
+    lamp_ui size() const { return tree_.nodeLen(tree_.depth() - 1, 0); }
+    lamp_ptr product() const { return tree_.node(tree_.depth() - 1, 0); }
+
+    /*
+     * @brief 由余数 residues[i]（可以不小于 m_i）重建 out = x，0 <= x < M
+     * @param out 输出数组，长度至少为 size()
+     * @return 结果的长度
+     */
+    lamp_ui reconstruct(lamp_ptr* residues, const lamp_ui* res_lens, lamp_ptr out) const;
+};  // class CrtPlan
+
+};  // namespace lammp::Arithmetic
+
+#endif  // __LAMMP_PROD_TREE_HPP__
@@ -0,0 +1,71 @@
+/*
+ * Copyright (C) 2025 HJimmyK/LAMINA
+ *
+ * This file is part of LAMMP, which is licensed under the GNU LGPL v2.1.
+ * See the LICENSE file in the project root for full license details, or visit:
+ * <https://www.gnu.org/licenses/old-licenses/lgpl-2.1.html>
+ */
+
+#ifndef __LAMMP_THREAD_POOL_HPP__
+#define __LAMMP_THREAD_POOL_HPP__
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+namespace lammp {
+
+/*
+ * ============================================================
+ * 全局线程池
+ * 默认总并行度为 std::thread::hardware_concurrency()（调用线程也参与计算，
+ * 因此工作线程数比总并行度少一），可通过环境变量 LAMMP_NUM_THREADS 指定。
+ * parallelFor 可以在任务内部嵌套调用：调用线程自己也会领取任务，不会因等待而死锁。
+ * ============================================================
+ */
+class ThreadPool {
+   private:
+    std::vector<std::thread> workers_;
+    std::queue<std::function<void()>> tasks_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    bool stop_;
+
+    explicit ThreadPool(size_t worker_count);
+    void workerLoop();
+
+   public:
+    ~ThreadPool();
+
+    // 禁用拷贝
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    static ThreadPool& global();
+
+    // 总并行度（工作线程数 + 调用线程）
+    size_t concurrency() const { return workers_.size() + 1; }
+
+    // 递归二分时的并行层数：2^(depth - 1) 不少于总并行度，使叶子任务数不少于线程数
+    int parallelDepth() const {
+        int depth = 0;
+        while ((size_t(1) << depth) < concurrency()) {
+            depth++;
+        }
+        return depth + 1;
+    }
+
+    // 提交一个异步任务
+    void submit(std::function<void()> task);
+
+    // 并行执行 func(0), func(1), ..., func(count - 1)，阻塞直至全部完成
+    void parallelFor(size_t count, const std::function<void(size_t)>& func);
+};  // class ThreadPool
+
+};  // namespace lammp
+
+#endif  // __LAMMP_THREAD_POOL_HPP__
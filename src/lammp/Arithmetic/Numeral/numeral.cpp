@@ -10,30 +10,180 @@
 #include "../../../../include/lammp/base_cal.hpp"
 #include "../../../../include/lammp/numeral_table.h"
 #include "../../../../include/lammp/inter_buffer.hpp"
+#include "../../../../include/lammp/thread_pool.hpp"
+#include "../../../../include/lammp/uint128.hpp"
 #include "math.h"
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
 namespace lammp::Arithmetic::Numeral {    
 
-typedef struct base_index_node {
+// 子问题至少有这么多个字时才交给线程池
+constexpr lamp_ui NUMERAL_PARALLEL_MIN = 2048;
+
+// 缩放余数树所用的定点倒数 floor(2^(64 * (length + index + 2)) / M^index)，length 为其长度
+struct _pow_inv {
+    _internal_buffer<0> value;
+    lamp_ui length = 0;
+};
+
+// M^index，index = MIN_LEN * 2^k，length 为其长度；放入缓存后不再修改，可被多个线程同时读
+struct _pow_level {
     lamp_ui index;
     lamp_ui length;
-    base_index_node* front;
-    base_index_node* back;
     _internal_buffer<0> base_index;
-    base_index_node(lamp_ui _index, double base_d) {
-        index = _index;
-        length = get_buffer_size(_index, base_d);
-        base_index.resize(length);
-        front = nullptr;
-        back = nullptr;
+    // to_binary 时该层的倒数，由 _pow_cache::inverse 在该进制的锁内首次计算，之后不再修改，随该层一起释放
+    std::shared_ptr<const _pow_inv> inv;
+    // 平方得到的中间结果可能比 get_buffer_size 的估计多出两个字，capacity 为由上一层平方时所需的长度
+    _pow_level(lamp_ui _index, double base_d, lamp_ui capacity = 0)
+        : index(_index), length(get_buffer_size(_index, base_d)) {
+        base_index.resize(std::max(length, capacity) + 2);
+    }
+};
+
+// 单次转换所用的幂次表，levels[k] 为 M^(2^k)，按 index 直接取下标
+struct _pow_table {
+    std::vector<std::shared_ptr<_pow_level>> levels;
+    const _pow_level& operator[](lamp_ui index) const {
+        assert(index >= MIN_LEN && (index & (index - 1)) == 0);
+        return *levels[63ull - lammp_clz(index / MIN_LEN)];
+    }
+};
+
+/*
+ * base_num 为编译期常量的经典算法：常用进制的 base_num 作为模板参数，
+ * 除法换成乘以编译期求出的倒数（Möller–Granlund，规范化移位同样在编译期确定），不再逐字做 128/64 的除法；
+ * base_num 为 2 的幂（2、4、8、16、32 进制）时乘除都只是移位
+ */
+template <lamp_ui BASE_NUM>
+struct _fixed_base {
+    static constexpr bool pow2 = (BASE_NUM & (BASE_NUM - 1)) == 0;
+    static constexpr int bits = 63 - lammp_clz(BASE_NUM);  // pow2 时 BASE_NUM = 2^bits
+    static constexpr int shift = lammp_clz(BASE_NUM);
+    static constexpr lamp_ui norm = BASE_NUM << shift;
+    // floor((2^128 - 1) / norm) - 2^64
+    static constexpr lamp_ui inv = (_uint128(~lamp_ui(0), ~norm) / norm).low64();
+
+    // in /= BASE_NUM，返回余数
+    static lamp_ui div_rem(lamp_ptr in, lamp_ui len) {
+        lamp_ui rem = 0;
+        for (lamp_ui i = len; i-- != 0;) {
+            const lamp_ui n = in[i];
+            if constexpr (pow2) {
+                in[i] = (rem << (64 - bits)) | (n >> bits);
+                rem = n & (BASE_NUM - 1);
+            } else {
+                lamp_ui u1 = rem, u0 = n;
+                if constexpr (shift != 0) {
+                    u1 = (u1 << shift) | (u0 >> (64 - shift));
+                    u0 <<= shift;
+                }
+                lamp_ui q0, q1;
+                mul64x64to128(inv, u1, q0, q1);
+                q0 += u0;
+                q1 += u1 + 1 + (q0 < u0 ? 1 : 0);
+                lamp_ui r = u0 - q1 * norm;
+                if (r > q0) {
+                    q1--;
+                    r += norm;
+                }
+                if (r >= norm) {
+                    q1++;
+                    r -= norm;
+                }
+                in[i] = q1;
+                rem = r >> shift;
+            }
+        }
+        return rem;
     }
-}* _2pow64_index_list;
 
-typedef struct base_index_node* _base_index_list;
+    static lamp_ui num2base(lamp_ptr in, lamp_ui len, lamp_ptr res) {
+        lamp_ui res_i = 0;
+        while (len != 0 && in[len - 1] != 0) {
+            res[res_i++] = div_rem(in, len);
+            len = rlz(in, len);
+        }
+        return res_i;
+    }
+
+    static lamp_ui base2num(lamp_ptr in, lamp_ui len, lamp_ptr res) {
+        lamp_ui in_len = len, res_len = 0;
+        while (in_len != 0) {
+            lamp_ui temp = 0, product_lo = 0, product_hi = 0;
+            for (lamp_ui i = in_len; i-- != 0;) {
+                assert(in[i] < BASE_NUM);
+                if constexpr (pow2) {
+                    product_lo = temp << bits;
+                    product_hi = temp >> (64 - bits);
+                } else {
+                    mul64x64to128(temp, BASE_NUM, product_lo, product_hi);
+                }
+                product_lo += in[i];
+                product_hi += (product_lo < in[i]) ? 1 : 0;
+                in[i] = product_hi;
+                temp = product_lo;
+            }
+            res[res_len++] = temp;
+            in_len = rlz(in, in_len);
+        }
+        return res_len;
+    }
+};
+
+// 常用进制分派到 _fixed_base；2 与 8 进制、16 与 32 进制的 base_num 相同，共用一个实例，返回 false 表示未特化
+template <typename F>
+bool _dispatch_fixed(lamp_ui base_num, F&& f) {
+    switch (base_num) {
+        case GET_BASE_NUM(10):
+            f(_fixed_base<GET_BASE_NUM(10)>());
+            return true;
+        case GET_BASE_NUM(36):
+            f(_fixed_base<GET_BASE_NUM(36)>());
+            return true;
+        case GET_BASE_NUM(2):
+            f(_fixed_base<GET_BASE_NUM(2)>());
+            return true;
+        case GET_BASE_NUM(4):
+            f(_fixed_base<GET_BASE_NUM(4)>());
+            return true;
+        case GET_BASE_NUM(16):
+            f(_fixed_base<GET_BASE_NUM(16)>());
+            return true;
+        default:
+            return false;
+    }
+}
+
+// 经典算法在输入的副本上逐次做除法（乘法），调用者的 in 不会被修改，
+// 因此递归转换只在叶子处需要临时空间；叶子不超过 2 * MIN_LEN + 1 个字时副本放在栈上
+struct _classic_copy {
+    lamp_ui stack[2 * MIN_LEN + 1];
+    _internal_buffer<0> heap;
+    lamp_ptr ptr;
+
+    _classic_copy(lamp_ptr in, lamp_ui len) : ptr(stack) {
+        if (len > 2 * MIN_LEN + 1) {
+            heap = _internal_buffer<0>(len);
+            ptr = heap.data();
+        }
+        std::copy(in, in + len, ptr);
+    }
+};
 
 // 将in数组表示的数从2^64进制转换为base_num进制，存储在res数组中，返回值为res的长度
-// in数组会被修改
+// in数组不会被修改，可以含前导零
 // res数组需要足够大，至少为 get_buffer_size(len, base_d)
 lamp_ui num2base_classic(lamp_ptr in, lamp_ui len, const lamp_ui base_num, lamp_ptr res) {
+    _classic_copy work(in, len);
+    in = work.ptr;
+    len = rlz(in, len);
+    lamp_ui res_len = 0;
+    if (_dispatch_fixed(base_num, [&](auto kernel) { res_len = kernel.num2base(in, len, res); })) {
+        return res_len;
+    }
     lamp_ui res_i = 0;
     while (len != 0 && in[len - 1] != 0) {
         res[res_i++] = abs_div_rem_num64(in, len, in, base_num);
@@ -43,13 +193,19 @@ lamp_ui num2base_classic(lamp_ptr in, lamp_ui len, const lamp_ui base_num, lamp_
 }
 
 // 将in数组表示的数从base_num进制转换为2^64进制，存储在res数组中，返回值为res的长度
-// in数组会被修改
+// in数组不会被修改
 // res数组需要足够大，至少为 get_buffer_size(len, base_d)
 // 一个值得注意的特性是：
 //      虽然应当保证 in 数组中的每个元素都小于 base_num，
 //      但是即使 in 数组中的某些元素大于 base_num，函数依然可以正确工作，并可以按照正常的 base_num 进制进行转换。
 //      超过 base_num 的元素能够正确的进位。
 lamp_ui base2num_classic(lamp_ptr in, lamp_ui len, const lamp_ui base_num, lamp_ptr res) {
+    _classic_copy work(in, len);
+    in = work.ptr;
+    lamp_ui fixed_len = 0;
+    if (_dispatch_fixed(base_num, [&](auto kernel) { fixed_len = kernel.base2num(in, len, res); })) {
+        return fixed_len;
+    }
     lamp_ui in_len = len, res_len = 0;
     while (in_len != 0) {
         lamp_ui temp = 0, product_lo = 0, product_hi = 0;
@@ -172,14 +328,15 @@ lamp_ui base_power_index(const lamp_ui base_num, const lamp_ui index, lamp_ptr r
     }
 }
 
-// 只能处理 len 为二的次幂的情况，in 会被修改
+// 只能处理 len 为二的次幂的情况，in 不会被修改
 // 将2^64进制转换为base_num进制，并存储在out数组中
 lamp_ui num_base_recursive_core(lamp_ptr in,
                                        lamp_ui len,
                                        const lamp_ui base_num,
                                        const double base_d,
                                        lamp_ptr out,
-                                       const _2pow64_index_list list) {
+                                       const _pow_table& table,
+                                       int depth) {
     // assert len != 0 && len为2的幂
     assert(len != 0 && (len & (len - 1)) == 0);
 
@@ -187,62 +344,45 @@ lamp_ui num_base_recursive_core(lamp_ptr in,
         return num2base_classic(in, len, base_num, out);
     }
 
-    assert(list != nullptr);
-    assert(list->index == len / 2);
-
-    lamp_ui half_len = len / 2, pow_len = list->length, buffer_len = get_buffer_size(half_len, base_d);
-    lamp_ptr base_pow = list->base_index.data();
+    lamp_ui half_len = len / 2, buffer_len = get_buffer_size(half_len, base_d);
+    const _pow_level& level = table[half_len];
+    lamp_ui pow_len = level.length;
+    lamp_ptr base_pow = const_cast<lamp_ptr>(level.base_index.data());
     _internal_buffer<0> buffer(buffer_len, 0);
-    // low
-    buffer_len = num_base_recursive_core(in, half_len, base_num, base_d, buffer.data(), list->front);
-    // high
-    lamp_ui out_len = num_base_recursive_core(in + half_len, half_len, base_num, base_d, out, list->front);
-    // high * base_pow
-    abs_mul64_ntt_base(out, out_len, base_pow, pow_len, out, base_num);
-    out_len = rlz(out, out_len + pow_len);
+    // low 与 high 互不依赖，足够长时交给线程池
+    lamp_ui out_len = 0;
+    auto sub = [&](size_t i) {
+        if (i == 0) {
+            buffer_len = num_base_recursive_core(in, half_len, base_num, base_d, buffer.data(), table, depth - 1);
+        } else {
+            out_len = num_base_recursive_core(in + half_len, half_len, base_num, base_d, out, table, depth - 1);
+        }
+    };
+    if (depth > 0 && len >= NUMERAL_PARALLEL_MIN) {
+        ThreadPool::global().parallelFor(2, sub);
+    } else {
+        sub(0);
+        sub(1);
+    }
+    // high * base_pow，high 为零时（如 2^k 附近的稀疏数）跳过乘法
+    if (out_len > 0) {
+        abs_mul64_ntt_base(out, out_len, base_pow, pow_len, out, base_num);
+        out_len = rlz(out, out_len + pow_len);
+    }
     // out <= high * base_pow + low
     abs_add_base(buffer.data(), buffer_len, out, out_len, out, base_num);
     return rlz(out, get_add_len(out_len, buffer_len));
 }
 
-/// 创建2^64的指数列表，下面用 M 表示 2^(64 * MIN_LEN)
-/// index 为 M 的指数，length 为 M^index 在 base_num 进制下的长度，
-/// _base_index 为 M^index 的值
-_2pow64_index_list create_2pow64_index_list(lamp_ui max_index, const lamp_ui base_num, const double base_d) {
-    ///   head
-    ///     |
-    ///     ↓
-    ///     +--------+ <--front---+--------+ <--front---+--------+ <--...
-    ///     |  M^1   |            |  M^2   |            |  M^4   |
-    ///     +--------+ ---back--->+--------+ ---back--->+--------+ ----...
-    /// 2^64的指数列表， M 表示 2^(64 * MIN_LEN)
-    assert(max_index > MIN_LEN);
-    assert((max_index & (max_index - 1)) == 0);
-
-    _2pow64_index_list head = new base_index_node(MIN_LEN, base_d);
-    head->length = _2_64_power_index(base_num, MIN_LEN, head->base_index.data(), head->length);
-
-    _2pow64_index_list current = head;
-
-    for (lamp_ui i = MIN_LEN << 1; i <= max_index; i <<= 1) {
-        current->back = new base_index_node(i, base_d);
-        // 无任意基数乘法的权宜之计，直接用 NTT 乘法计算
-        abs_sqr64_ntt_base(current->base_index.data(), current->length, current->back->base_index.data(), base_num);
-        current->back->length = rlz(current->back->base_index.data(), current->back->length);
-        current->back->front = current;
-        current = current->back;
-    }
-    return head;
-}
-
-// 只能处理 len 为二的次幂的情况，in 会被修改
+// 只能处理 len 为二的次幂的情况，in 不会被修改
 // 将base_num进制转换为2^64进制，并存储在out数组中
 lamp_ui base_num_recursive_core(lamp_ptr in,
                                        lamp_ui len,
                                        const lamp_ui base_num,
                                        const double base_d,
                                        lamp_ptr out,
-                                       const _base_index_list list) {
+                                       const _pow_table& table,
+                                       int depth) {
     // assert len != 0 && len为2的幂
     assert(len != 0 && (len & (len - 1)) == 0);
 
@@ -250,73 +390,421 @@ lamp_ui base_num_recursive_core(lamp_ptr in,
         return base2num_classic(in, len, base_num, out);
     }
 
-    assert(list != nullptr);
-    assert(list->index == len / 2);
-
-    lamp_ui half_len = len / 2, pow_len = list->length, buffer_len = get_buffer_size(half_len, base_d);
-    lamp_ptr base_pow = list->base_index.data();
+    lamp_ui half_len = len / 2, buffer_len = get_buffer_size(half_len, base_d);
+    const _pow_level& level = table[half_len];
+    lamp_ui pow_len = level.length;
+    lamp_ptr base_pow = const_cast<lamp_ptr>(level.base_index.data());
     _internal_buffer<0> buffer(buffer_len, 0);
-    // low
-    buffer_len = base_num_recursive_core(in, half_len, base_num, base_d, buffer.data(), list->front);
-    // high
-    lamp_ui out_len = base_num_recursive_core(in + half_len, half_len, base_num, base_d, out, list->front);
-    // high * base_pow
-    abs_mul64(out, out_len, base_pow, pow_len, out);
-    out_len = rlz(out, out_len + pow_len);
+    // low 与 high 互不依赖，足够长时交给线程池
+    lamp_ui out_len = 0;
+    auto sub = [&](size_t i) {
+        if (i == 0) {
+            buffer_len = base_num_recursive_core(in, half_len, base_num, base_d, buffer.data(), table, depth - 1);
+        } else {
+            out_len = base_num_recursive_core(in + half_len, half_len, base_num, base_d, out, table, depth - 1);
+        }
+    };
+    if (depth > 0 && len >= NUMERAL_PARALLEL_MIN) {
+        ThreadPool::global().parallelFor(2, sub);
+    } else {
+        sub(0);
+        sub(1);
+    }
+    // high * base_pow，high 为零时跳过乘法
+    if (out_len > 0) {
+        abs_mul64(out, out_len, base_pow, pow_len, out);
+        out_len = rlz(out, out_len + pow_len);
+    }
     // out <= high * base_pow + low
     abs_add_binary(buffer.data(), buffer_len, out, out_len, out);
     return rlz(out, get_add_len(out_len, buffer_len));
 }
 
-/// 创建base_num的指数列表，下面用 M 表示 base_num^(MIN_LEN)
-/// index 为 M 的指数，length 为 M^index 在 base_num 进制下的长度，
-/// _base_index 为 M^index 的值
-_base_index_list create_base_index_list(lamp_ui max_index, const double base_d, const lamp_ui base_num) {
-    ///   head
-    ///     |
-    ///     ↓
-    ///     +--------+ <--front---+--------+ <--front---+--------+ <--...
-    ///     |  M^1   |            |  M^2   |            |  M^4   |
-    ///     +--------+ ---back--->+--------+ ---back--->+--------+ ----...
-    /// base_num的指数列表， M 表示 base_num^(MIN_LEN)
-    assert(max_index > MIN_LEN);
-    assert((max_index & (max_index - 1)) == 0);
-
-    _2pow64_index_list head = new base_index_node(MIN_LEN, base_d);
-    head->length = base_power_index(base_num, MIN_LEN, head->base_index.data(), head->length);
-
-    _2pow64_index_list current = head;
-    for (lamp_ui i = MIN_LEN << 1; i <= max_index; i <<= 1) {
-        current->back = new base_index_node(i, base_d);
-        abs_mul64(current->base_index.data(), current->length, current->base_index.data(), current->length,
-                  current->back->base_index.data());
-        current->back->length = rlz(current->back->base_index.data(), current->back->length);
-        current->back->front = current;
-        current = current->back;
-    }
-    return head;
+/*
+ * 基数幂的进程级缓存：按 (base_num, 方向) 保存 M^1, M^2, M^4, ...，多次转换之间复用。
+ *   to_binary = false 时 M = 2^(64 * MIN_LEN)，用 base_num 进制表示（binary2base）；
+ *   to_binary = true 时 M = base_num^MIN_LEN，用 2^64 进制表示（base2binary）。
+ * 幂次表只向后追加，已追加的层不再修改，取出时复制 shared_ptr，清空缓存不会影响正在进行的转换。
+ * 同一进制的增长由该进制自己的锁串行化，并发请求同一进制时只计算一次；
+ * 缓存总字数超过上限时，后面的层只为本次转换临时计算，不放入缓存。各层的倒数同样计入总字数
+ */
+class _pow_cache {
+   private:
+    struct _entry {
+        std::mutex mutex;
+        std::vector<std::shared_ptr<_pow_level>> levels;
+        lamp_ui words = 0;
+        bool alive = true;  // 被 clear 移出后不再追加
+    };
+
+    std::mutex mutex_;
+    std::map<std::pair<lamp_ui, bool>, std::shared_ptr<_entry>> entries_;
+    std::atomic<lamp_ui> words_{0};
+    std::atomic<lamp_ui> limit_{POW_CACHE_DEFAULT_WORDS};
+
+    // 由上一层（或从头）计算 index 对应的一层
+    static std::shared_ptr<_pow_level> next_level(const _pow_level* prev,
+                                                  lamp_ui index,
+                                                  lamp_ui base_num,
+                                                  double base_d,
+                                                  bool to_binary) {
+        auto level = std::make_shared<_pow_level>(index, base_d, prev == nullptr ? 0 : prev->length * 2);
+        lamp_ptr out = level->base_index.data();
+        if (prev == nullptr) {
+            level->length = to_binary ? base_power_index(base_num, index, out, level->length)
+                                      : _2_64_power_index(base_num, index, out, level->length);
+            return level;
+        }
+        lamp_ptr in = const_cast<lamp_ptr>(prev->base_index.data());
+        if (to_binary) {
+            abs_mul64(in, prev->length, in, prev->length, out);
+        } else {
+            // 无任意基数乘法的权宜之计，直接用 NTT 乘法计算
+            abs_sqr64_ntt_base(in, prev->length, out, base_num);
+        }
+        level->length = rlz(out, std::max(level->length, prev->length * 2));
+        return level;
+    }
+
+    static std::shared_ptr<const _pow_inv> make_inverse(const _pow_level& level) {
+        const lamp_ui n = level.index, s = level.length + n + 2;
+        auto inv = std::make_shared<_pow_inv>();
+        _internal_buffer<0> num(s + 1, 0);
+        num.data()[s] = 1;
+        inv->value = _internal_buffer<0>(n + 4, 0);
+        abs_div64(num.data(), s + 1, const_cast<lamp_ptr>(level.base_index.data()), level.length, inv->value.data());
+        inv->length = rlz(inv->value.data(), n + 4);
+        return inv;
+    }
+
+    // 预留 words 个字的缓存额度
+    bool reserve(lamp_ui words) {
+        lamp_ui used = words_.load();
+        do {
+            if (used + words > limit_.load()) {
+                return false;
+            }
+        } while (!words_.compare_exchange_weak(used, used + words));
+        return true;
+    }
+
+   public:
+    static _pow_cache& global() {
+        static _pow_cache cache;
+        return cache;
+    }
+
+    // 取出 M^1 ~ M^(max_index / MIN_LEN) 的幂次表，缺少的层按需计算
+    _pow_table get(lamp_ui base_num, double base_d, bool to_binary, lamp_ui max_index) {
+        assert(max_index >= MIN_LEN && (max_index & (max_index - 1)) == 0);
+        std::shared_ptr<_entry> entry;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto& slot = entries_[{base_num, to_binary}];
+            if (slot == nullptr) {
+                slot = std::make_shared<_entry>();
+            }
+            entry = slot;
+        }
+        const lamp_ui count = 64ull - lammp_clz(max_index / MIN_LEN);
+        _pow_table table;
+        table.levels.reserve(count);
+        std::lock_guard<std::mutex> lock(entry->mutex);
+        const lamp_ui cached = std::min<lamp_ui>(count, entry->levels.size());
+        table.levels.assign(entry->levels.begin(), entry->levels.begin() + cached);
+        bool cacheable = entry->alive;
+        while (table.levels.size() < count) {
+            const _pow_level* prev = table.levels.empty() ? nullptr : table.levels.back().get();
+            table.levels.push_back(next_level(prev, MIN_LEN << table.levels.size(), base_num, base_d, to_binary));
+            const lamp_ui words = table.levels.back()->length;
+            cacheable = cacheable && reserve(words);
+            if (cacheable) {
+                entry->levels.push_back(table.levels.back());
+                entry->words += words;
+            }
+        }
+        return table;
+    }
+
+    // table 中 index 对应一层（to_binary）的倒数：该层仍在缓存中且额度足够时与该层一起缓存，否则只为本次转换计算。
+    // 层的 inv 只在该层所属进制的锁内、且该层仍在缓存中时读写
+    std::shared_ptr<const _pow_inv> inverse(lamp_ui base_num, const _pow_table& table, lamp_ui index) {
+        const lamp_ui k = 63ull - lammp_clz(index / MIN_LEN);
+        const std::shared_ptr<_pow_level>& level = table.levels[k];
+        std::shared_ptr<_entry> entry;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = entries_.find({base_num, true});
+            if (it != entries_.end()) {
+                entry = it->second;
+            }
+        }
+        if (entry != nullptr) {
+            std::lock_guard<std::mutex> lock(entry->mutex);
+            if (k < entry->levels.size() && entry->levels[k] == level) {
+                if (level->inv == nullptr) {
+                    auto inv = make_inverse(*level);
+                    if (!reserve(inv->length)) {
+                        return inv;
+                    }
+                    level->inv = inv;
+                    entry->words += inv->length;
+                }
+                return level->inv;
+            }
+        }
+        return make_inverse(*level);
+    }
+
+    lamp_ui words() const { return words_.load(); }
+
+    void clear() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto& item : entries_) {
+            std::lock_guard<std::mutex> entry_lock(item.second->mutex);
+            words_ -= item.second->words;
+            item.second->levels.clear();
+            item.second->words = 0;
+            item.second->alive = false;
+        }
+        entries_.clear();
+    }
+
+    void set_limit(lamp_ui words) {
+        limit_ = words;
+        if (words_.load() > words) {
+            clear();
+        }
+    }
+};
+
+void set_pow_cache_limit(lamp_ui words) { _pow_cache::global().set_limit(words); }
+
+void clear_pow_cache() { _pow_cache::global().clear(); }
+
+lamp_ui pow_cache_words() { return _pow_cache::global().words(); }
+
+BasePower get_base_power(lamp_ui base, lamp_ui index) {
+    const _pow_table table = _pow_cache::global().get(GET_BASE_NUM(base), 1.0 / GET_BASE_D(base), true, index);
+    const std::shared_ptr<_pow_level>& level = table.levels.back();
+    return BasePower{level, level->base_index.data(), level->length};
+}
+
+/*
+ * 按 2 的幂次方长度分割后转换，to_binary 为转换方向（binary2base / base2binary 共用）
+ * 各子部分的转换互不依赖，先一起交给线程池，再由低位到高位依次合并：
+ *   res += part_i * pow，pow *= M^len_i
+ */
+lamp_ui _convert(lamp_ptr in, lamp_ui len, const lamp_ui base_num, const double base_d, bool to_binary,
+                 lamp_ptr res) {
+    const _pow_table table = _pow_cache::global().get(base_num, base_d, to_binary, 1ull << (63ull - lammp_clz(len)));
+
+    // 子部分：长度为 2^k，末尾不超过 MIN_LEN 的部分用经典算法；part 0 直接写入 res
+    std::vector<lamp_ui> part_start, part_len, part_offset(1, 0);
+    for (lamp_ui current_len = len; current_len > 0;) {
+        const lamp_ui pri_len = current_len <= MIN_LEN ? current_len : 1ull << (63ull - lammp_clz(current_len));
+        part_start.push_back(len - current_len);
+        part_len.push_back(pri_len);
+        part_offset.push_back(part_offset.back() + (part_len.size() == 1 ? 0 : get_buffer_size(pri_len, base_d)));
+        current_len -= pri_len;
+    }
+    const size_t count = part_len.size();
+    _internal_buffer<0> parts(part_offset.back() + 1, 0);
+    std::vector<lamp_ui> out_len(count, 0);
+    const int depth = ThreadPool::global().parallelDepth();
+    ThreadPool::global().parallelFor(count, [&](size_t i) {
+        lamp_ptr current_in = in + part_start[i];
+        lamp_ptr out = i == 0 ? res : parts.data() + part_offset[i];
+        if (part_len[i] <= MIN_LEN) {
+            out_len[i] = to_binary ? base2num_classic(current_in, part_len[i], base_num, out)
+                                   : num2base_classic(current_in, part_len[i], base_num, out);
+        } else if (to_binary) {
+            out_len[i] = base_num_recursive_core(current_in, part_len[i], base_num, base_d, out, table, depth);
+        } else {
+            out_len[i] = num_base_recursive_core(current_in, part_len[i], base_num, base_d, out, table, depth);
+        }
+    });
+
+    // 合并，乘积与 pow 都不会超过所有子部分缓冲区的总长
+    lamp_ui res_len = out_len[0];
+    const lamp_ui total_len = get_buffer_size(part_len[0], base_d) + part_offset.back() + 2;
+    _internal_buffer<0> pow(total_len, 0), product(total_len, 0);
+    const _pow_level& first = table[part_len[0]];
+    std::copy(first.base_index.data(), first.base_index.data() + first.length, pow.data());
+    lamp_ui pow_len = first.length;
+    for (size_t i = 1; i < count; i++) {
+        lamp_ptr part = parts.data() + part_offset[i];
+        if (out_len[i] > 0) {
+            // 任意基数下 ntt 只是权宜之计，目前没有适配的任意基数卡拉楚巴乘法
+            lamp_ui product_len = get_mul_len(out_len[i], pow_len);
+            if (to_binary) {
+                abs_mul64(part, out_len[i], pow.data(), pow_len, product.data());
+            } else {
+                abs_mul64_ntt_base(part, out_len[i], pow.data(), pow_len, product.data(), base_num);
+            }
+            product_len = rlz(product.data(), product_len);
+            if (to_binary) {
+                abs_add_binary(product.data(), product_len, res, res_len, res);
+            } else {
+                abs_add_base(product.data(), product_len, res, res_len, res, base_num);
+            }
+            res_len = rlz(res, get_add_len(res_len, product_len));
+        }
+        if (i + 1 < count) {
+            // 更新 pow，除最后一个子部分外长度都是 2^k
+            const _pow_level& current = table[part_len[i]];
+            if (to_binary) {
+                abs_mul64(pow.data(), pow_len, const_cast<lamp_ptr>(current.base_index.data()), current.length,
+                          product.data());
+            } else {
+                abs_mul64_ntt_base(pow.data(), pow_len, const_cast<lamp_ptr>(current.base_index.data()),
+                                   current.length, product.data(), base_num);
+            }
+            pow_len = rlz(product.data(), get_mul_len(pow_len, current.length));
+            std::copy(product.data(), product.data() + pow_len, pow.data());
+        }
+    }
+    return res_len;
 }
 
-// 在链表中查找 index 对应的节点
-_2pow64_index_list find_head(_2pow64_index_list head, lamp_ui index) {
-    while (head->back != nullptr) {
-        if (head->index == index)
-            return head;
-        head = head->back;
+/*
+ * 缩放余数树（Bernstein）：二进制转换为 base_num 进制时各层只做二进制乘法，既不做除法，也不做任意基数乘法。
+ * x < B^N（B = base_num，N = MIN_LEN * 2^K），由 B^N 的定点倒数得到小数 f = (x + 1/2) / B^N；
+ * 长为 n 个 B 进制位的一段对应一个小数 f，这一段的值为 floor(f * B^n)：
+ *   高半段的小数仍为 f，低半段为 frac(f * B^(n/2))，都截断到 n/2 + 2 个字再向下传，每层只需一次 f * B^(n/2)；
+ *   叶子处逐次乘以 B，溢出的字依次为各位
+ * 截断只要不改变 floor(f * B^m) 就不影响结果。记尾部 t = frac(f * B^m)，t >= 1/2 时向下舍入，否则向上舍入，
+ * 截断误差在尾部的尺度下不超过 2^-128，floor 不变。高半段的尾部即乘积的小数部分，低半段的尾部与本段相同，
+ * 只需向下传一个标志；取 x + 1/2 使最顶层的尾部约为 1/2，之后每层的截断只使尾部偏离 2^-128
+ */
+namespace {
+
+// 小数 src（src_len 个字）截断为高 dst_len 个字，up 时向上舍入；dst 至少 dst_len + 1 个字
+void _srt_round(lamp_ptr src, lamp_ui src_len, lamp_ui dst_len, bool up, lamp_ptr dst) {
+    const lamp_ui drop = src_len - dst_len;
+    std::copy(src + drop, src + src_len, dst);
+    dst[dst_len] = 0;
+    if (up && rlz(src, drop) > 0) {
+        lamp_ui one = 1;
+        abs_add_binary(dst, dst_len, &one, 1, dst);
+        // 只在尾部小于 1/2 时向上舍入，小数不会进位到 1
+        assert(dst[dst_len] == 0);
     }
-    if (head->index == index)
-        return head;
-    return nullptr;
 }
 
-void destroy_list(_2pow64_index_list head) {
-    while (head != nullptr) {
-        _2pow64_index_list next = head->back;
-        delete head;
-        head = next;
+// frac 为 n + 2 个字的小数，out[pos, pos + n) 中位于 limit 之前的部分写入 floor(frac * B^n) 的各位，
+// tail_high 表示这一段的尾部不小于 1/2（在截断误差之内）
+void _srt_node(lamp_ptr frac,
+               lamp_ui n,
+               bool tail_high,
+               lamp_ui pos,
+               lamp_ui limit,
+               lamp_ui base_num,
+               lamp_ptr out,
+               const _pow_table& table,
+               int depth) {
+    if (pos >= limit) {
+        return;
+    }
+    const lamp_ui frac_len = n + 2;
+    if (n <= MIN_LEN) {
+        // 叶子：frac 依次乘以 B，溢出的字即为下一位（高位在前）
+        const lamp_ui count = std::min(n, limit - pos);
+        _internal_buffer<0> f(frac_len + 1);
+        std::copy(frac, frac + frac_len, f.data());
+        for (lamp_ui i = n; i-- > 0;) {
+            abs_mul_add_num64(f.data(), frac_len, f.data(), 0, base_num);
+            if (i < count) {
+                out[pos + i] = f.data()[frac_len];
+            } else {
+                assert(f.data()[frac_len] == 0);
+            }
+        }
+        return;
+    }
+    const lamp_ui half = n / 2, child_len = half + 2;
+    const _pow_level& level = table[half];
+    _internal_buffer<0> high(child_len + 1), low(child_len + 1);
+    bool high_zero = false, low_tail_high = false;
+    {
+        // prod = frac * B^half，低 frac_len 个字为低半段的小数，其余为高半段的值
+        const lamp_ui pow_len = level.length, f_len = rlz(frac, frac_len);
+        _internal_buffer<0> prod(frac_len + pow_len, 0);
+        if (f_len > 0) {
+            abs_mul64(frac, f_len, const_cast<lamp_ptr>(level.base_index.data()), pow_len, prod.data());
+        }
+        high_zero = rlz(prod.data() + frac_len, pow_len) == 0;
+        low_tail_high = (prod.data()[frac_len - 1] >> 63) != 0;
+        _srt_round(frac, frac_len, child_len, !low_tail_high, high.data());
+        _srt_round(prod.data(), frac_len, child_len, !tail_high, low.data());
+    }
+    auto sub = [&](size_t i) {
+        if (i == 0) {
+            _srt_node(low.data(), half, tail_high, pos, limit, base_num, out, table, depth - 1);
+        } else if (!high_zero) {
+            _srt_node(high.data(), half, low_tail_high, pos + half, limit, base_num, out, table, depth - 1);
+        } else if (pos + half < limit) {
+            // 高半段为零
+            std::fill(out + pos + half, out + std::min(pos + n, limit), lamp_ui(0));
+        }
+    };
+    if (depth > 0 && n >= NUMERAL_PARALLEL_MIN) {
+        ThreadPool::global().parallelFor(2, sub);
+    } else {
+        sub(0);
+        sub(1);
     }
 }
 
+};  // namespace
+
+lamp_ui binary2base_srt(lamp_ptr in, lamp_ui len, const lamp_ui base, lamp_ptr res) {
+    len = rlz(in, len);
+    if (len == 0) {
+        return 0;
+    }
+    const lamp_ui base_num = GET_BASE_NUM(base), limit = get_buffer_size(len, GET_BASE_D(base));
+    lamp_ui N = MIN_LEN;
+    while (N < limit) {
+        N *= 2;
+    }
+    // B^(N/2), B^(N/4), ..., B^MIN_LEN 与 base2binary 共用缓存；B^N 只用来求倒数
+    const _pow_table table = _pow_cache::global().get(base_num, 1.0 / GET_BASE_D(base), true, N);
+    const _pow_level& top = table[N];
+    const lamp_ui pow_len = top.length, frac_len = N + 2;
+
+    // r = floor(2^(64 * s) / B^N)，与 B^N 一起缓存（计入缓存上限），之后的转换不再做除法；
+    // x < 2^(64 * pow_len)，s = pow_len + N + 2 使 r 的截断误差对 f 的影响远小于 B^-N
+    const lamp_ui s = pow_len + N + 2;
+    const std::shared_ptr<const _pow_inv> inv = _pow_cache::global().inverse(base_num, table, N);
+    lamp_ptr r = const_cast<lamp_ptr>(inv->value.data());
+    const lamp_ui r_len = inv->length;
+
+    // f = (2x + 1) * r / 2^(64 * s + 1)，取 frac_len 个字
+    _internal_buffer<0> x2(len + 1);
+    lamp_ui carry = 1;
+    for (lamp_ui i = 0; i < len; i++) {
+        x2.data()[i] = (in[i] << 1) | carry;
+        carry = in[i] >> 63;
+    }
+    x2.data()[len] = carry;
+    const lamp_ui x2_len = rlz(x2.data(), len + 1), q_len = x2_len + r_len;
+    _internal_buffer<0> q(std::max(q_len, s + 1) + 1, 0);
+    abs_mul64(x2.data(), x2_len, r, r_len, q.data());
+    x2 = _internal_buffer<0>();
+    _internal_buffer<0> frac(frac_len);
+    const lamp_ptr q_top = q.data() + (s - frac_len);
+    for (lamp_ui i = 0; i < frac_len; i++) {
+        frac.data()[i] = (q_top[i] >> 1) | (q_top[i + 1] << 63);
+    }
+    // f < 1，即 q < 2^(64 * s + 1)
+    assert(q.data()[s] <= 1 && rlz(q.data(), std::max(q_len, s + 1)) <= s + 1);
+    q = _internal_buffer<0>();
+
+    _srt_node(frac.data(), N, false, 0, limit, base_num, res, table, ThreadPool::global().parallelDepth());
+    return rlz(res, limit);
+}
+
 /// @brief 将一个表示为64位块数组的大整数从二进制（基数2^64）转换为指定的较小基数
 /// @param in 表示要转换的大整数的输入数组。数组的每个元素都是该整数的一个64位块
 /// @param len 输入数组中64位块的数量
@@ -325,7 +813,7 @@ void destroy_list(_2pow64_index_list head) {
 /// @return 转换后的结果数组的长度
 /// @note
 ///  1. 该函数不会对 res 进行边界检查，调用者需要确保res有足够的空间来存储转换后的结果
-///  2. 该函数会修改输入数组 in 的内容（正确计算后，应为全零），因此如果需要保留原始数据，调用者应在调用前进行备份
+///  2. 该函数不会修改输入数组 in，只有叶子处的经典算法在不超过 2 * MIN_LEN + 1 个字的副本上计算
 lamp_ui binary2base(lamp_ptr in, lamp_ui len, const lamp_ui base, lamp_ptr res) {
     // 1. 分割策略：按 2 的幂次方长度分割
     //         每次处理的子部分长度都是 2^k（num_base_recursive_core会递归处理这部分），
@@ -334,101 +822,38 @@ lamp_ui binary2base(lamp_ptr in, lamp_ui len, const lamp_ui base, lamp_ptr res)
     //         代码中 `pri_len = 1ull << current_index` 就是计算当前要处理的子部分长度
     //
     // 2. 预计算缓存：避免重复计算
-    //         通过create_2pow64_index_list创建预计算链表，存储不同长度（2 的幂）的子部分在目标进制下的表示
-    //         链表的结构如下：
-    ///             head
-    ///              |
-    ///              ↓
-    ///              +--------+ <--front--- +--------+ <--front--- +--------+ <--...
-    ///              |  M^1   |             |  M^2   |             |  M^4   |
-    ///              +--------+ ---back---> +--------+ ---back---> +--------+ ----...
-    ///         其中 M 表示 2^(64 * MIN_LEN)，`M^i` 表示 2^(64 * MIN_LEN * i)
-    //         代码中通过`find_head(head, pri_len)` 用于查找当前子部分长度对应的预计算数据。
+    //         幂次表 M^1, M^2, M^4, ... 在目标进制下的表示取自进程级缓存（_pow_cache），按需增长，多次转换之间复用
+    //         其中 M 表示 2^(64 * MIN_LEN)，`M^i` 表示 2^(64 * MIN_LEN * i)
+    //         代码中通过`table[pri_len]` 直接按下标取出当前子部分长度对应的预计算数据。
     //
     // 3. 子问题处理：
     //         对每个子部分（长度`pri_len`）调用 `num_base_recursive_core` 进行进制转换，
     //         这个递归函数会继续将子部分分割为更小的部分，直到达到 MIN_LEN 阈值后使用经典算法
+    //         各子部分互不依赖，一起交给全局线程池；递归的前几层中高低两半也并行计算（NUMERAL_PARALLEL_MIN）
     //
     // 4. 合并策略：
     //         基数幂乘法 + 加法 由于大整数的各子部分在原始表示中是 "高位在前" 的（类似a * B ^ n + b，其中 B
     //         是原始基数）， 合并时需要： 将剩余子部分的转换结果乘以 base ^ pow（pow是之前处理的总长度）
-    //         与已累计的结果相加，代码中通过
+    //         与已累计的结果相加（所有子部分转换完成后，由低位到高位依次合并，见 _convert），代码中通过
     //         `abs_mul64_ntt_base`实现乘法，`abs_add_base`实现加法，`base_pow`数组动态维护当前需要的基数幂值，随处理过程更新
     //         需要注意的是：随着递归的进行，剩余子部分的转换结果乘以基数幂，这通常是一个不平衡乘法，
     //         使用NTT-crt可能并不能达到最佳性能，使用 Karatsuba 等方法可能会更合适
     //
     // 5. 终止条件：小规模使用经典算法 当剩余长度 <= MIN_LEN时，不再分割，直接调用 num2base_classic 处理。
+    //
+    // 以上为 2 的幂进制的做法；其余进制改用缩放余数树（binary2base_srt），只做二进制乘法，
+    // 基数幂及其倒数缓存之后，比 base_num 进制下的 NTT 乘法快
 
     lamp_ui base_num = GET_BASE_NUM(base);
     double base_d = GET_BASE_D(base);
-    const lamp_ui max_len_2pow_index = 63ull - lammp_clz(len);
 
     if (len <= 2 * MIN_LEN) {
         return num2base_classic(in, len, base_num, res);
     }
-    _2pow64_index_list head = create_2pow64_index_list(1ull << max_len_2pow_index, base_num, base_d);
-    lamp_ptr current_in = in;
-
-    lamp_ui pow_len = 0, res_len = 0;
-    _internal_buffer<0> base_pow(get_buffer_size(len, base_d), 0);
-
-    for (lamp_ui current_len = len; current_len > MIN_LEN;) {
-        lamp_ui current_index = 63ull - lammp_clz(current_len);
-        lamp_ui pri_len = 1ull << current_index;
-        lamp_ui buffer_len = get_buffer_size(pri_len, base_d) + pow_len;
-
-        _2pow64_index_list current_list = find_head(head, pri_len);
-        assert(current_list != nullptr);
-        assert(current_list->index == pri_len);
-
-        // 计算 base_pow 并计算 buffer * base_pow => res
-        if (pow_len == 0) {
-            res_len =
-                num_base_recursive_core(current_in, pri_len, base_num, base_d, res, current_list->front);
-            std::copy(current_list->base_index.begin(), current_list->base_index.end(), base_pow.begin());
-            pow_len = current_list->length;
-        } else {
-            _internal_buffer<0> buffer(buffer_len, 0);
-            buffer_len = num_base_recursive_core(current_in, pri_len, base_num, base_d, buffer.data(),
-                                                 current_list->front);
-            // ntt 只是权宜之计，目前没有适配的任意基数卡拉楚巴乘法
-            abs_mul64_ntt_base(buffer.data(), buffer_len, base_pow.data(), pow_len, buffer.data(), base_num);
-            buffer_len = rlz(buffer.data(), get_mul_len(buffer_len, pow_len));
-            abs_add_base(buffer.data(), buffer_len, res, res_len, res, base_num);
-            res_len = rlz(res, get_add_len(res_len, buffer_len));
-
-            // 更新 base_pow
-            // 同上上述，这里的 ntt 也只是权宜之计，没有适配的任意基数卡拉楚巴乘法
-            abs_mul64_ntt_base(base_pow.data(), pow_len, current_list->base_index.data(), current_list->length,
-                               base_pow.data(), base_num);
-            pow_len = rlz(base_pow.data(), get_mul_len(pow_len, current_list->length));
-        }
-
-        current_len -= pri_len;
-        current_in += pri_len;
-
-        if (current_len == 0) {
-            destroy_list(head);
-            return res_len;
-        }
-
-        if (current_len <= MIN_LEN) {
-            buffer_len = get_buffer_size(pri_len, base_d) + pow_len;
-            _internal_buffer<0> buffer(buffer_len, 0);
-            buffer_len = num2base_classic(current_in, current_len, base_num, buffer.data());
-
-            // ntt 只是权宜之计，目前没有适配的任意基数卡拉楚巴乘法
-            abs_mul64_ntt_base(buffer.data(), buffer_len, base_pow.data(), pow_len, buffer.data(), base_num);
-            buffer_len = rlz(buffer.data(), get_mul_len(buffer_len, pow_len));
-            abs_add_base(buffer.data(), buffer_len, res, res_len, res, base_num);
-            res_len = rlz(res, get_add_len(res_len, buffer_len));
-            destroy_list(head);
-            return res_len;
-        }
+    if ((base_num & (base_num - 1)) != 0) {
+        return binary2base_srt(in, len, base, res);
     }
-    destroy_list(head);
-    assert(false);
-    return 0;
+    return _convert(in, len, base_num, base_d, false, res);
 }
 
 /// @brief 将一个表示为64位块数组的大整数从base进制（基数base_num）转换为指定的二进制（基数2^64）
@@ -439,76 +864,15 @@ lamp_ui binary2base(lamp_ptr in, lamp_ui len, const lamp_ui base, lamp_ptr res)
 /// @return 转换后的结果数组的长度
 /// @note
 ///  1. 该函数不会对 res 进行边界检查，调用者需要确保res有足够的空间来存储转换后的结果
-///  2. 该函数会修改输入数组 in 的内容（正确计算后，应为全零），因此如果需要保留原始数据，调用者应在调用前进行备份
+///  2. 该函数不会修改输入数组 in，只有叶子处的经典算法在不超过 2 * MIN_LEN + 1 个字的副本上计算
 lamp_ui base2binary(lamp_ptr in, lamp_ui len, const lamp_ui base, lamp_ptr res) {
     lamp_ui base_num = GET_BASE_NUM(base);
     double base_d = 1.0 / GET_BASE_D(base);
-    const lamp_ui max_len_base_index = 63ull - lammp_clz(len);
 
     if (len <= 2 * MIN_LEN) {
         return base2num_classic(in, len, base_num, res);
     }
-    _base_index_list head = create_base_index_list(1ull << max_len_base_index, base_d, base_num);
-    lamp_ptr current_in = in;
-
-    lamp_ui pow_len = 0, res_len = 0;
-    _internal_buffer<0> _2_64_pow(get_buffer_size(len, base_d), 0);
-
-    for (lamp_ui current_len = len; current_len > MIN_LEN;) {
-        lamp_ui current_index = 63ull - lammp_clz(current_len);
-        lamp_ui pri_len = 1ull << current_index;
-        lamp_ui buffer_len = get_buffer_size(pri_len, base_d) + pow_len;
-
-        _base_index_list current_list = find_head(head, pri_len);
-        assert(current_list != nullptr);
-        assert(current_list->index == pri_len);
-
-        // 计算 base_pow 并计算 buffer * base_pow => res
-        if (pow_len == 0) {
-            res_len =
-                base_num_recursive_core(current_in, pri_len, base_num, base_d, res, current_list->front);
-            std::copy(current_list->base_index.begin(), current_list->base_index.end(), _2_64_pow.begin());
-            pow_len = current_list->length;
-        } else {
-            _internal_buffer<0> buffer(buffer_len, 0);
-            buffer_len = base_num_recursive_core(current_in, pri_len, base_num, base_d, buffer.data(),
-                                                 current_list->front);
-            abs_mul64(buffer.data(), buffer_len, _2_64_pow.data(), pow_len, buffer.data());
-            buffer_len = rlz(buffer.data(), get_mul_len(buffer_len, pow_len));
-            abs_add_binary(buffer.data(), buffer_len, res, res_len, res);
-            res_len = rlz(res, get_add_len(res_len, buffer_len));
-
-            // 更新 base_pow
-            abs_mul64(_2_64_pow.data(), pow_len, current_list->base_index.data(), current_list->length,
-                      _2_64_pow.data());
-            pow_len = rlz(_2_64_pow.data(), get_mul_len(pow_len, current_list->length));
-        }
-
-        current_len -= pri_len;
-        current_in += pri_len;
-
-        if (current_len == 0) {
-            destroy_list(head);
-            return res_len;
-        }
-
-        if (current_len <= MIN_LEN) {
-            buffer_len = get_buffer_size(pri_len, base_d) + pow_len;
-            _internal_buffer<0> buffer(buffer_len, 0);
-            buffer_len = base2num_classic(current_in, current_len, base_num, buffer.data());
-
-            abs_mul64(buffer.data(), buffer_len, _2_64_pow.data(), pow_len, buffer.data());
-            buffer_len = rlz(buffer.data(), get_mul_len(buffer_len, pow_len));
-            abs_add_binary(buffer.data(), buffer_len, res, res_len, res);
-            res_len = rlz(res, get_add_len(res_len, buffer_len));
-            destroy_list(head);
-            return res_len;
-        }
-    }
-    destroy_list(head);
-    assert(false);
-    return 0;
+    return _convert(in, len, base_num, base_d, true, res);
 }
 
-
 };  // namespace Numeral
\ No newline at end of file
@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2025 HJimmyK/LAMINA
+ *
+ * This file is part of LAMMP, which is licensed under the GNU LGPL v2.1.
+ * See the LICENSE file in the project root for full license details, or visit:
+ * <https://www.gnu.org/licenses/old-licenses/lgpl-2.1.html>
+ */
+
+#include <algorithm>
+#include <cstring>
+
+#include "../../../../include/lammp/lammp.hpp"
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define __LAMMP_DIGITS_SSE2
+#endif
+
+/*
+ * 单个 base_num 位到字符：十进制不再逐位 % 10、/ 10（19 次相互依赖的除法），
+ * 而是先按 10^16、10^8、10^4 拆分（常数除法由编译器换成乘以倒数），每 4 位再查两位数字表；
+ * x86-64 上 SSE2 为基本指令集，16 位数字由两组 8 位在向量中同时拆分（乘高位代替除法）
+ */
+namespace lammp::Arithmetic::Numeral {
+
+namespace {
+
+constexpr char _digit_pairs[] =
+    "0001020304050607080910111213141516171819"
+    "2021222324252627282930313233343536373839"
+    "4041424344454647484950515253545556575859"
+    "6061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+// v < 10^4，高位在前写 4 个字符
+inline void _put4(lamp_ui v, char* out) {
+    std::memcpy(out, _digit_pairs + (v / 100) * 2, 2);
+    std::memcpy(out + 2, _digit_pairs + (v % 100) * 2, 2);
+}
+
+#if defined(__LAMMP_DIGITS_SSE2)
+// v < 10^8，8 个 16 位通道依次为 v 的各位数字（高位在前）
+inline __m128i _split8(uint32_t v) {
+    const __m128i x = _mm_cvtsi32_si128(int(v));
+    // abcd = v / 10^4，efgh = v % 10^4
+    const __m128i abcd = _mm_srli_epi64(_mm_mul_epu32(x, _mm_set1_epi32(int(0xD1B71759u))), 45);
+    const __m128i efgh = _mm_sub_epi32(x, _mm_mul_epu32(abcd, _mm_set1_epi32(10000)));
+    // [abcd * 4 x4, efgh * 4 x4]
+    __m128i t = _mm_slli_epi64(_mm_unpacklo_epi16(abcd, efgh), 2);
+    t = _mm_unpacklo_epi16(t, t);
+    t = _mm_unpacklo_epi32(t, t);
+    // 分别除以 10^3、10^2、10^1、10^0：[a, ab, abc, abcd, e, ef, efg, efgh]
+    t = _mm_mulhi_epu16(t, _mm_setr_epi16(8389, 5243, 13108, short(32768), 8389, 5243, 13108, short(32768)));
+    t = _mm_mulhi_epu16(t, _mm_setr_epi16(1 << 7, 1 << 11, 1 << 13, short(1 << 15), 1 << 7, 1 << 11, 1 << 13,
+                                          short(1 << 15)));
+    // 减去前一通道的 10 倍，只剩最低一位
+    return _mm_sub_epi16(t, _mm_slli_epi64(_mm_mullo_epi16(t, _mm_set1_epi16(10)), 16));
+}
+#endif
+
+// v < 10^16，高位在前写 16 个字符
+inline void _put16(lamp_ui v, char* out) {
+    const uint32_t hi = uint32_t(v / 100000000), lo = uint32_t(v % 100000000);
+#if defined(__LAMMP_DIGITS_SSE2)
+    const __m128i digits = _mm_packus_epi16(_split8(hi), _split8(lo));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_add_epi8(digits, _mm_set1_epi8('0')));
+#else
+    _put4(hi / 10000, out);
+    _put4(hi % 10000, out + 4);
+    _put4(lo / 10000, out + 8);
+    _put4(lo % 10000, out + 12);
+#endif
+}
+
+};  // namespace
+
+void base_num2str(lamp_ui val, lamp_ui base, lamp_ui len, char* out, bool msb_first) {
+    assert(base >= 2 && base <= 36 && len <= 64);
+    if (base == 10 && len <= 20) {
+        // 2^64 < 10^20：前 4 位与后 16 位，取末尾 len 位
+        char buf[20];
+        _put4(val / 10000000000000000ull, buf);
+        _put16(val % 10000000000000000ull, buf + 4);
+        const char* digits = buf + 20 - len;
+        if (msb_first) {
+            std::copy(digits, digits + len, out);
+        } else {
+            std::reverse_copy(digits, digits + len, out);
+        }
+        return;
+    }
+    for (lamp_ui i = 0; i < len; i++) {
+        const lamp_ui d = val % base;
+        out[msb_first ? len - 1 - i : i] = char(d < 10 ? '0' + d : 'a' + (d - 10));
+        val /= base;
+    }
+}
+
+};  // namespace lammp::Arithmetic::Numeral
@@ -0,0 +1,173 @@
+/*
+ * Copyright (C) 2025 HJimmyK/LAMINA
+ *
+ * This file is part of LAMMP, which is licensed under the GNU LGPL v2.1.
+ * See the LICENSE file in the project root for full license details, or visit:
+ * <https://www.gnu.org/licenses/old-licenses/lgpl-2.1.html>
+ */
+
+#include <functional>
+#include <vector>
+
+#include "../../../../include/lammp/inter_buffer.hpp"
+#include "../../../../include/lammp/lammp.hpp"
+#include "../../../../include/lammp/numeral_table.h"
+
+/*
+ * 高位在前的流式进制转换：x = q * P_k + r，P_k = base_num^(MIN_LEN * 2^k)，先输出 q 再输出 r。
+ * binary2base 自底向上合并，只有全部完成后才知道最高位；这里自顶向下做除法，每个叶子完成后即可输出，
+ * r 在 q 输出完之前保留，q、r 生成后立即释放 x，因此峰值内存约为数本身加上幂次表。
+ * 除最高一段外，每段都补零到恰好 MIN_LEN * 2^k 个 base_num 位
+ * 同一层的除数相同，P_k 的倒数只算一次，之后每次除法（Barrett）只需两次乘法
+ */
+namespace lammp::Arithmetic::Numeral {
+
+namespace {
+
+// P_k 及其倒数 inv = floor(2^(128 * len) / P_k)，同一层的除法共用
+struct _div_pow {
+    _internal_buffer<0> pow;
+    lamp_ui len;
+    _internal_buffer<0> inv;
+    lamp_ui inv_len;
+};
+
+class _str_emitter {
+    lamp_ui base_;
+    lamp_ui digits_;  // 每个 base_num 位对应的字符数
+    std::vector<_div_pow> pows_;
+    std::vector<char> chars_;
+    const std::function<bool(const char*, lamp_ui)>& sink_;
+
+    // x < P_0，输出 x 的全部字符，pad 时补零到 MIN_LEN * digits_ 个字符
+    bool _leaf(lamp_ptr x, lamp_ui len, bool pad) {
+        _internal_buffer<0> limbs(MIN_LEN + 1, 0);
+        const lamp_ui limbs_len = len == 0 ? 0 : binary2base(x, len, base_, limbs.data());
+        const lamp_ui out_limbs = pad ? MIN_LEN : std::max<lamp_ui>(limbs_len, 1);
+        chars_.resize(out_limbs * digits_);
+        char* p = chars_.data() + chars_.size();
+        for (lamp_ui i = 0; i < out_limbs; i++) {
+            p -= digits_;
+            base_num2str(i < limbs_len ? limbs.data()[i] : 0, base_, digits_, p, true);
+        }
+        if (!pad) {
+            // 去掉前导零，至少保留一个字符
+            while (p + 1 < chars_.data() + chars_.size() && *p == '0') {
+                p++;
+            }
+        }
+        return sink_(p, lamp_ui(chars_.data() + chars_.size() - p));
+    }
+
+    // q = x / P_k，r = x % P_k，要求 P_k <= x < P_k^2，x 不会被修改
+    // Barrett：q 的估计值取 x 的高位乘以 inv，再由余数向两个方向修正
+    void _divmod(lamp_ptr x, lamp_ui len, const _div_pow& d, _internal_buffer<0>& q, lamp_ui& q_len,
+                 _internal_buffer<0>& r, lamp_ui& r_len) {
+        const lamp_ui m = d.len, hi_len = len - (m - 1);
+        lamp_ptr pow = const_cast<lamp_ptr>(d.pow.data());
+        _internal_buffer<0> t(hi_len + d.inv_len, 0);
+        abs_mul64(x + m - 1, hi_len, const_cast<lamp_ptr>(d.inv.data()), d.inv_len, t.data());
+        const lamp_ui t_len = rlz(t.data(), hi_len + d.inv_len);
+        q_len = t_len > m + 1 ? t_len - (m + 1) : 0;
+        q = _internal_buffer<0>(q_len + 2, 0);
+        std::copy(t.data() + m + 1, t.data() + m + 1 + q_len, q.data());
+        t = _internal_buffer<0>();
+
+        _internal_buffer<0> prod(std::max(q_len + m, len) + 1, 0);
+        lamp_ui prod_len = 0;
+        if (q_len > 0) {
+            abs_mul64(q.data(), q_len, pow, m, prod.data());
+            prod_len = rlz(prod.data(), q_len + m);
+        }
+        while (abs_compare(prod.data(), prod_len, x, len) > 0) {
+            abs_sub_binary(prod.data(), prod_len, pow, m, prod.data());
+            prod_len = rlz(prod.data(), prod_len);
+            abs_sub_binary_num(q.data(), q_len, 1, q.data());
+            q_len = rlz(q.data(), q_len);
+        }
+        r = _internal_buffer<0>(len, 0);
+        abs_sub_binary(x, len, prod.data(), prod_len, r.data());
+        r_len = rlz(r.data(), len);
+        while (abs_compare(r.data(), r_len, pow, m) >= 0) {
+            abs_sub_binary(r.data(), r_len, pow, m, r.data());
+            r_len = rlz(r.data(), r_len);
+            const lamp_ui one = 1;
+            abs_add_binary(q.data(), q_len, const_cast<lamp_ptr>(&one), 1, q.data());
+            q_len = rlz(q.data(), q_len + 1);
+        }
+    }
+
+    // x < P_k
+    bool _below(lamp_ptr x, lamp_ui len, const _div_pow& d) {
+        return abs_compare(x, len, const_cast<lamp_ptr>(d.pow.data()), d.len) < 0;
+    }
+
+    // owner 持有 x 时，除法完成后释放；顶层的 x 为调用者的数据，owner 为空
+    bool _emit(lamp_ptr x, lamp_ui len, _internal_buffer<0>& owner, int k, bool pad) {
+        len = rlz(x, len);
+        if (k < 0) {
+            return _leaf(x, len, pad);
+        }
+        const _div_pow& d = pows_[k];
+        if (_below(x, len, d)) {
+            // q = 0：最高一段不补零，直接下降一层；否则高半部分全为零
+            if (!pad) {
+                return _emit(x, len, owner, k - 1, false);
+            }
+            lamp_ui zero = 0;
+            _internal_buffer<0> none;
+            return _emit(&zero, 0, none, k - 1, true) && _emit(x, len, owner, k - 1, true);
+        }
+        _internal_buffer<0> q, r;
+        lamp_ui q_len = 0, r_len = 0;
+        _divmod(x, len, d, q, q_len, r, r_len);
+        owner = _internal_buffer<0>();
+        return _emit(q.data(), q_len, q, k - 1, pad) && _emit(r.data(), r_len, r, k - 1, true);
+    }
+
+    void _push_pow(lamp_ptr p, lamp_ui len) {
+        _div_pow d{_internal_buffer<0>(len, 0), len, _internal_buffer<0>(len + 3, 0), 0};
+        std::copy(p, p + len, d.pow.data());
+        // inv = floor(2^(128 * len) / P_k)
+        _internal_buffer<0> num(len * 2 + 1, 0);
+        num.data()[len * 2] = 1;
+        abs_div64(num.data(), len * 2 + 1, p, len, d.inv.data());
+        d.inv_len = rlz(d.inv.data(), len + 3);
+        pows_.push_back(std::move(d));
+    }
+
+   public:
+    _str_emitter(lamp_ui base, const std::function<bool(const char*, lamp_ui)>& sink)
+        : base_(base), digits_(GET_BASE_LEN(base)), sink_(sink) {}
+
+    bool run(lamp_ptr in, lamp_ui len) {
+        len = rlz(in, len);
+        // P_0 = base_num^MIN_LEN，由 base2binary 从 base_num 进制下的 1 后跟 MIN_LEN 个 0 得到
+        _internal_buffer<0> one(MIN_LEN + 1, 0);
+        one.data()[MIN_LEN] = 1;
+        lamp_ui p_len = get_buffer_size(MIN_LEN + 1, 1.0 / GET_BASE_D(base_));
+        _internal_buffer<0> p(p_len + 1, 0);
+        p_len = base2binary(one.data(), MIN_LEN + 1, base_, p.data());
+        // x < P_K^2 时停止，P_K^2 >= 2^(128 * (len(P_K) - 1))
+        while (2 * (p_len - 1) < len) {
+            _push_pow(p.data(), p_len);
+            _internal_buffer<0> sqr(p_len * 2, 0);
+            abs_sqr64(p.data(), p_len, sqr.data());
+            p_len = rlz(sqr.data(), p_len * 2);
+            p = std::move(sqr);
+        }
+        _push_pow(p.data(), p_len);
+        p = _internal_buffer<0>();
+        _internal_buffer<0> owner;
+        return _emit(in, len, owner, int(pows_.size()) - 1, false);
+    }
+};
+
+};  // namespace
+
+bool binary2str(lamp_ptr in, lamp_ui len, lamp_ui base, const std::function<bool(const char*, lamp_ui)>& sink) {
+    assert(base >= 2 && base <= 36);
+    return _str_emitter(base, sink).run(in, len);
+}
+
+};  // namespace lammp::Arithmetic::Numeral
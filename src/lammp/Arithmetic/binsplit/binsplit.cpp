@@ -0,0 +1,339 @@
+/*
+ * Copyright (C) 2025 HJimmyK/LAMINA
+ *
+ * This file is part of LAMMP, which is licensed under the GNU LGPL v2.1.
+ * See the LICENSE file in the project root for full license details, or visit:
+ * <https://www.gnu.org/licenses/old-licenses/lgpl-2.1.html>
+ */
+
+#include <algorithm>
+#include <vector>
+
+#include "../../../../include/lammp/binsplit.hpp"
+#include "../../../../include/lammp/thread_pool.hpp"
+
+/*
+ * 二分求和（binary splitting）：区间 [l, r) 上
+ *   P(l, r) = prod p(k)，Q(l, r) = prod q(k)，B(l, r) = prod b(k)，
+ *   T(l, r) = B(l, r) Q(l, r) sum_{k=l}^{r-1} a(k) / b(k) * p(l)...p(k) / (q(l)...q(k))
+ * 以 m 为分点合并：P = P_l P_r，Q = Q_l Q_r，B = B_l B_r，T = B_r Q_r T_l + B_l P_l T_r
+ * 叶子 T(k, k + 1) = a(k) p(k)。分点按各项 p、q、b 位长的前缀和取中点，使两侧乘法规模相近；
+ * 规模足够大时两棵子树交给全局线程池，合并时互不依赖的乘法也并行计算
+ */
+namespace lammp::Arithmetic {
+
+namespace {
+
+// 区间的位长之和不小于该值时并行
+constexpr lamp_ui BINSPLIT_PARALLEL_MIN = 1 << 17;
+
+// 计算位长前缀和时每块的项数
+constexpr lamp_ui BINSPLIT_WEIGHT_CHUNK = 4096;
+
+void _term(const BinSplitTerm& f, lamp_ui k, BinSplitNum& out) {
+    out.buf = _internal_buffer<0>(BINSPLIT_TERM_LEN, 0);
+    out.neg = false;
+    out.len = f(k, out.buf.data(), out.neg);
+    assert(out.len <= BINSPLIT_TERM_LEN);
+    out.len = rlz(out.buf.data(), out.len);
+    out.neg = out.neg && out.len > 0;
+}
+
+void _set_one(BinSplitNum& out) {
+    out.buf = _internal_buffer<0>(1, 1);
+    out.len = 1;
+    out.neg = false;
+}
+
+// out = x * y，out 不可与 x、y 相同
+void _mul(BinSplitNum& x, BinSplitNum& y, BinSplitNum& out) {
+    if (x.len == 0 || y.len == 0) {
+        out.buf = _internal_buffer<0>(1, 0);
+        out.len = 0;
+        out.neg = false;
+        return;
+    }
+    out.buf = _internal_buffer<0>(x.len + y.len);
+    abs_mul64(x.buf.data(), x.len, y.buf.data(), y.len, out.buf.data());
+    out.len = rlz(out.buf.data(), x.len + y.len);
+    out.neg = x.neg != y.neg;
+}
+
+// out = x + y，out 不可与 x、y 相同
+void _add(BinSplitNum& x, BinSplitNum& y, BinSplitNum& out) {
+    const lamp_ui cap = std::max(x.len, y.len) + 1;
+    out.buf = _internal_buffer<0>(cap, 0);
+    if (x.len == 0 || y.len == 0) {
+        BinSplitNum& s = x.len == 0 ? y : x;
+        std::copy(s.buf.data(), s.buf.data() + s.len, out.buf.data());
+        out.len = s.len;
+        out.neg = s.neg;
+        return;
+    }
+    if (x.neg == y.neg) {
+        abs_add_binary(x.buf.data(), x.len, y.buf.data(), y.len, out.buf.data());
+        out.len = rlz(out.buf.data(), cap);
+        out.neg = x.neg;
+        return;
+    }
+    const lamp_si sign = abs_difference_binary(x.buf.data(), x.len, y.buf.data(), y.len, out.buf.data());
+    out.len = rlz(out.buf.data(), cap - 1);
+    out.neg = out.len > 0 && (sign > 0 ? x.neg : y.neg);
+}
+
+/*
+ * q = floor(num / den)，q 的长度至少为 num_len - den_len + 3，须清零
+ * den 远长于商时只取两者的高位相除（保留比商多两个字），得到的近似商与真值至多差 1，
+ * 再用一次不平衡乘法求出余数修正；直接相除的代价取决于 den 的规模，而不是商的规模
+ */
+lamp_ui _div_trunc(lamp_ptr num, lamp_ui num_len, lamp_ptr den, lamp_ui den_len, lamp_ptr q) {
+    if (abs_compare(num, num_len, den, den_len) < 0) {
+        return 0;
+    }
+    const lamp_ui q_cap = num_len - den_len + 1;
+    const lamp_ui keep = q_cap + 2;
+    if (den_len <= keep) {
+        abs_div64(num, num_len, den, den_len, q);
+        return rlz(q, q_cap + 1);
+    }
+    const lamp_ui drop = den_len - keep;
+    abs_div64(num + drop, num_len - drop, den + drop, keep, q);
+    lamp_ui q_len = rlz(q, q_cap + 1);
+    lamp_ui one = 1;
+
+    // 余数 r = num - q * den，q 偏大时先减
+    _internal_buffer<0> prod(q_cap + 1 + den_len, 0);
+    lamp_ui prod_len = 0;
+    if (q_len > 0) {
+        abs_mul64(q, q_len, den, den_len, prod.data());
+        prod_len = rlz(prod.data(), q_len + den_len);
+    }
+    while (abs_compare(prod.data(), prod_len, num, num_len) > 0) {
+        abs_sub_binary(q, q_len, &one, 1, q);
+        q_len = rlz(q, q_len);
+        abs_sub_binary(prod.data(), prod_len, den, den_len, prod.data());
+        prod_len = rlz(prod.data(), prod_len);
+    }
+    _internal_buffer<0> rem(num_len, 0);
+    abs_sub_binary(num, num_len, prod.data(), prod_len, rem.data());
+    lamp_ui rem_len = rlz(rem.data(), num_len);
+    while (abs_compare(rem.data(), rem_len, den, den_len) >= 0) {
+        abs_add_binary(q, q_len, &one, 1, q);
+        q_len = rlz(q, q_len + 1);
+        abs_sub_binary(rem.data(), rem_len, den, den_len, rem.data());
+        rem_len = rlz(rem.data(), rem_len);
+    }
+    return q_len;
+}
+
+struct _node {
+    BinSplitNum P, Q, B, T;
+};
+
+class _splitter {
+   private:
+    const BinSplitSeries& series_;
+    const bool has_b_;
+    std::vector<lamp_ui> weight_;  // 位长前缀和
+
+    void leaf(lamp_ui k, bool need_p, _node& out) const {
+        BinSplitNum a;
+        _term(series_.p, k, out.P);
+        _term(series_.q, k, out.Q);
+        _term(series_.a, k, a);
+        _mul(a, out.P, out.T);
+        if (has_b_) {
+            _term(series_.b, k, out.B);
+        }
+        if (!need_p) {
+            out.P = BinSplitNum();
+        }
+    }
+
+    void merge(_node& l, _node& r, bool need_p, bool parallel, _node& out) const {
+        ThreadPool& pool = ThreadPool::global();
+        auto run = [&](size_t count, const std::function<void(size_t)>& job) {
+            if (parallel) {
+                pool.parallelFor(count, job);
+            } else {
+                for (size_t i = 0; i < count; i++) {
+                    job(i);
+                }
+            }
+        };
+        BinSplitNum u, v;
+        if (!has_b_) {
+            // T = Q_r T_l + P_l T_r
+            run(4, [&](size_t i) {
+                switch (i) {
+                    case 0:
+                        _mul(l.Q, r.Q, out.Q);
+                        break;
+                    case 1:
+                        if (need_p) {
+                            _mul(l.P, r.P, out.P);
+                        }
+                        break;
+                    case 2:
+                        _mul(r.Q, l.T, u);
+                        break;
+                    default:
+                        _mul(l.P, r.T, v);
+                        break;
+                }
+            });
+        } else {
+            // T = (B_r Q_r) T_l + (B_l P_l) T_r
+            BinSplitNum x, y;
+            run(5, [&](size_t i) {
+                switch (i) {
+                    case 0:
+                        _mul(l.Q, r.Q, out.Q);
+                        break;
+                    case 1:
+                        if (need_p) {
+                            _mul(l.P, r.P, out.P);
+                        }
+                        break;
+                    case 2:
+                        _mul(l.B, r.B, out.B);
+                        break;
+                    case 3:
+                        _mul(r.B, r.Q, x);
+                        break;
+                    default:
+                        _mul(l.B, l.P, y);
+                        break;
+                }
+            });
+            run(2, [&](size_t i) {
+                if (i == 0) {
+                    _mul(x, l.T, u);
+                } else {
+                    _mul(y, r.T, v);
+                }
+            });
+        }
+        _add(u, v, out.T);
+    }
+
+   public:
+    _splitter(const BinSplitSeries& series, lamp_ui n) : series_(series), has_b_(bool(series.b)), weight_(n + 1, 0) {
+        // 各项 p、q、b 的位长，分块并行计算后求前缀和
+        const lamp_ui chunks = (n + BINSPLIT_WEIGHT_CHUNK - 1) / BINSPLIT_WEIGHT_CHUNK;
+        ThreadPool::global().parallelFor(chunks, [&](size_t c) {
+            const lamp_ui begin = c * BINSPLIT_WEIGHT_CHUNK, end = std::min(n, begin + BINSPLIT_WEIGHT_CHUNK);
+            for (lamp_ui k = begin; k < end; k++) {
+                BinSplitNum t;
+                lamp_ui w = 1;
+                _term(series_.p, k, t);
+                w += t.len == 0 ? 0 : bit_length(t.buf.data(), t.len);
+                _term(series_.q, k, t);
+                w += t.len == 0 ? 0 : bit_length(t.buf.data(), t.len);
+                if (has_b_) {
+                    _term(series_.b, k, t);
+                    w += t.len == 0 ? 0 : bit_length(t.buf.data(), t.len);
+                }
+                weight_[k + 1] = w;
+            }
+        });
+        for (lamp_ui k = 0; k < n; k++) {
+            weight_[k + 1] += weight_[k];
+        }
+    }
+
+    bool hasB() const { return has_b_; }
+
+    void split(lamp_ui lo, lamp_ui hi, bool need_p, _node& out, int depth) const {
+        if (hi - lo == 1) {
+            leaf(lo, need_p, out);
+            return;
+        }
+        // 取位长前缀和的中点为分点
+        const lamp_ui half = weight_[lo] + (weight_[hi] - weight_[lo]) / 2;
+        lamp_ui mid = std::upper_bound(weight_.begin() + lo + 1, weight_.begin() + hi, half) - weight_.begin();
+        mid = std::min(std::max(mid, lo + 1), hi - 1);
+        const bool parallel = depth > 0 && weight_[hi] - weight_[lo] >= BINSPLIT_PARALLEL_MIN;
+        _node l, r;
+        auto sub = [&](size_t i) {
+            if (i == 0) {
+                split(lo, mid, true, l, depth - 1);
+            } else {
+                split(mid, hi, need_p, r, depth - 1);
+            }
+        };
+        if (parallel) {
+            ThreadPool::global().parallelFor(2, sub);
+        } else {
+            sub(0);
+            sub(1);
+        }
+        merge(l, r, need_p, parallel, out);
+    }
+
+    void run(lamp_ui n, bool need_p, _node& out) const { split(0, n, need_p, out, ThreadPool::global().parallelDepth()); }
+};
+
+};  // namespace
+
+void binary_split(const BinSplitSeries& series,
+                  lamp_ui n,
+                  BinSplitNum* P,
+                  BinSplitNum& Q,
+                  BinSplitNum* B,
+                  BinSplitNum& T) {
+    assert(series.p && series.q && series.a);
+    if (n == 0) {
+        // 空和：S = 0
+        if (P != nullptr) {
+            _set_one(*P);
+        }
+        if (B != nullptr) {
+            _set_one(*B);
+        }
+        _set_one(Q);
+        T = BinSplitNum();
+        T.buf = _internal_buffer<0>(1, 0);
+        return;
+    }
+    const _splitter splitter(series, n);
+    _node out;
+    splitter.run(n, P != nullptr, out);
+    if (P != nullptr) {
+        *P = std::move(out.P);
+    }
+    if (B != nullptr) {
+        if (splitter.hasB()) {
+            *B = std::move(out.B);
+        } else {
+            _set_one(*B);
+        }
+    }
+    Q = std::move(out.Q);
+    T = std::move(out.T);
+}
+
+void binary_split_fixed(const BinSplitSeries& series, lamp_ui n, lamp_ui frac_bits, BinSplitNum& out) {
+    BinSplitNum Q, B, T;
+    binary_split(series, n, nullptr, Q, &B, T);
+    assert(Q.len > 0 && B.len > 0);
+    BinSplitNum den;
+    _mul(B, Q, den);
+    out.neg = T.neg;
+    if (T.len == 0) {
+        out.buf = _internal_buffer<0>(1, 0);
+        out.len = 0;
+        out.neg = false;
+        return;
+    }
+    // |T| * 2^frac_bits / (B * Q)
+    const lamp_ui num_len = T.len + frac_bits / 64 + 1;
+    _internal_buffer<0> num(num_len, 0);
+    lshift_bits(T.buf.data(), T.len, num.data(), frac_bits);
+    const lamp_ui num_rlz = rlz(num.data(), num_len);
+    out.buf = _internal_buffer<0>(num_rlz + 3, 0);
+    out.len = _div_trunc(num.data(), num_rlz, den.buf.data(), den.len, out.buf.data());
+    out.neg = out.neg && out.len > 0;
+}
+
+};  // namespace lammp::Arithmetic
@@ -136,44 +136,56 @@ void abs_div_knuth(lamp_ptr in,
         return;
     }
 
-    lamp_ui out_len = get_div_len(len, divisor_len);
-    lamp_ui _dividend_len = len + 1;  // 由于kunth除法一定高估，所以需要多分配一个元素
-    _internal_buffer<0> _dividend(_dividend_len, 0);
-
-    for (lamp_ui i = out_len - 1; i-- != 0;) {
-        if (len < divisor_len) {
-            break;
+    // Knuth 算法 D：每一位商由当前窗口最高两字除以除数最高字估计，再用除数次高字修正，
+    // 修正后至多偏大 1，乘减出现借位时加回一次。窗口位置固定，不依赖余数的实际长度
+    const lamp_ui n = divisor_len, m = len - divisor_len;
+    const lamp_ui d1 = divisor[n - 1], d0 = divisor[n - 2];
+    // 最高位商：除数已规格化，in 的高 n 字小于 2 * divisor，商只能为 0 或 1
+    out[m] = 0;
+    if (abs_compare(in + m, n, divisor, n) >= 0) {
+        abs_sub_binary(in + m, n, divisor, n, in + m);
+        out[m] = 1;
+    }
+    for (lamp_ui j = m; j-- > 0;) {
+        const lamp_ui u2 = in[j + n], u1 = in[j + n - 1], u0 = in[j + n - 2];
+        lamp_ui q_hat, r_hat = u1, lo, hi;
+        bool r_overflow = false;
+        if (u2 >= d1) {
+            // 窗口小于 divisor * 2^64，此时 u2 == d1，商取 2^64 - 1
+            q_hat = LAMP_UI_MAX;
+            r_hat = add_half(u1, d1, r_overflow);
+        } else {
+            q_hat = div128by64to64(u2, r_hat, d1);
         }
-        _uint128 _dividend_i(in[len - 2], in[len - 1]);
-
-        _dividend_i.self_div_rem(divisor[divisor_len - 1]);
-
-        lamp_ui q_hat[2] = {_dividend_i.low64(), _dividend_i.high64()};
-        lamp_ui q_hat_len = rlz(q_hat, 2);
-
-        abs_mul64_classic(q_hat, q_hat_len, divisor, divisor_len, _dividend.data() + i, nullptr, nullptr);
-        _dividend_len = rlz(_dividend.data(), i + get_mul_len(divisor_len, q_hat_len));
-        lamp_si sign = abs_compare(_dividend.data(), _dividend_len, in, len);
-        if (sign > 0) {
-            _dividend_i -= 1;
-            lamp_si sub_flag =
-                abs_sub_binary(_dividend.data() + i, _dividend_len - i, divisor, divisor_len, _dividend.data() + i);
-            assert(sub_flag == 0);
-            _dividend_len = rlz(_dividend.data(), _dividend_len);
-            sign = abs_compare(_dividend.data(), _dividend_len, in, len);
-            if (sign > 0) {
-                sub_flag =
-                    abs_sub_binary(_dividend.data() + i, _dividend_len - i, divisor, divisor_len, _dividend.data() + i);
-                assert(sub_flag == 0);
+        while (!r_overflow) {
+            mul64x64to128(q_hat, d0, lo, hi);
+            if (hi < r_hat || (hi == r_hat && lo <= u0)) {
+                break;
+            }
+            q_hat--;
+            r_hat = add_half(r_hat, d1, r_overflow);
+        }
+        // in[j, j + n] -= q_hat * divisor
+        lamp_ui carry = 0;
+        bool cf, bf = false;
+        for (lamp_ui k = 0; k < n; k++) {
+            mul64x64to128(divisor[k], q_hat, lo, hi);
+            lo = add_half(lo, carry, cf);
+            carry = hi + cf;
+            in[j + k] = sub_borrow(in[j + k], lo, bf);
+        }
+        in[j + n] = sub_borrow(in[j + n], carry, bf);
+        if (bf) {
+            q_hat--;
+            cf = false;
+            for (lamp_ui k = 0; k < n; k++) {
+                in[j + k] = add_carry(in[j + k], divisor[k], cf);
             }
+            in[j + n] += lamp_ui(cf);
         }
-        lamp_si sus_flag = abs_sub_binary(in + i, len - i, _dividend.data() + i, _dividend_len - i, in + i);
-        assert(sus_flag == 0);
-        out[i + 1] = (_dividend_i.high64() == 0) ? out[i + 1] : _dividend_i.high64();
-        out[i] = _dividend_i.low64();
-        len = rlz(in, len);
-        std::fill(_dividend.data() + i, _dividend.data() + _dividend_len, 0);
+        out[j] = q_hat;
     }
+    len = rlz(in, n);
     if (remainder != nullptr) {
         std::copy(in, in + len, remainder);
     }
@@ -28,12 +28,54 @@ void abs_div64(lamp_ptr in1, lamp_ui len1, lamp_ptr in2, lamp_ui len2, lamp_ptr
     _internal_buffer<0> _in1_shifted(len1 + 2);
     _in1_shifted.set(len1 + 1, 0);
     _in1_shifted.set(len1, 0);
-    _internal_buffer<0> _in2_shifted(len2);
+    _internal_buffer<0> _in2_shifted(len2 + 1);
     lshift_in_word(in1, len1, _in1_shifted.data(), shift);
     lshift_in_word(in2, len2, _in2_shifted.data(), shift);
     lamp_ui len1_shifted = rlz(_in1_shifted.data(), len1 + 2);
 
-    abs_div_knuth(_in1_shifted.data(), len1_shifted, _in2_shifted.data(), len2, qr, nullptr);
+    if (len2 >= DIV_RECURSIVE_THRESHOLD && len1_shifted - len2 >= DIV_RECURSIVE_THRESHOLD) {
+        abs_div_recursive(_in1_shifted.data(), len1_shifted, _in2_shifted.data(), len2, qr, nullptr);
+    } else {
+        abs_div_knuth(_in1_shifted.data(), len1_shifted, _in2_shifted.data(), len2, qr, nullptr);
+    }
+}
+
+/*
+ * @brief 计算 in1 % in2
+ * @param rem 余数的输出数组，长度至少为 len2
+ * @return 余数的长度
+ * @note 该函数不会修改 in1 和 in2 的内容
+ */
+lamp_ui abs_mod64(lamp_ptr in1, lamp_ui len1, lamp_ptr in2, lamp_ui len2, lamp_ptr rem) {
+    assert(in1 != nullptr && in2 != nullptr && rem != nullptr);
+    len1 = rlz(in1, len1);
+    len2 = rlz(in2, len2);
+    assert(len2 > 0);
+    if (abs_compare(in1, len1, in2, len2) < 0) {
+        std::copy(in1, in1 + len1, rem);
+        return len1;
+    }
+    if (len2 == 1) {
+        _internal_buffer<0> _quot(len1);
+        rem[0] = abs_div_rem_num64(in1, len1, _quot.data(), in2[0]);
+        return rlz(rem, 1);
+    }
+    const int shift = lammp::lammp_clz(in2[len2 - 1]);
+    _internal_buffer<0> _in1_shifted(len1 + 2, 0);
+    _internal_buffer<0> _in2_shifted(len2 + 1, 0);
+    lshift_in_word(in1, len1, _in1_shifted.data(), shift);
+    lshift_in_word(in2, len2, _in2_shifted.data(), shift);
+    lamp_ui len1_shifted = rlz(_in1_shifted.data(), len1 + 2);
+
+    _internal_buffer<0> _quot(get_div_len(len1_shifted, len2) + 1, 0);
+    _internal_buffer<0> _rem(len2 + 1, 0);
+    if (len2 >= DIV_RECURSIVE_THRESHOLD && len1_shifted - len2 >= DIV_RECURSIVE_THRESHOLD) {
+        abs_div_recursive(_in1_shifted.data(), len1_shifted, _in2_shifted.data(), len2, _quot.data(), _rem.data());
+    } else {
+        abs_div_knuth(_in1_shifted.data(), len1_shifted, _in2_shifted.data(), len2, _quot.data(), _rem.data());
+    }
+    rshift_in_word(_rem.data(), len2, rem, shift);
+    return rlz(rem, len2);
 }
 
 }; // namespace lammp::Arithmetic
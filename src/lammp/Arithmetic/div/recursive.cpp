@@ -0,0 +1,141 @@
+/*
+ * Copyright (C) 2025 HJimmyK/LAMINA
+ *
+ * This file is part of LAMMP, which is licensed under the GNU LGPL v2.1.
+ * See the LICENSE file in the project root for full license details, or visit:
+ * <https://www.gnu.org/licenses/old-licenses/lgpl-2.1.html>
+ */
+
+#include "../../../../include/lammp/inter_buffer.hpp"
+#include "../../../../include/lammp/lammp.hpp"
+
+/*
+ * 分治除法（Brent & Zimmermann, Modern Computer Arithmetic, Algorithm 1.8 RecursiveDivRem）：
+ * 被除数 A 占 n + m 字，除数 B 占 n 字且已规格化，m <= n。取 k = m / 2，B = B1 * β^k + B0，
+ *   (Q1, R1) = A div β^2k ÷ B1
+ *   A' = R1 * β^2k + A mod β^2k - Q1 * B0 * β^k，A' < 0 时 Q1 -= 1，A' += B * β^k
+ *   (Q0, R0) = A' div β^k ÷ B1
+ *   A'' = R0 * β^k + A' mod β^k - Q0 * B0，A'' < 0 时 Q0 -= 1，A'' += B
+ * 修正至多两次。商的代价为 O(M(n) log n)，小规模回退到 abs_div_knuth
+ */
+namespace lammp::Arithmetic {
+
+namespace {
+
+/*
+ * a 占 n + m 字，a < 2 * β^m * b，q 输出 m + 1 字，r 输出 n 字
+ */
+void _div_rec(const lamp_ptr a, lamp_ui m, const lamp_ptr b, lamp_ui n, lamp_ptr q, lamp_ptr r) {
+    if (m == 0) {
+        // a < 2 * b，商只能为 0 或 1
+        q[0] = abs_compare(a, n, b, n) >= 0;
+        if (q[0] != 0) {
+            abs_sub_binary(a, n, b, n, r);
+        } else {
+            std::copy(a, a + n, r);
+        }
+        return;
+    }
+    if (m < DIV_RECURSIVE_THRESHOLD || n < DIV_RECURSIVE_THRESHOLD) {
+        _internal_buffer<0> _a(n + m + 1, 0);
+        std::copy(a, a + n + m, _a.data());
+        std::fill(q, q + m + 1, 0);
+        abs_div_knuth(_a.data(), n + m, b, n, q, nullptr);
+        std::copy(_a.data(), _a.data() + n, r);
+        return;
+    }
+    const lamp_ui k = m / 2, m1 = m - k;
+    const lamp_ptr b1 = b + k;
+
+    // (Q1, R1) = (a div β^2k) ÷ B1，Q1 写入 q 的高 m1 + 1 字
+    _internal_buffer<0> _r1(n - k);
+    _internal_buffer<0> _q1(m1 + 1);
+    _div_rec(a + 2 * k, m1, b1, n - k, _q1.data(), _r1.data());
+
+    // T = R1 * β^2k + a mod β^2k，P = Q1 * B0 * β^k
+    const lamp_ui t_cap = n + k + 2;
+    _internal_buffer<0> _t(t_cap, 0);
+    _internal_buffer<0> _p(t_cap, 0);
+    lamp_ptr t = _t.data(), p = _p.data();
+    std::copy(a, a + 2 * k, t);
+    std::copy(_r1.data(), _r1.data() + n - k, t + 2 * k);
+    lamp_ui q1_len = rlz(_q1.data(), m1 + 1);
+    if (q1_len > 0) {
+        abs_mul64(_q1.data(), q1_len, b, k, p + k);
+    }
+    while (abs_compare(p, t_cap, t, t_cap) > 0) {
+        abs_add_binary_half(t + k, t_cap - k, b, n, t + k);
+        abs_sub_binary_num(_q1.data(), m1 + 1, 1, _q1.data());
+    }
+    abs_sub_binary(t, t_cap, p, t_cap, t);
+
+    // (Q0, R0) = (A' div β^k) ÷ B1，A' 此时小于 B * β^k，占 n + k 字
+    _internal_buffer<0> _r0(n - k);
+    _internal_buffer<0> _q0(k + 1);
+    _div_rec(t + k, k, b1, n - k, _q0.data(), _r0.data());
+
+    // T2 = R0 * β^k + A' mod β^k，P2 = Q0 * B0
+    const lamp_ui t2_cap = n + 2;
+    std::fill(p, p + t2_cap, 0);
+    std::copy(_r0.data(), _r0.data() + n - k, t + k);
+    std::fill(t + n, t + t2_cap, 0);
+    const lamp_ui q0_len = rlz(_q0.data(), k + 1);
+    if (q0_len > 0) {
+        abs_mul64(_q0.data(), q0_len, b, k, p);
+    }
+    while (abs_compare(p, t2_cap, t, t2_cap) > 0) {
+        abs_add_binary_half(t, t2_cap, b, n, t);
+        abs_sub_binary_num(_q0.data(), k + 1, 1, _q0.data());
+    }
+    abs_sub_binary(t, t2_cap, p, t2_cap, t);
+    std::copy(t, t + n, r);
+
+    // q = Q1 * β^k + Q0，Q0 至多 k + 1 字
+    std::fill(q, q + m + 1, 0);
+    std::copy(_q1.data(), _q1.data() + m1 + 1, q + k);
+    abs_add_binary_half(q, m + 1, _q0.data(), k + 1, q);
+}
+
+};  // namespace
+
+/*
+ * @brief 分治除法，in 不会被修改
+ * @param in 被除数，长度为 len
+ * @param divisor 除数，长度为 divisor_len，最高字的最高位必须为 1
+ * @param out 商的输出数组，长度为 len - divisor_len + 1
+ * @param remainder 余数的输出数组，长度为 divisor_len，可以为 nullptr
+ * @note 商长于除数时按除数长度分块，每块做一次平衡的分治除法
+ */
+void abs_div_recursive(lamp_ptr in,
+                       lamp_ui len,
+                       lamp_ptr divisor,
+                       lamp_ui divisor_len,
+                       lamp_ptr out,
+                       lamp_ptr remainder) {
+    assert(in != nullptr && divisor != nullptr && out != nullptr);
+    assert(divisor_len > 0 && divisor_len <= len);
+    assert(divisor[divisor_len - 1] >= (1ull << 63));
+    const lamp_ui n = divisor_len, m = len - divisor_len;
+    std::fill(out, out + m + 1, 0);
+
+    // 第一块的商取 m mod n 字（整除时取 n 字），其后每块 n 字
+    lamp_ui m0 = m % n == 0 ? std::min(m, n) : m % n;
+    lamp_ui pos = m - m0;
+    _internal_buffer<0> _w(2 * n + 1, 0);
+    _internal_buffer<0> _q(n + 1, 0);
+    lamp_ptr w = _w.data(), q = _q.data();
+    _div_rec(in + pos, m0, divisor, n, q, w + n);
+    std::copy(q, q + m0 + 1, out + pos);
+    while (pos > 0) {
+        // w = R * β^n + 下一段 n 字，R < divisor，商恰好 n 字
+        pos -= n;
+        std::copy(in + pos, in + pos + n, w);
+        _div_rec(w, n, divisor, n, q, w + n);
+        std::copy(q, q + n, out + pos);
+    }
+    if (remainder != nullptr) {
+        std::copy(w + n, w + 2 * n, remainder);
+    }
+}
+
+};  // namespace lammp::Arithmetic
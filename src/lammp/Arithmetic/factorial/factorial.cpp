@@ -0,0 +1,183 @@
+/*
+ * Copyright (C) 2025 HJimmyK/LAMINA
+ *
+ * This file is part of LAMMP, which is licensed under the GNU LGPL v2.1.
+ * See the LICENSE file in the project root for full license details, or visit:
+ * <https://www.gnu.org/licenses/old-licenses/lgpl-2.1.html>
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "../../../../include/lammp/inter_buffer.hpp"
+#include "../../../../include/lammp/lammp.hpp"
+#include "../../../../include/lammp/thread_pool.hpp"
+
+/*
+ * 素数摆动阶乘（Luschny）：n! = 2^(n - popcount(n)) * oddfact(n)，
+ *   oddfact(n) = oddfact(n / 2)^2 * oddswing(n)
+ * swing(n) = n! / ((n / 2)!)^2，素数 p 在其中的指数为 sum floor(n / p^k) mod 2，且 p^e <= n，
+ * 因此 oddswing(n) 是一列不超过 n 的单字因子之积。因子先打包成尽量满的字，
+ * 再用平衡乘积树相乘，两侧长度相近，大规模时正好落在 NTT 乘法上。
+ * 递归中的 oddfact(n / 2)^2 走平方路径；oddfact(n / 2) 与 oddswing(n) 互不依赖，
+ * 乘积树的两棵子树也互不依赖，规模足够大时交给全局线程池
+ */
+namespace lammp::Arithmetic {
+
+namespace {
+
+// 乘积树叶子的因子个数，不超过该值时逐个乘单字因子
+constexpr lamp_ui PRODUCT_LEAF_SIZE = 32;
+
+// 子任务至少有这么多个字时才交给线程池
+constexpr lamp_ui FACTORIAL_PARALLEL_MIN = 2048;
+
+// 0! 到 20! 的奇数部分，20! < 2^64
+constexpr lamp_ui SMALL_FACTORIAL_MAX = 20;
+
+/*
+ * 单字因子 f[0, count) 之积写入 out（至少 count 个字），返回长度
+ * @param depth 还可以交给线程池的层数
+ */
+lamp_ui _product(const lamp_ui* f, lamp_ui count, lamp_ptr out, int depth) {
+    if (count <= PRODUCT_LEAF_SIZE) {
+        std::fill(out, out + count, 0);
+        out[0] = f[0];
+        lamp_ui len = 1;
+        for (lamp_ui i = 1; i < count; i++) {
+            abs_mul_add_num64(out, len, out, 0, f[i]);
+            len = rlz(out, len + 1);
+        }
+        return len;
+    }
+    const lamp_ui h = count / 2;
+    _internal_buffer<0> _l(h), _r(count - h);
+    lamp_ui l_len = 0, r_len = 0;
+    auto sub = [&](size_t i) {
+        if (i == 0) {
+            l_len = _product(f, h, _l.data(), depth - 1);
+        } else {
+            r_len = _product(f + h, count - h, _r.data(), depth - 1);
+        }
+    };
+    if (depth > 0 && count >= FACTORIAL_PARALLEL_MIN) {
+        ThreadPool::global().parallelFor(2, sub);
+    } else {
+        sub(0);
+        sub(1);
+    }
+    abs_mul64(_l.data(), l_len, _r.data(), r_len, out);
+    return rlz(out, l_len + r_len);
+}
+
+// oddswing(n) 的因子 p^e（p 为奇素数），按字打包后写入 f
+void _odd_swing_factors(lamp_ui n, const std::vector<lamp_ui>& primes, std::vector<lamp_ui>& f) {
+    f.clear();
+    lamp_ui word = 1;
+    for (lamp_ui p : primes) {
+        if (p > n) {
+            break;
+        }
+        lamp_ui pe = 1;
+        for (lamp_ui q = n / p; q > 0; q /= p) {
+            if (q & 1) {
+                pe *= p;
+            }
+        }
+        if (pe == 1) {
+            continue;
+        }
+        lamp_ui lo, hi;
+        mul64x64to128(word, pe, lo, hi);
+        if (hi != 0) {
+            f.push_back(word);
+            word = pe;
+        } else {
+            word = lo;
+        }
+    }
+    f.push_back(word);
+}
+
+// oddfact(n) 写入 out，返回长度
+lamp_ui _odd_factorial(lamp_ui n, const std::vector<lamp_ui>& primes, _internal_buffer<0>& out, int depth) {
+    if (n <= SMALL_FACTORIAL_MAX) {
+        lamp_ui r = 1;
+        for (lamp_ui i = 2; i <= n; i++) {
+            r *= i;
+        }
+        out = _internal_buffer<0>(1, r >> lammp_ctz(r));
+        return 1;
+    }
+    _internal_buffer<0> half, swing;
+    lamp_ui half_len = 0, swing_len = 0;
+    auto sub = [&](size_t i) {
+        if (i == 0) {
+            half_len = _odd_factorial(n / 2, primes, half, depth - 1);
+        } else {
+            std::vector<lamp_ui> f;
+            _odd_swing_factors(n, primes, f);
+            swing = _internal_buffer<0>(f.size());
+            swing_len = _product(f.data(), f.size(), swing.data(), depth);
+        }
+    };
+    // oddswing(n) 约 n 位，以此估计子任务的规模
+    if (depth > 0 && n / 64 >= FACTORIAL_PARALLEL_MIN) {
+        ThreadPool::global().parallelFor(2, sub);
+    } else {
+        sub(0);
+        sub(1);
+    }
+    _internal_buffer<0> sq(2 * half_len);
+    abs_sqr64(half.data(), half_len, sq.data());
+    const lamp_ui sq_len = rlz(sq.data(), 2 * half_len);
+    out = _internal_buffer<0>(sq_len + swing_len);
+    abs_mul64(sq.data(), sq_len, swing.data(), swing_len, out.data());
+    return rlz(out.data(), sq_len + swing_len);
+}
+
+};  // namespace
+
+/*
+ * @brief n! 的字长上界，由 log2(n!) = lgamma(n + 1) / ln 2 估计
+ */
+lamp_ui get_factorial_len(lamp_ui n) {
+    const double bits = std::lgamma(double(n) + 1.0) / std::log(2.0);
+    return lamp_ui(bits * (1 + 1e-12) / 64) + 2;
+}
+
+/*
+ * @brief 计算 n!（素数摆动算法）
+ * @param out 输出数组，长度至少为 get_factorial_len(n)
+ * @return 结果的长度
+ */
+lamp_ui abs_factorial64(lamp_ui n, lamp_ptr out) {
+    assert(out != nullptr);
+    const lamp_ui out_len = get_factorial_len(n);
+    std::fill(out, out + out_len, 0);
+    // 奇素数筛，只保留奇数
+    std::vector<lamp_ui> primes;
+    if (n >= 3) {
+        std::vector<bool> composite(n / 2 + 1, false);
+        for (lamp_ui i = 1; 2 * i + 1 <= n; i++) {
+            if (composite[i]) {
+                continue;
+            }
+            const lamp_ui p = 2 * i + 1;
+            primes.push_back(p);
+            for (lamp_ui j = p * p / 2; 2 * j + 1 <= n; j += p) {
+                composite[j] = true;
+            }
+        }
+    }
+    _internal_buffer<0> odd;
+    const lamp_ui odd_len = _odd_factorial(n, primes, odd, ThreadPool::global().parallelDepth());
+    // n! 中 2 的指数为 n - popcount(n)
+    const lamp_ui shift = n - lamp_ui(lammp_cnt(n));
+    const lamp_ui word_shift = shift / 64;
+    lshift_in_word(odd.data(), odd_len, out + word_shift, int(shift % 64));
+    return rlz(out, std::min(out_len, odd_len + word_shift + 1));
+}
+
+};  // namespace lammp::Arithmetic
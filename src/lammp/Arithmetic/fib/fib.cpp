@@ -0,0 +1,143 @@
+/*
+ * Copyright (C) 2025 HJimmyK/LAMINA
+ *
+ * This file is part of LAMMP, which is licensed under the GNU LGPL v2.1.
+ * See the LICENSE file in the project root for full license details, or visit:
+ * <https://www.gnu.org/licenses/old-licenses/lgpl-2.1.html>
+ */
+
+#include <algorithm>
+
+#include "../../../../include/lammp/inter_buffer.hpp"
+#include "../../../../include/lammp/lammp.hpp"
+#include "../../../../include/lammp/thread_pool.hpp"
+
+/*
+ * 倍增法求 Fibonacci 数，每步只做两次平方：由 (F(k), F(k-1)) 得
+ *   F(2k+1) = 4F(k)^2 - F(k-1)^2 + 2(-1)^k
+ *   F(2k-1) = F(k)^2 + F(k-1)^2
+ *   F(2k)   = F(2k+1) - F(2k-1)
+ * 按 n 的二进制位从高到低推进，位为 1 时取 (F(2k+1), F(2k))，否则取 (F(2k), F(2k-1))。
+ * 两次平方互不依赖，规模足够大时交给全局线程池
+ */
+namespace lammp::Arithmetic {
+
+namespace {
+
+// 两次平方至少有这么多个字时才并行
+constexpr lamp_ui FIB_PARALLEL_MIN = 4096;
+
+};  // namespace
+
+/*
+ * @brief F(n) 的字长上界，F(n) < φ^n，log2(φ) < 0.6943
+ */
+lamp_ui get_fib_len(lamp_ui n) { return lamp_ui(double(n) * 0.6943 / 64) + 2; }
+
+/*
+ * @brief 计算 out = F(n)，out_prev = F(n - 1)（F(-1) = 1）
+ * @param out 输出数组，长度至少为 get_fib_len(n)
+ * @param out_prev 输出数组，长度至少为 get_fib_len(n)，可以为 nullptr
+ * @param prev_len F(n - 1) 的长度，可以为 nullptr
+ * @return F(n) 的长度
+ */
+lamp_ui abs_fib64(lamp_ui n, lamp_ptr out, lamp_ptr out_prev, lamp_ui* prev_len) {
+    assert(out != nullptr);
+    const lamp_ui cap = get_fib_len(n);
+    std::fill(out, out + cap, 0);
+    if (out_prev != nullptr) {
+        std::fill(out_prev, out_prev + cap, 0);
+    }
+    if (n == 0) {
+        if (out_prev != nullptr) {
+            out_prev[0] = 1;
+        }
+        if (prev_len != nullptr) {
+            *prev_len = 1;
+        }
+        return 0;
+    }
+    // 平方与 4F(k)^2 最多 2 * cap + 1 个字；各缓冲区只读写有效长度以内的部分，不需要清零
+    const lamp_ui buf_len = 2 * cap + 2;
+    _internal_buffer<0> f(buf_len), g(buf_len), a(buf_len), b(buf_len), t(buf_len);
+    // k = 1：F(1) = 1，F(0) = 0
+    f.set(0, 1);
+    lamp_ui f_len = 1, g_len = 0, k = 1;
+    ThreadPool& pool = ThreadPool::global();
+    for (int bit = lammp_bit_length(n) - 2; bit >= 0; bit--) {
+        lamp_ui a_len = 0, b_len = 0;
+        auto square = [&](size_t i) {
+            if (i == 0) {
+                abs_sqr64(f.data(), f_len, a.data());
+                a_len = rlz(a.data(), 2 * f_len);
+            } else if (g_len > 0) {
+                abs_sqr64(g.data(), g_len, b.data());
+                b_len = rlz(b.data(), 2 * g_len);
+            }
+        };
+        if (f_len >= FIB_PARALLEL_MIN) {
+            pool.parallelFor(2, square);
+        } else {
+            square(0);
+            square(1);
+        }
+        // t = F(2k+1) = 4a - b ± 2
+        lshift_in_word(a.data(), a_len, t.data(), 2);
+        lamp_ui t_len = rlz(t.data(), a_len + 1);
+        abs_sub_binary(t.data(), t_len, b.data(), b_len, t.data());
+        t_len = rlz(t.data(), t_len);
+        if (k % 2 == 0) {
+            abs_mul_add_num64(t.data(), t_len, t.data(), 2, 1);
+            t_len = rlz(t.data(), t_len + 1);
+        } else {
+            abs_sub_binary_num(t.data(), t_len, 2, t.data());
+            t_len = rlz(t.data(), t_len);
+        }
+        // a = F(2k-1) = a + b，b = F(2k) = t - a
+        abs_add_binary(a.data(), a_len, b.data(), b_len, a.data());
+        a_len = rlz(a.data(), std::max(a_len, b_len) + 1);
+        abs_sub_binary(t.data(), t_len, a.data(), a_len, b.data());
+        b_len = rlz(b.data(), t_len);
+        if ((n >> bit) & 1) {
+            std::swap(f, t);
+            std::swap(g, b);
+            f_len = t_len;
+            g_len = b_len;
+            k = 2 * k + 1;
+        } else {
+            std::swap(f, b);
+            std::swap(g, a);
+            f_len = b_len;
+            g_len = a_len;
+            k = 2 * k;
+        }
+    }
+    std::copy(f.data(), f.data() + f_len, out);
+    if (out_prev != nullptr) {
+        std::copy(g.data(), g.data() + g_len, out_prev);
+    }
+    if (prev_len != nullptr) {
+        *prev_len = g_len;
+    }
+    return f_len;
+}
+
+/*
+ * @brief 计算 out = L(n) = F(n) + 2F(n - 1)
+ * @param out 输出数组，长度至少为 get_fib_len(n) + 1
+ * @return L(n) 的长度
+ */
+lamp_ui abs_lucnum64(lamp_ui n, lamp_ptr out) {
+    assert(out != nullptr);
+    const lamp_ui cap = get_fib_len(n);
+    _internal_buffer<0> fn(cap, 0), fn_1(cap + 1, 0);
+    lamp_ui fn_1_len = 0;
+    const lamp_ui fn_len = abs_fib64(n, fn.data(), fn_1.data(), &fn_1_len);
+    std::fill(out, out + cap + 1, 0);
+    lshift_in_word(fn_1.data(), fn_1_len, fn_1.data(), 1);
+    fn_1_len = rlz(fn_1.data(), fn_1_len + 1);
+    abs_add_binary(fn.data(), fn_len, fn_1.data(), fn_1_len, out);
+    return rlz(out, std::max(fn_len, fn_1_len) + 1);
+}
+
+};  // namespace lammp::Arithmetic
@@ -0,0 +1,626 @@
+/*
+ * Copyright (C) 2025 HJimmyK/LAMINA
+ *
+ * This file is part of LAMMP, which is licensed under the GNU LGPL v2.1.
+ * See the LICENSE file in the project root for full license details, or visit:
+ * <https://www.gnu.org/licenses/old-licenses/lgpl-2.1.html>
+ */
+
+#include "../../../../include/lammp/inter_buffer.hpp"
+#include "../../../../include/lammp/lammp.hpp"
+#include "../../../../include/lammp/uint128.hpp"
+
+/*
+ * 约化过程中始终保持 (a0; b0) = M * (a; b)，其中 (a0, b0) 为原始输入，
+ * M 为非负整数矩阵且行列式为 1。每一步都是“较大者减去较小者的若干倍”：
+ *   a -= q * b 对应 M 右乘 [[1, q], [0, 1]]，b -= q * a 对应 M 右乘 [[1, 0], [q, 1]]
+ * 小规模时用 Lehmer 双字步（由高 128 位得到单字矩阵，一次作用于完整数），
+ * 大规模时用半 GCD：对高半部分递归求矩阵，再用 abs_mul64 把矩阵作用到完整数上
+ */
+namespace lammp::Arithmetic {
+
+namespace {
+
+// 自然数，len 不含前导零（零的长度为 0），扩容时保留原值
+class _gcd_nat {
+   private:
+    _internal_buffer<0> buf_;
+
+   public:
+    lamp_ui len = 0;
+
+    lamp_ptr data() { return buf_.data(); }
+    bool isZero() const { return len == 0; }
+    void reserve(lamp_ui n) {
+        if (buf_.capacity() < n) {
+            _internal_buffer<0> tmp(n + n / 8 + 4);
+            std::copy(buf_.data(), buf_.data() + len, tmp.data());
+            buf_ = std::move(tmp);
+        }
+    }
+    void assign(lamp_ptr in, lamp_ui n) {
+        n = rlz(in, n);
+        reserve(n);
+        std::copy(in, in + n, data());
+        len = n;
+    }
+    void setWord(lamp_ui w) {
+        reserve(1);
+        data()[0] = w;
+        len = w != 0;
+    }
+    void normalize() { len = rlz(data(), len); }
+    void swap(_gcd_nat& other) {
+        std::swap(buf_, other.buf_);
+        std::swap(len, other.len);
+    }
+};
+
+int _cmp(_gcd_nat& a, _gcd_nat& b) { return abs_compare(a.data(), a.len, b.data(), b.len); }
+
+// out = x * y，out 不可与 x、y 相同
+void _mul(_gcd_nat& x, _gcd_nat& y, _gcd_nat& out) {
+    if (x.isZero() || y.isZero()) {
+        out.len = 0;
+        return;
+    }
+    out.reserve(x.len + y.len);
+    abs_mul64(x.data(), x.len, y.data(), y.len, out.data());
+    out.len = x.len + y.len;
+    out.normalize();
+}
+
+// x += y
+void _add(_gcd_nat& x, _gcd_nat& y) {
+    const lamp_ui n = std::max(x.len, y.len);
+    x.reserve(n + 1);
+    abs_add_binary(x.data(), x.len, y.data(), y.len, x.data());
+    x.len = n + 1;
+    x.normalize();
+}
+
+// x -= y，要求 x >= y
+void _sub(_gcd_nat& x, _gcd_nat& y) {
+    abs_sub_binary(x.data(), x.len, y.data(), y.len, x.data());
+    x.normalize();
+}
+
+// x += y * q，q 为单字
+void _addmul_1(_gcd_nat& x, _gcd_nat& y, lamp_ui q) {
+    if (y.isZero() || q == 0) {
+        return;
+    }
+    const lamp_ui n = std::max(x.len, y.len + 1);
+    x.reserve(n + 1);
+    lamp_ptr xp = x.data(), yp = y.data();
+    std::fill(xp + x.len, xp + n + 1, lamp_ui(0));
+    lamp_ui carry = 0, lo, hi;
+    bool cf;
+    for (lamp_ui i = 0; i < y.len; i++) {
+        mul64x64to128(yp[i], q, lo, hi);
+        lo = add_half(lo, carry, cf);
+        hi += cf;
+        xp[i] = add_half(xp[i], lo, cf);
+        carry = hi + cf;
+    }
+    for (lamp_ui i = y.len; carry != 0; i++) {
+        xp[i] = add_half(xp[i], carry, cf);
+        carry = cf;
+    }
+    x.len = n + 1;
+    x.normalize();
+}
+
+// x += y * q
+void _addmul(_gcd_nat& x, _gcd_nat& y, _gcd_nat& q) {
+    if (q.len <= 1) {
+        _addmul_1(x, y, q.isZero() ? 0 : q.data()[0]);
+        return;
+    }
+    _gcd_nat t;
+    _mul(y, q, t);
+    _add(x, t);
+}
+
+// out = u * x + v * y，out 不可与 x、y 相同
+void _lin_add(lamp_ui u, _gcd_nat& x, lamp_ui v, _gcd_nat& y, _gcd_nat& out) {
+    const lamp_ui n = std::max(x.len, y.len);
+    out.reserve(n + 2);
+    lamp_ptr xp = x.data(), yp = y.data(), op = out.data();
+    lamp_ui cu = 0, cv = 0, pl, ph, ql, qh;
+    bool cf = false, c1;
+    for (lamp_ui i = 0; i < n; i++) {
+        mul64x64to128(u, i < x.len ? xp[i] : 0, pl, ph);
+        mul64x64to128(v, i < y.len ? yp[i] : 0, ql, qh);
+        pl = add_half(pl, cu, c1);
+        ph += c1;
+        ql = add_half(ql, cv, c1);
+        qh += c1;
+        op[i] = add_carry(pl, ql, cf);
+        cu = ph;
+        cv = qh;
+    }
+    op[n] = add_carry(cu, cv, cf);
+    op[n + 1] = cf;
+    out.len = n + 2;
+    out.normalize();
+}
+
+// out = u * x - v * y，结果为负时返回 false，out 不可与 x、y 相同
+bool _lin_sub(lamp_ui u, _gcd_nat& x, lamp_ui v, _gcd_nat& y, _gcd_nat& out) {
+    const lamp_ui n = std::max(x.len, y.len);
+    out.reserve(n + 1);
+    lamp_ptr xp = x.data(), yp = y.data(), op = out.data();
+    lamp_ui cu = 0, cv = 0, pl, ph, ql, qh;
+    bool bf = false, c1;
+    for (lamp_ui i = 0; i < n; i++) {
+        mul64x64to128(u, i < x.len ? xp[i] : 0, pl, ph);
+        mul64x64to128(v, i < y.len ? yp[i] : 0, ql, qh);
+        pl = add_half(pl, cu, c1);
+        ph += c1;
+        ql = add_half(ql, cv, c1);
+        qh += c1;
+        op[i] = sub_borrow(pl, ql, bf);
+        cu = ph;
+        cv = qh;
+    }
+    op[n] = sub_borrow(cu, cv, bf);
+    out.len = n + 1;
+    out.normalize();
+    return !bf;
+}
+
+// out = hi * B^p + u * x - v * y，已知结果非负
+void _combine(_gcd_nat& hi, lamp_ui p, _gcd_nat& u, _gcd_nat& x, _gcd_nat& v, _gcd_nat& y, _gcd_nat& out) {
+    _gcd_nat t;
+    out.reserve(hi.len + p + 1);
+    std::fill(out.data(), out.data() + p, lamp_ui(0));
+    std::copy(hi.data(), hi.data() + hi.len, out.data() + p);
+    out.len = hi.len + p;
+    out.normalize();
+    _mul(u, x, t);
+    _add(out, t);
+    _mul(v, y, t);
+    _sub(out, t);
+}
+
+// q = x / y，r = x % y，y 不为零
+void _divmod(_gcd_nat& x, _gcd_nat& y, _gcd_nat& q, _gcd_nat& r) {
+    if (_cmp(x, y) < 0) {
+        q.len = 0;
+        r.assign(x.data(), x.len);
+        return;
+    }
+    if (y.len == 1) {
+        q.reserve(x.len);
+        const lamp_ui rem = abs_div_rem_num64(x.data(), x.len, q.data(), y.data()[0]);
+        q.len = x.len;
+        q.normalize();
+        r.setWord(rem);
+        return;
+    }
+    const int shift = lammp_clz(y.data()[y.len - 1]);
+    _internal_buffer<0> _x_shifted(x.len + 2, 0);
+    _internal_buffer<0> _y_shifted(y.len + 1, 0);
+    lshift_in_word(x.data(), x.len, _x_shifted.data(), shift);
+    lshift_in_word(y.data(), y.len, _y_shifted.data(), shift);
+    const lamp_ui x_len = rlz(_x_shifted.data(), x.len + 2);
+    const lamp_ui q_len = get_div_len(x_len, y.len) + 1;
+    _internal_buffer<0> _rem(y.len + 1, 0);
+    q.reserve(q_len);
+    std::fill(q.data(), q.data() + q_len, lamp_ui(0));
+    abs_div_knuth(_x_shifted.data(), x_len, _y_shifted.data(), y.len, q.data(), _rem.data());
+    q.len = q_len;
+    q.normalize();
+    r.reserve(y.len);
+    rshift_in_word(_rem.data(), y.len, r.data(), shift);
+    r.len = y.len;
+    r.normalize();
+}
+
+/*
+ * 约化矩阵 M，只维护 first 及其后的行：
+ * 半 GCD 需要完整的 M；扩展 GCD 只需第二行 (m10, m11)，它给出 a0 的系数
+ */
+class _gcd_matrix {
+   private:
+    _gcd_nat t0_, t1_, t2_;
+
+   public:
+    _gcd_nat m[2][2];
+    int first;
+    bool identity = true;
+
+    explicit _gcd_matrix(int first_row = 0) : first(first_row) {
+        for (int i = first; i < 2; i++) {
+            m[i][i].setWord(1);
+            m[i][1 - i].len = 0;
+        }
+    }
+
+    // a -= q * b
+    void stepA(_gcd_nat& q) {
+        for (int i = first; i < 2; i++) {
+            _addmul(m[i][1], m[i][0], q);
+        }
+        identity = false;
+    }
+    // b -= q * a
+    void stepB(_gcd_nat& q) {
+        for (int i = first; i < 2; i++) {
+            _addmul(m[i][0], m[i][1], q);
+        }
+        identity = false;
+    }
+    // M = M * l，l 为单字矩阵
+    void mulSmall(const lamp_ui l[2][2]) {
+        for (int i = first; i < 2; i++) {
+            _lin_add(l[0][0], m[i][0], l[1][0], m[i][1], t0_);
+            _lin_add(l[0][1], m[i][0], l[1][1], m[i][1], t1_);
+            m[i][0].swap(t0_);
+            m[i][1].swap(t1_);
+        }
+        identity = false;
+    }
+    // M = M * h
+    void mulBig(_gcd_matrix& h) {
+        if (h.identity) {
+            return;
+        }
+        for (int i = first; i < 2; i++) {
+            if (identity) {
+                m[i][0].assign(h.m[i][0].data(), h.m[i][0].len);
+                m[i][1].assign(h.m[i][1].data(), h.m[i][1].len);
+                continue;
+            }
+            _mul(m[i][0], h.m[0][0], t0_);
+            _mul(m[i][1], h.m[1][0], t2_);
+            _add(t0_, t2_);
+            _mul(m[i][0], h.m[0][1], t1_);
+            _mul(m[i][1], h.m[1][1], t2_);
+            _add(t1_, t2_);
+            m[i][0].swap(t0_);
+            m[i][1].swap(t1_);
+        }
+        identity = false;
+    }
+};
+
+/*
+ * 对较大者做一次带余除法。s > 0 时要求约化后两数仍长于 s 个字：
+ * 余数过短时商减一（余数加回较小者），商为零则无法前进，返回 false
+ */
+bool _gcd_step(_gcd_nat& a, _gcd_nat& b, lamp_ui s, _gcd_matrix* M) {
+    const bool a_big = _cmp(a, b) >= 0;
+    _gcd_nat& x = a_big ? a : b;
+    _gcd_nat& y = a_big ? b : a;
+    if (y.isZero()) {
+        return false;
+    }
+    _gcd_nat q, r;
+    _divmod(x, y, q, r);
+    if (s > 0 && r.len <= s) {
+        if (q.len == 1 && q.data()[0] == 1) {
+            return false;
+        }
+        abs_sub_binary_num(q.data(), q.len, 1, q.data());
+        q.normalize();
+        _add(r, y);
+    }
+    x.swap(r);
+    if (M != nullptr) {
+        a_big ? M->stepA(q) : M->stepB(q);
+    }
+    return true;
+}
+
+// 128 位除法 x / y，要求 x >= y 且 y >= 2^64，商必小于 2^64
+lamp_ui _div128(_uint128 x, _uint128 y, _uint128& r) {
+    const _uint128 d = x - y;
+    if (d < y) {
+        r = d;
+        return 1;
+    }
+    // 除数截断为规格化的单字，估计商不小于真实商且至多大 2
+    const int k = 64 - lammp_clz(y.high64());
+    const _uint128 xk = x >> k;
+    lamp_ui lo = xk.low64();
+    lamp_ui q = div128by64to64(xk.high64(), lo, (y >> k).low64());
+    while (true) {
+        lamp_ui p0, p1, b0, b1;
+        mul64x64to128(q, y.low64(), p0, p1);
+        mul64x64to128(q, y.high64(), b0, b1);
+        bool cf;
+        p1 = add_half(p1, b0, cf);
+        const _uint128 prod(p0, p1);
+        if (b1 + cf == 0 && !(x < prod)) {
+            r = x - prod;
+            return q;
+        }
+        q--;
+    }
+}
+
+/*
+ * Lehmer 双字步：对对齐后的高 128 位 (x, y) 做欧几里得步，累积单字矩阵 l
+ * 每一步后两者都不小于 2^64，而 l 的元素小于 2^64，因此同一矩阵作用到完整数上结果仍为正
+ */
+bool _lehmer_matrix(_uint128 x, _uint128 y, lamp_ui l[2][2]) {
+    l[0][0] = l[1][1] = 1;
+    l[0][1] = l[1][0] = 0;
+    bool moved = false;
+    _uint128 r;
+    while (true) {
+        if (!(x < y)) {
+            if (y.high64() == 0) {
+                break;
+            }
+            const lamp_ui q = _div128(x, y, r);
+            if (r.high64() == 0) {
+                break;
+            }
+            l[0][1] += q * l[0][0];
+            l[1][1] += q * l[1][0];
+            x = r;
+        } else {
+            if (x.high64() == 0) {
+                break;
+            }
+            const lamp_ui q = _div128(y, x, r);
+            if (r.high64() == 0) {
+                break;
+            }
+            l[0][0] += q * l[0][1];
+            l[1][0] += q * l[1][1];
+            y = r;
+        }
+        moved = true;
+    }
+    return moved;
+}
+
+// 取 a 从第 shift 位开始的 128 位
+_uint128 _top128(_gcd_nat& a, lamp_ui shift) {
+    const lamp_ui w = shift / 64;
+    const int bits = shift % 64;
+    lamp_ptr ap = a.data();
+    auto word = [&](lamp_ui i) { return i < a.len ? ap[i] : lamp_ui(0); };
+    lamp_ui lo = word(w), mid = word(w + 1), hi = word(w + 2);
+    if (bits != 0) {
+        lo = (lo >> bits) | (mid << (64 - bits));
+        mid = (mid >> bits) | (hi << (64 - bits));
+    }
+    return _uint128(lo, mid);
+}
+
+// 一次 Lehmer 约化，约化后两数都要长于 s 个字（s 为 0 时只要求非零）
+bool _lehmer_step(_gcd_nat& a, _gcd_nat& b, lamp_ui s, _gcd_matrix* M) {
+    _gcd_nat& big = a.len >= b.len ? a : b;
+    const lamp_ui bits = bit_length(big.data(), big.len);
+    const lamp_ui shift = bits > 128 ? bits - 128 : 0;
+    lamp_ui l[2][2];
+    if (!_lehmer_matrix(_top128(a, shift), _top128(b, shift), l)) {
+        return false;
+    }
+    // (a; b) = l * (a'; b')，l^-1 = [[l11, -l01], [-l10, l00]]
+    _gcd_nat ta, tb;
+    if (!_lin_sub(l[1][1], a, l[0][1], b, ta) || !_lin_sub(l[0][0], b, l[1][0], a, tb)) {
+        return false;
+    }
+    if (ta.len <= s || tb.len <= s) {
+        return false;
+    }
+    a.swap(ta);
+    b.swap(tb);
+    if (M != nullptr) {
+        M->mulSmall(l);
+    }
+    return true;
+}
+
+// 在两数都长于 s 个字的约束下反复约化，直到无法前进
+bool _hgcd_lehmer(_gcd_nat& a, _gcd_nat& b, lamp_ui s, _gcd_matrix& M) {
+    bool moved = false;
+    while (_lehmer_step(a, b, s, &M) || _gcd_step(a, b, s, &M)) {
+        moved = true;
+    }
+    return moved;
+}
+
+bool _hgcd(_gcd_nat& a, _gcd_nat& b, _gcd_matrix& M);
+
+/*
+ * 对 a、b 去掉低 p 个字后的高位部分求半 GCD，再把矩阵作用到完整数上：
+ *   a' = a_hi' * B^p + m11 * a_lo - m01 * b_lo
+ *   b' = b_hi' * B^p + m00 * b_lo - m10 * a_lo
+ */
+bool _hgcd_top(_gcd_nat& a, _gcd_nat& b, lamp_ui p, _gcd_matrix& M) {
+    if (a.len <= p || b.len <= p) {
+        return false;
+    }
+    _gcd_nat a_hi, b_hi;
+    a_hi.assign(a.data() + p, a.len - p);
+    b_hi.assign(b.data() + p, b.len - p);
+    if (!_hgcd(a_hi, b_hi, M)) {
+        return false;
+    }
+    _gcd_nat a_lo, b_lo;
+    a_lo.assign(a.data(), p);
+    b_lo.assign(b.data(), p);
+    _combine(a_hi, p, M.m[1][1], a_lo, M.m[0][1], b_lo, a);
+    _combine(b_hi, p, M.m[0][0], b_lo, M.m[1][0], a_lo, b);
+    return true;
+}
+
+/*
+ * 半 GCD（Möller 的形式）：n 为两数的最大字长，s = n / 2 + 1
+ * 在两数始终长于 s 个字的前提下尽量约化，M 的元素短于 n - s 个字，
+ * 因此 M 作用到以 (a, b) 为高位的更长的数上时结果仍为正，可供上一层递归使用
+ */
+bool _hgcd(_gcd_nat& a, _gcd_nat& b, _gcd_matrix& M) {
+    const lamp_ui n = std::max(a.len, b.len);
+    const lamp_ui s = n / 2 + 1;
+    if (a.len <= s || b.len <= s) {
+        return false;
+    }
+    if (n < HGCD_THRESHOLD) {
+        return _hgcd_lehmer(a, b, s, M);
+    }
+    // 高半部分约化后两数约为 3n / 4 个字
+    bool moved = _hgcd_top(a, b, n / 2, M);
+    const lamp_ui n2 = (3 * n) / 4 + 1;
+    while (std::max(a.len, b.len) > n2) {
+        if (!_gcd_step(a, b, s, &M)) {
+            return moved;
+        }
+        moved = true;
+    }
+    // 再对高 2 * (cur - s) 个字递归一次，约化到约 s 个字
+    const lamp_ui cur = std::max(a.len, b.len);
+    _gcd_matrix M2;
+    if (_hgcd_top(a, b, 2 * s - cur + 1, M2)) {
+        M.mulBig(M2);
+        moved = true;
+    }
+    return _hgcd_lehmer(a, b, s, M) || moved;
+}
+
+// 单字二进制 GCD
+lamp_ui _gcd_word(lamp_ui a, lamp_ui b) {
+    if (a == 0 || b == 0) {
+        return a | b;
+    }
+    const int shift = lammp_ctz(a | b);
+    a >>= lammp_ctz(a);
+    while (b != 0) {
+        b >>= lammp_ctz(b);
+        if (a > b) {
+            std::swap(a, b);
+        }
+        b -= a;
+    }
+    return a << shift;
+}
+
+// 约化至其中一数为零，另一数即为 GCD；M 非空时同时累积矩阵
+void _gcd_reduce(_gcd_nat& a, _gcd_nat& b, _gcd_matrix* M) {
+    while (!a.isZero() && !b.isZero()) {
+        const lamp_ui n = std::max(a.len, b.len);
+        if (n >= HGCD_THRESHOLD) {
+            _gcd_matrix H;
+            if (_hgcd(a, b, H)) {
+                if (M != nullptr) {
+                    M->mulBig(H);
+                }
+                continue;
+            }
+        } else if (n == 1 && M == nullptr) {
+            a.setWord(_gcd_word(a.data()[0], b.data()[0]));
+            b.len = 0;
+            return;
+        } else if (_lehmer_step(a, b, 0, M)) {
+            continue;
+        }
+        _gcd_step(a, b, 0, M);
+    }
+}
+
+};  // namespace
+
+/*
+ * @brief 计算 gcd(in1, in2)
+ * @param out 输出，长度至少为 max(len1, len2)
+ * @return 结果的长度，两数均为零时返回 0
+ * @details 小于 HGCD_THRESHOLD 个字时使用 Lehmer 双字步，否则使用半 GCD
+ */
+lamp_ui abs_gcd64(lamp_ptr in1, lamp_ui len1, lamp_ptr in2, lamp_ui len2, lamp_ptr out) {
+    assert(in1 != nullptr && in2 != nullptr && out != nullptr);
+    _gcd_nat a, b;
+    a.assign(in1, len1);
+    b.assign(in2, len2);
+    _gcd_reduce(a, b, nullptr);
+    _gcd_nat& g = a.isZero() ? b : a;
+    std::copy(g.data(), g.data() + g.len, out);
+    return g.len;
+}
+
+/*
+ * @brief 扩展 GCD：计算 g = gcd(in1, in2) 以及 s，使 s * in1 ≡ g (mod in2)
+ * @param g 输出，长度至少为 max(len1, len2)
+ * @param s 输出 |s|，长度至少为 max(len2, 1)
+ * @param s_len 输出 |s| 的长度
+ * @param s_neg 输出 s 是否为负
+ * @return g 的长度
+ * @details in2 为零时 s = 1；in1 为零时 s = 0。否则 |s| <= in2 / g，另一系数可由 (g - s * in1) / in2 得到
+ */
+lamp_ui abs_gcdext64(lamp_ptr in1,
+                     lamp_ui len1,
+                     lamp_ptr in2,
+                     lamp_ui len2,
+                     lamp_ptr g,
+                     lamp_ptr s,
+                     lamp_ui& s_len,
+                     bool& s_neg) {
+    assert(in1 != nullptr && in2 != nullptr && g != nullptr && s != nullptr);
+    _gcd_nat a, b;
+    a.assign(in1, len1);
+    b.assign(in2, len2);
+    // (a; b) = M^-1 * (in1; in2)，M^-1 = [[m11, -m01], [-m10, m00]]，in1 的系数只与第二行有关
+    _gcd_matrix M(1);
+    _gcd_reduce(a, b, &M);
+    _gcd_nat& res = b.isZero() ? a : b;
+    _gcd_nat& coef = b.isZero() ? M.m[1][1] : M.m[1][0];
+    s_neg = !b.isZero() && !coef.isZero();
+    len2 = rlz(in2, len2);
+    if (coef.len > std::max(len2, lamp_ui(1))) {
+        // 按理不会发生，保险起见模 in2 约化，同余关系不变
+        _gcd_nat m, q, r;
+        m.assign(in2, len2);
+        _divmod(coef, m, q, r);
+        coef.swap(r);
+        s_neg = s_neg && !coef.isZero();
+    }
+    std::copy(coef.data(), coef.data() + coef.len, s);
+    s_len = coef.len;
+    std::copy(res.data(), res.data() + res.len, g);
+    return res.len;
+}
+
+/*
+ * @brief 计算 in^-1 mod mod，结果取值范围为 [0, mod)
+ * @param out 输出，长度至少为 mod_len
+ * @param out_len 输出结果的长度
+ * @return 逆元是否存在（gcd(in, mod) == 1）
+ */
+bool abs_inv_mod64(lamp_ptr in, lamp_ui len, lamp_ptr mod, lamp_ui mod_len, lamp_ptr out, lamp_ui& out_len) {
+    assert(in != nullptr && mod != nullptr && out != nullptr);
+    len = rlz(in, len);
+    mod_len = rlz(mod, mod_len);
+    assert(mod_len > 0);
+    _internal_buffer<0> _x(mod_len, 0);
+    const lamp_ui x_len = len == 0 ? 0 : abs_mod64(in, len, mod, mod_len, _x.data());
+    _internal_buffer<0> _g(mod_len);
+    _internal_buffer<0> _s(mod_len);
+    lamp_ui s_len;
+    bool s_neg;
+    const lamp_ui g_len = abs_gcdext64(_x.data(), x_len, mod, mod_len, _g.data(), _s.data(), s_len, s_neg);
+    if (g_len != 1 || _g[0] != 1) {
+        out_len = 0;
+        return false;
+    }
+    if (s_neg) {
+        abs_sub_binary(mod, mod_len, _s.data(), s_len, out);
+        out_len = rlz(out, mod_len);
+    } else {
+        std::copy(_s.data(), _s.data() + s_len, out);
+        out_len = s_len;
+    }
+    // 保证结果落在 [0, mod) 内
+    if (out_len == mod_len && abs_compare(out, out_len, mod, mod_len) >= 0) {
+        abs_sub_binary(out, out_len, mod, mod_len, out);
+        out_len = rlz(out, mod_len);
+    }
+    return true;
+}
+
+};  // namespace lammp::Arithmetic
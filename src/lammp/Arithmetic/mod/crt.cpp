@@ -0,0 +1,192 @@
+/*
+ * Copyright (C) 2025 HJimmyK/LAMINA
+ *
+ * This file is part of LAMMP, which is licensed under the GNU LGPL v2.1.
+ * See the LICENSE file in the project root for full license details, or visit:
+ * <https://www.gnu.org/licenses/old-licenses/lgpl-2.1.html>
+ */
+
+#include <algorithm>
+
+#include "../../../../include/lammp/prod_tree.hpp"
+#include "../../../../include/lammp/thread_pool.hpp"
+
+/*
+ * 中国剩余定理的快速重建（子积树上的线性组合）：
+ *   s_i = (M / m_i)^-1 mod m_i，其中 M / m_i mod m_i = (M mod m_i^2) / m_i，
+ *   M mod m_i^2 由乘积树上对平方结点的余数树一次得到，避免对每个 m_i 单独做一次大除法；
+ *   c_i = r_i * s_i mod m_i 后，x = sum c_i * (M / m_i) 在乘积树上自底向上合并，
+ *   每层的代价约为一次结点规模的乘法，总代价 O(M(n) log k)，最后对 M 取一次模
+ */
+namespace lammp::Arithmetic {
+
+namespace {
+
+// a^-1 mod m，m 为单字，不存在时返回 false
+bool _inv_mod_word(lamp_ui a, lamp_ui m, lamp_ui& inv) {
+    if (m == 1) {
+        inv = 0;
+        return true;
+    }
+    // 不变量：r0 = ±s0 * a，r1 = ±s1 * a（mod m），系数只记绝对值，符号逐项交替
+    lamp_ui r0 = m, r1 = a % m, s0 = 0, s1 = 1;
+    bool neg = false;
+    while (r1 != 0) {
+        const lamp_ui q = r0 / r1;
+        const lamp_ui r2 = r0 - q * r1;
+        const lamp_ui s2 = s0 + q * s1;
+        r0 = r1;
+        r1 = r2;
+        s0 = s1;
+        s1 = s2;
+        neg = !neg;
+    }
+    if (r0 != 1) {
+        return false;
+    }
+    // 第 n 步后 s0 = |t_n|，t_n 在 n 为偶数时为负，而 neg 记录 n 的奇偶
+    inv = neg ? s0 : m - s0;
+    return true;
+}
+
+// in mod m，m 为单字
+lamp_ui _mod_word(const lamp_ptr in, lamp_ui len, lamp_ui m) {
+    lamp_ui rem = 0;
+    for (lamp_ui i = len; i > 0; i--) {
+        lamp_ui lo = in[i - 1];
+        div128by64to64(rem, lo, m);
+        rem = lo;
+    }
+    return rem;
+}
+
+};  // namespace
+
+CrtPlan::CrtPlan(lamp_ptr* mods, const lamp_ui* lens, lamp_ui count)
+    : tree_(mods, lens, count), count_(count), word_(true), valid_(true), inv_offset_(count + 1, 0), inv_(nullptr) {
+    for (lamp_ui i = 0; i < count; i++) {
+        const lamp_ui len = tree_.nodeLen(0, i);
+        word_ = word_ && len == 1;
+        inv_offset_[i + 1] = inv_offset_[i] + len;
+    }
+    storage_ = _internal_buffer<0>(inv_offset_[count], 0);
+    inv_ = storage_.data();
+    // M mod m_i^2
+    _internal_buffer<0> rem(2 * inv_offset_[count]);
+    std::vector<lamp_ptr> rem_ptr(count);
+    std::vector<lamp_ui> rem_len(count);
+    for (lamp_ui i = 0; i < count; i++) {
+        rem_ptr[i] = rem.data() + 2 * inv_offset_[i];
+    }
+    tree_.remainders(product(), size(), rem_ptr.data(), rem_len.data(), true);
+
+    std::vector<char> ok(count, 1);
+    ThreadPool::global().parallelFor(count, [&](size_t i) {
+        const lamp_ptr m = tree_.node(0, i);
+        const lamp_ui m_len = tree_.nodeLen(0, i);
+        const lamp_ptr s = inv_ + inv_offset_[i];
+        if (word_) {
+            lamp_ui lo = rem_ptr[i][0];
+            const lamp_ui q = div128by64to64(rem_len[i] > 1 ? rem_ptr[i][1] : 0, lo, m[0]);
+            ok[i] = _inv_mod_word(q, m[0], s[0]);
+            return;
+        }
+        // (M mod m^2) / m
+        _internal_buffer<0> q(2 * m_len + 2, 0);
+        if (rem_len[i] > 0) {
+            abs_div64(rem_ptr[i], rem_len[i], m, m_len, q.data());
+        }
+        lamp_ui s_len = 0;
+        ok[i] = abs_inv_mod64(q.data(), rlz(q.data(), 2 * m_len + 2), m, m_len, s, s_len);
+    });
+    valid_ = std::all_of(ok.begin(), ok.end(), [](char v) { return v != 0; });
+}
+
+lamp_ui CrtPlan::reconstruct(lamp_ptr* residues, const lamp_ui* res_lens, lamp_ptr out) const {
+    assert(valid_);
+    // 叶子：c_i = r_i * s_i mod m_i
+    _internal_buffer<0> value(inv_offset_[count_]);
+    std::vector<lamp_ptr> v_ptr(count_);
+    std::vector<lamp_ui> v_len(count_);
+    for (lamp_ui i = 0; i < count_; i++) {
+        v_ptr[i] = value.data() + inv_offset_[i];
+    }
+    ThreadPool::global().parallelFor(count_, [&](size_t i) {
+        const lamp_ptr m = tree_.node(0, i);
+        const lamp_ui m_len = tree_.nodeLen(0, i);
+        const lamp_ptr s = inv_ + inv_offset_[i];
+        const lamp_ui r_len = rlz(residues[i], res_lens[i]);
+        if (word_) {
+            const lamp_ui r = _mod_word(residues[i], r_len, m[0]);
+            lamp_ui lo, hi;
+            mul64x64to128(r, s[0], lo, hi);
+            div128by64to64(hi, lo, m[0]);
+            v_ptr[i][0] = lo;
+            v_len[i] = lo == 0 ? 0 : 1;
+            return;
+        }
+        const lamp_ui s_len = rlz(s, m_len);
+        _internal_buffer<0> r(m_len, 0), rs(2 * m_len);
+        const lamp_ui r_mod_len = r_len == 0 ? 0 : abs_mod64(residues[i], r_len, m, m_len, r.data());
+        if (r_mod_len == 0 || s_len == 0) {
+            v_len[i] = 0;
+            return;
+        }
+        abs_mul64(r.data(), r_mod_len, s, s_len, rs.data());
+        v_len[i] = abs_mod64(rs.data(), rlz(rs.data(), r_mod_len + s_len), m, m_len, v_ptr[i]);
+    });
+
+    // 自底向上合并：结点值 = 左值 * 右积 + 右值 * 左积
+    for (lamp_ui level = 0; level + 1 < tree_.depth(); level++) {
+        const lamp_ui low_count = tree_.count(level);
+        const lamp_ui count = tree_.count(level + 1);
+        std::vector<lamp_ui> offset(count + 1, 0);
+        for (lamp_ui j = 0; j < count; j++) {
+            lamp_ui cap = v_len[2 * j];
+            if (2 * j + 1 < low_count) {
+                cap = std::max(v_len[2 * j] + tree_.nodeLen(level, 2 * j + 1),
+                               v_len[2 * j + 1] + tree_.nodeLen(level, 2 * j)) +
+                      1;
+            }
+            offset[j + 1] = offset[j] + cap;
+        }
+        _internal_buffer<0> high(std::max<lamp_ui>(offset[count], 1));
+        std::vector<lamp_ptr> h_ptr(count);
+        std::vector<lamp_ui> h_len(count);
+        ThreadPool::global().parallelFor(count, [&](size_t j) {
+            const lamp_ptr h = high.data() + offset[j];
+            h_ptr[j] = h;
+            const lamp_ui l = 2 * j, r = 2 * j + 1;
+            if (r == low_count) {
+                std::copy(v_ptr[l], v_ptr[l] + v_len[l], h);
+                h_len[j] = v_len[l];
+                return;
+            }
+            const lamp_ui cap = offset[j + 1] - offset[j];
+            std::fill(h, h + cap, 0);
+            lamp_ui len = 0;
+            if (v_len[l] > 0) {
+                abs_mul64(v_ptr[l], v_len[l], tree_.node(level, r), tree_.nodeLen(level, r), h);
+                len = rlz(h, v_len[l] + tree_.nodeLen(level, r));
+            }
+            if (v_len[r] > 0) {
+                const lamp_ui t_len = v_len[r] + tree_.nodeLen(level, l);
+                _internal_buffer<0> t(t_len);
+                abs_mul64(v_ptr[r], v_len[r], tree_.node(level, l), tree_.nodeLen(level, l), t.data());
+                const lamp_ui t_rlz = rlz(t.data(), t_len);
+                abs_add_binary(h, len, t.data(), t_rlz, h);
+                len = rlz(h, std::max(len, t_rlz) + 1);
+            }
+            h_len[j] = len;
+        });
+        value = std::move(high);
+        v_ptr = std::move(h_ptr);
+        v_len = std::move(h_len);
+    }
+    if (v_len[0] == 0) {
+        return 0;
+    }
+    return abs_mod64(v_ptr[0], v_len[0], product(), size(), out);
+}
+
+};  // namespace lammp::Arithmetic
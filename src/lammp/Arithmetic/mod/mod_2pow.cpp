@@ -0,0 +1,142 @@
+/*
+ * Copyright (C) 2025 HJimmyK/LAMINA
+ *
+ * This file is part of LAMMP, which is licensed under the GNU LGPL v2.1.
+ * See the LICENSE file in the project root for full license details, or visit:
+ * <https://www.gnu.org/licenses/old-licenses/lgpl-2.1.html>
+ */
+
+#include <algorithm>
+
+#include "../../../../include/lammp/inter_buffer.hpp"
+#include "../../../../include/lammp/lammp.hpp"
+
+/*
+ * 模 2^p - 1 与 2^p + 1：2^p ≡ 1（或 -1），因此按 p 位分块后直接求和（交错求和）即可归约，不需要除法。
+ * 平方时若 p = bits * 2^k（bits <= 64），2^p 恰好是长为 2^k 的卷积回绕的位置，
+ * 用循环（负循环）卷积直接得到回绕后的结果，变换长度只有普通平方的一半，也省去了归约前的大数；
+ * 三个 NTT 模数下 2 只是二次（四次）剩余，没有 IBDWT 所需的 2 的高次方根，无法处理任意 p（如梅森素数的指数），
+ * 此时退回完整平方后再分块求和
+ */
+namespace lammp::Arithmetic {
+
+namespace {
+
+// m = 2^p - 1 或 2^p + 1，m 为 p / 64 + 1 个字，返回长度
+lamp_ui _modulus(lamp_ui p, bool plus, lamp_ptr m) {
+    const lamp_ui m_len = p / 64 + 1;
+    std::fill(m, m + m_len, lamp_ui(0));
+    if (plus) {
+        m[0] = 1;
+        set_bit(m, m_len, p);
+    } else {
+        std::fill(m, m + p / 64, ~lamp_ui(0));
+        m[p / 64] = (lamp_ui(1) << (p % 64)) - 1;
+    }
+    return rlz(m, m_len);
+}
+
+/*
+ * out = in mod m，每轮把 x 拆成 p 位的块求和（模 2^p + 1 时奇数块取负），
+ * 每轮后位长约为 p + log2(块数)，一般两三轮后不超过 p + 1 位，最后减去若干次 m
+ */
+lamp_ui _reduce(lamp_ptr in, lamp_ui len, lamp_ui p, bool plus, lamp_ptr out) {
+    const lamp_ui m_len = p / 64 + 1, acc_len = m_len + 2;
+    _internal_buffer<0> m(m_len);
+    const lamp_ui m_rlz = _modulus(p, plus, m.data());
+    len = rlz(in, len);
+    const lamp_ui x_cap = std::max(len, acc_len) + 1;
+    _internal_buffer<0> x(x_cap, 0);
+    std::copy(in, in + len, x.data());
+    const lamp_ui top = p / 64, top_mask = (lamp_ui(1) << (p % 64)) - 1;
+    while (len > 0 && bit_length(x.data(), len) > p + 1) {
+        const lamp_ui chunks = (bit_length(x.data(), len) + p - 1) / p;
+        _internal_buffer<0> pos(acc_len, 0), neg(acc_len, 0), chunk(m_len + 1, 0);
+        for (lamp_ui i = 0; i < chunks; i++) {
+            const lamp_ui shift = i * p, word = shift / 64;
+            const lamp_ui take = std::min(len - word, m_len + 1);
+            std::fill(chunk.data(), chunk.data() + m_len + 1, lamp_ui(0));
+            rshift_bits(x.data() + word, take, chunk.data(), shift % 64);
+            chunk.data()[top] &= top_mask;
+            chunk.data()[top + 1] = 0;
+            lamp_ptr acc = plus && i % 2 == 1 ? neg.data() : pos.data();
+            abs_add_binary(acc, acc_len - 1, chunk.data(), m_len, acc);
+        }
+        std::fill(x.data(), x.data() + x_cap, lamp_ui(0));
+        const lamp_ui pos_len = rlz(pos.data(), acc_len), neg_len = rlz(neg.data(), acc_len);
+        if (plus && abs_compare(pos.data(), pos_len, neg.data(), neg_len) < 0) {
+            // x = pos + t * m - neg，t = (neg >> p) + 1 保证非负
+            const lamp_ui sh = p % 64;
+            lamp_ui t = (neg.data()[top] >> sh) + (sh != 0 ? neg.data()[top + 1] << (64 - sh) : 0) + 1;
+            _internal_buffer<0> tm(acc_len + 1, 0);
+            tm.data()[top] = t << sh;
+            tm.data()[top + 1] = sh != 0 ? t >> (64 - sh) : 0;
+            abs_add_binary(tm.data(), acc_len, &t, 1, tm.data());
+            abs_add_binary(pos.data(), acc_len, tm.data(), acc_len, x.data());
+            abs_sub_binary(x.data(), acc_len + 1, neg.data(), acc_len, x.data());
+            len = rlz(x.data(), acc_len + 1);
+        } else {
+            abs_sub_binary(pos.data(), pos_len, neg.data(), neg_len, x.data());
+            len = rlz(x.data(), pos_len);
+        }
+    }
+    while (abs_compare(x.data(), len, m.data(), m_rlz) >= 0) {
+        abs_sub_binary(x.data(), len, m.data(), m_rlz, x.data());
+        len = rlz(x.data(), len);
+    }
+    std::copy(x.data(), x.data() + len, out);
+    return len;
+}
+
+lamp_ui _sqr_mod(lamp_ptr in, lamp_ui len, lamp_ui p, bool plus, lamp_ptr out) {
+    const lamp_ui m_len = p / 64 + 1;
+    _internal_buffer<0> x(m_len);
+    const lamp_ui x_len = _reduce(in, len, p, plus, x.data());
+    if (x_len == 0) {
+        return 0;
+    }
+    // p = bits * ntt_len，bits 取不超过 64 的最大值
+    lamp_ui bits = p, ntt_len = 1;
+    while (bits > 64 && bits % 2 == 0) {
+        bits /= 2;
+        ntt_len *= 2;
+    }
+    if (p >= SQR_MOD_WRAP_MIN_BITS && bits <= 64) {
+        // x = 2^p ≡ -1 不在卷积的输入范围内
+        if (plus && bit_length(x.data(), x_len) > p) {
+            out[0] = 1;
+            return 1;
+        }
+        const lamp_ui sqr_len = p / 64 + 3;
+        _internal_buffer<0> sqr(sqr_len);
+        abs_sqr64_ntt_wrap(x.data(), x_len, bits, ntt_len, plus, sqr.data());
+        return _reduce(sqr.data(), sqr_len, p, plus, out);
+    }
+    _internal_buffer<0> sqr(x_len * 2);
+    abs_sqr64(x.data(), x_len, sqr.data());
+    return _reduce(sqr.data(), x_len * 2, p, plus, out);
+}
+
+};  // namespace
+
+lamp_ui abs_mod_mersenne64(lamp_ptr in, lamp_ui len, lamp_ui p, lamp_ptr out) {
+    assert(p > 0);
+    return _reduce(in, len, p, false, out);
+}
+
+lamp_ui abs_mod_fermat64(lamp_ptr in, lamp_ui len, lamp_ui p, lamp_ptr out) {
+    assert(p > 0);
+    return _reduce(in, len, p, true, out);
+}
+
+lamp_ui abs_sqr_mod_mersenne64(lamp_ptr in, lamp_ui len, lamp_ui p, lamp_ptr out) {
+    assert(p > 0);
+    return _sqr_mod(in, len, p, false, out);
+}
+
+lamp_ui abs_sqr_mod_fermat64(lamp_ptr in, lamp_ui len, lamp_ui p, lamp_ptr out) {
+    assert(p > 0);
+    return _sqr_mod(in, len, p, true, out);
+}
+
+};  // namespace lammp::Arithmetic
@@ -0,0 +1,43 @@
+/*
+ * Copyright (C) 2025 HJimmyK/LAMINA
+ *
+ * This file is part of LAMMP, which is licensed under the GNU LGPL v2.1.
+ * See the LICENSE file in the project root for full license details, or visit:
+ * <https://www.gnu.org/licenses/old-licenses/lgpl-2.1.html>
+ */
+
+#include <algorithm>
+
+#include "../../../../include/lammp/prod_tree.hpp"
+
+/*
+ * 余数树：先自底向上建模数的乘积树（每层相邻两个结点相乘，落单的结点直接升到上一层），
+ * 再自顶向下求余，每个结点的余数由父结点的余数对自身取模得到。
+ * 每层的余数不长于该层结点，因此越往下被除数越短，总代价约为 O(M(n) log k)，
+ * 而逐个取模需要 k 次对整个 x 的除法。结点已比 x 的一半还长时不再往上建，最上层各结点直接对 x 取模。
+ * 同一层的结点互不依赖，交给全局线程池
+ */
+namespace lammp::Arithmetic {
+
+/*
+ * @brief 计算 outs[i] = in mod mods[i]
+ * @param mods 模数数组，均不可为零
+ * @param outs 输出数组，outs[i] 的长度至少为 mod_lens[i]
+ * @param out_lens 输出的长度，可以为 nullptr
+ */
+void abs_mod_multi64(lamp_ptr in,
+                     lamp_ui len,
+                     lamp_ptr* mods,
+                     const lamp_ui* mod_lens,
+                     lamp_ui count,
+                     lamp_ptr* outs,
+                     lamp_ui* out_lens) {
+    if (count == 0) {
+        return;
+    }
+    len = len == 0 ? 0 : rlz(in, len);
+    const ProductTree tree(mods, mod_lens, count, std::max<lamp_ui>(len, 1));
+    tree.remainders(in, len, outs, out_lens);
+}
+
+};  // namespace lammp::Arithmetic
@@ -0,0 +1,174 @@
+/*
+ * Copyright (C) 2025 HJimmyK/LAMINA
+ *
+ * This file is part of LAMMP, which is licensed under the GNU LGPL v2.1.
+ * See the LICENSE file in the project root for full license details, or visit:
+ * <https://www.gnu.org/licenses/old-licenses/lgpl-2.1.html>
+ */
+
+#include "../../../../include/lammp/mont_multi.hpp"
+
+namespace lammp::Arithmetic {
+
+/*
+ * @brief 计算 in^-1 mod 2^(64 * len)，in 必须为奇数
+ * @details 以 inv_mod2pow 求得的单字逆元为初值做牛顿迭代 x = x * (2 - in * x)，每轮精度翻倍。
+ *          若 in * x = 1 + h * B^p (mod B^2p)，则新的 x 低 p 字不变，高位为 -(x * h) mod B^p
+ * @param in 输入，长度为 in_len
+ * @param out 输出，长度为 len
+ */
+void inv_mod_2pow64(lamp_ptr in, lamp_ui in_len, lamp_ptr out, lamp_ui len) {
+    assert(in != nullptr && out != nullptr && in_len > 0 && len > 0);
+    assert((in[0] & 1) == 1);
+    std::fill(out, out + len, lamp_ui(0));
+    out[0] = inv_mod2pow(in[0], 64);
+    if (len == 1) {
+        return;
+    }
+    _internal_buffer<0> _err(2 * len);
+    _internal_buffer<0> _corr(len);
+    lamp_ptr err = _err.data(), corr = _corr.data();
+    lamp_ui p = 1;
+    while (p < len) {
+        const lamp_ui np = std::min(2 * p, len);
+        const lamp_ui in_np = std::min(in_len, np);
+        std::fill(err, err + np + p, lamp_ui(0));
+        abs_mul64(in, in_np, out, p, err);
+        // corr = x * h，h 为 in * x 的第 p 至 np 字
+        abs_mul64(out, p, err + p, np - p, corr);
+        bool borrow = false;
+        for (lamp_ui i = 0; i < np - p; i++) {
+            out[p + i] = sub_borrow(lamp_ui(0), corr[i], borrow);
+        }
+        p = np;
+    }
+}
+
+MontMultiCtx::MontMultiCtx(lamp_ptr mod, lamp_ui len) : len_(rlz(mod, len)), storage_(4 * rlz(mod, len), 0) {
+    assert(len_ > 0 && (mod[0] & 1) == 1);
+    const lamp_ui n = len_;
+    mod_ = storage_.data();
+    mod_inv_neg_ = mod_ + n;
+    r_square_ = mod_inv_neg_ + n;
+    one_ = r_square_ + n;
+    std::copy(mod, mod + n, mod_);
+    mod_inv_neg64_ = lamp_ui(0) - inv_mod2pow(mod_[0], 64);
+
+    // -mod^-1 mod R
+    inv_mod_2pow64(mod_, n, mod_inv_neg_, n);
+    bool borrow = false;
+    for (lamp_ui i = 0; i < n; i++) {
+        mod_inv_neg_[i] = sub_borrow(lamp_ui(0), mod_inv_neg_[i], borrow);
+    }
+
+    // R mod mod，被除数只比模数长一个字，Knuth 除法只需一到两轮
+    {
+        _internal_buffer<0> _r(n + 1, 0);
+        _r.set(n, 1);
+        abs_mod64(_r.data(), n + 1, mod_, n, one_);
+    }
+
+    // R^2 mod mod：设 y 为 2^e 的蒙哥马利形式，平方使 e 翻倍，模倍加使 e 加一，
+    // 按 64 * n 的二进制位从高到低推进，只需 O(log n) 次蒙哥马利平方，避免 2n / n 字的长除法
+    auto double_mod = [this, n](lamp_ptr y) {
+        const lamp_ui top = lshift_in_word_half(y, n, y, 1);
+        if (top != 0 || abs_compare(y, n, mod_, n) >= 0) {
+            abs_sub_binary(y, n, mod_, n, y);
+        }
+    };
+    _internal_buffer<0> _work(workSize());
+    const lamp_ui e = 64 * n;
+    int bit = 63 - lammp_clz(e);
+    std::copy(one_, one_ + n, r_square_);
+    double_mod(r_square_);
+    for (bit--; bit >= 0; bit--) {
+        sqr(r_square_, r_square_, _work.data());
+        if ((e >> bit) & 1) {
+            double_mod(r_square_);
+        }
+    }
+}
+
+// in[0, n] 与 mod 比较，必要时减去 mod，结果写入 out
+void MontMultiCtx::finalSub(lamp_ptr in, lamp_ptr out) const {
+    const lamp_ui n = len_;
+    if (in[n] != 0 || abs_compare(in, n, mod_, n) >= 0) {
+        abs_sub_binary(in, n, mod_, n, out);
+    } else {
+        std::copy(in, in + n, out);
+    }
+}
+
+// 逐字 REDC：每轮消去最低一个字
+void MontMultiCtx::redcClassic(lamp_ptr in_out) const {
+    const lamp_ui n = len_;
+    for (lamp_ui i = 0; i < n; i++) {
+        const lamp_ui q = in_out[i] * mod_inv_neg64_;
+        // mul64_sub_proc 会覆盖 in_out[i + n]，先保存再加回
+        const lamp_ui hi = in_out[i + n];
+        mul64_sub_proc(mod_, n, in_out + i, q);
+        bool cf;
+        in_out[i + n] = add_half(in_out[i + n], hi, cf);
+        for (lamp_ui j = i + n + 1; cf && j <= 2 * n; j++) {
+            in_out[j] = add_half(in_out[j], lamp_ui(1), cf);
+        }
+    }
+}
+
+// 乘法 REDC：q = (T mod R) * (-mod^-1) mod R，T + q * mod 可被 R 整除
+void MontMultiCtx::redcMul(lamp_ptr in_out, lamp_ptr work) const {
+    const lamp_ui n = len_;
+    lamp_ptr q = work, qm = work + 2 * n;
+    abs_mul64(in_out, n, mod_inv_neg_, n, q);
+    abs_mul64(q, n, mod_, n, qm);
+    abs_add_binary_half(in_out, 2 * n + 1, qm, 2 * n, in_out);
+}
+
+void MontMultiCtx::redc(lamp_ptr in, lamp_ptr out, lamp_ptr work) const {
+    if (len_ <= MONT_REDC_CLASSIC_THRESHOLD) {
+        redcClassic(in);
+    } else {
+        redcMul(in, work);
+    }
+    finalSub(in + len_, out);
+}
+
+void MontMultiCtx::mul(lamp_ptr a, lamp_ptr b, lamp_ptr out, lamp_ptr work) const {
+    const lamp_ui n = len_;
+    lamp_ptr t = work;
+    abs_mul64(a, n, b, n, t);
+    t[2 * n] = 0;
+    redc(t, out, work + 2 * n + 1);
+}
+
+void MontMultiCtx::sqr(lamp_ptr a, lamp_ptr out, lamp_ptr work) const {
+    const lamp_ui n = len_;
+    lamp_ptr t = work;
+    abs_sqr64(a, n, t);
+    t[2 * n] = 0;
+    redc(t, out, work + 2 * n + 1);
+}
+
+void MontMultiCtx::toMont(lamp_ptr in, lamp_ui in_len, lamp_ptr out, lamp_ptr work) const {
+    const lamp_ui n = len_;
+    in_len = rlz(in, in_len);
+    if (in_len > n || (in_len == n && abs_compare(in, n, mod_, n) >= 0)) {
+        // abs_mod64 先复制被除数再写余数，out 可以与 in 相同
+        const lamp_ui rem_len = abs_mod64(in, in_len, mod_, n, out);
+        std::fill(out + rem_len, out + n, lamp_ui(0));
+    } else if (in != out) {
+        std::copy(in, in + in_len, out);
+        std::fill(out + in_len, out + n, lamp_ui(0));
+    }
+    mul(out, r_square_, out, work);
+}
+
+void MontMultiCtx::toInt(lamp_ptr in, lamp_ptr out, lamp_ptr work) const {
+    const lamp_ui n = len_;
+    lamp_ptr t = work;
+    std::copy(in, in + n, t);
+    std::fill(t + n, t + 2 * n + 1, lamp_ui(0));
+    redc(t, out, work + 2 * n + 1);
+}
+
+};  // namespace lammp::Arithmetic
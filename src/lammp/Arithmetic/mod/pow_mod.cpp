@@ -0,0 +1,432 @@
+/*
+ * Copyright (C) 2025 HJimmyK/LAMINA
+ *
+ * This file is part of LAMMP, which is licensed under the GNU LGPL v2.1.
+ * See the LICENSE file in the project root for full license details, or visit:
+ * <https://www.gnu.org/licenses/old-licenses/lgpl-2.1.html>
+ */
+
+#include "../../../../include/lammp/mont_multi.hpp"
+#include "../../../../include/lammp/thread_pool.hpp"
+#include <memory>
+
+namespace lammp::Arithmetic {
+
+// 按指数位长选择窗口大小，使 预计算次数 + 乘法次数 最少
+lamp_ui PowWindowPlan::windowSize(lamp_ui bits) {
+    constexpr lamp_ui table[] = {7, 25, 81, 241, 673, 1793, 4609};
+    lamp_ui k = 1;
+    for (lamp_ui limit : table) {
+        if (bits <= limit) {
+            return k;
+        }
+        k++;
+    }
+    return k;
+}
+
+PowWindowPlan::PowWindowPlan(lamp_ptr exp, lamp_ui len, lamp_ui window) : first_(0), step_count_(0) {
+    len = rlz(exp, len);
+    assert(len > 0);
+    const lamp_ui bits = bit_length(exp, len);
+    window_ = window == 0 ? windowSize(bits) : window;
+    assert(window_ >= 1 && window_ <= 16);
+    steps_ = _internal_buffer<0>(bits);
+
+    bool first = true;
+    lamp_ui pending_sqr = 0;
+    lamp_si i = lamp_si(bits) - 1;
+    while (i >= 0) {
+        if (!get_bit(exp, len, i)) {
+            pending_sqr++;
+            i--;
+            continue;
+        }
+        // 窗口 [low, i]，最低位必须为 1
+        lamp_si low = std::max<lamp_si>(i - lamp_si(window_) + 1, 0);
+        while (!get_bit(exp, len, low)) {
+            low++;
+        }
+        lamp_ui value = 0;
+        for (lamp_si j = i; j >= low; j--) {
+            value = (value << 1) | lamp_ui(get_bit(exp, len, j));
+        }
+        if (first) {
+            first_ = value;
+            first = false;
+        } else {
+            steps_.set(step_count_++, ((pending_sqr + lamp_ui(i - low + 1)) << 32) | value);
+            pending_sqr = 0;
+        }
+        i = low - 1;
+    }
+    if (pending_sqr > 0) {
+        steps_.set(step_count_++, pending_sqr << 32);
+    }
+}
+
+namespace {
+// 模 2^bits 的整数环，用于偶数模数的 2 幂部分
+class _pow2_ring {
+   private:
+    lamp_ui len_;
+    lamp_ui mask_;
+
+   public:
+    explicit _pow2_ring(lamp_ui bits)
+        : len_((bits + 63) / 64), mask_(bits % 64 == 0 ? ~lamp_ui(0) : (lamp_ui(1) << (bits % 64)) - 1) {}
+
+    lamp_ui size() const { return len_; }
+    lamp_ui workSize() const { return 2 * len_; }
+    void reduce(lamp_ptr in_out) const { in_out[len_ - 1] &= mask_; }
+
+    void mul(lamp_ptr a, lamp_ptr b, lamp_ptr out, lamp_ptr work) const {
+        abs_mul64(a, len_, b, len_, work);
+        std::copy(work, work + len_, out);
+        reduce(out);
+    }
+    void sqr(lamp_ptr a, lamp_ptr out, lamp_ptr work) const {
+        abs_sqr64(a, len_, work);
+        std::copy(work, work + len_, out);
+        reduce(out);
+    }
+};
+
+// 单字奇数模数的蒙哥马利乘法，全部内联，供多路交织使用
+class _mont64_ring {
+   private:
+    lamp_ui mod_;
+    lamp_ui mod_inv_neg_;
+    lamp_ui r_square_;
+
+   public:
+    explicit _mont64_ring(lamp_ui mod) : mod_(mod), mod_inv_neg_(lamp_ui(0) - inv_mod2pow(mod, 64)) {
+        lamp_ui r = (lamp_ui(0) - mod) % mod;  // 2^64 mod mod
+        lamp_ui lo, hi;
+        mul64x64to128(r, r, lo, hi);
+        div128by64to64(hi, lo, mod);
+        r_square_ = lo;
+    }
+
+    lamp_ui mul(lamp_ui a, lamp_ui b) const {
+        lamp_ui lo, hi, qm_lo, qm_hi;
+        mul64x64to128(a, b, lo, hi);
+        mul64x64to128(lo * mod_inv_neg_, mod_, qm_lo, qm_hi);
+        bool cf;
+        add_half(lo, qm_lo, cf);
+        lamp_ui res = add_carry(hi, qm_hi, cf);
+        if (cf || res >= mod_) {
+            res -= mod_;
+        }
+        return res;
+    }
+    lamp_ui toMont(lamp_ui a) const { return mul(a % mod_, r_square_); }
+    lamp_ui toInt(lamp_ui a) const { return mul(a, 1); }
+};
+
+// 单字奇数模数、共享指数时，每个线程同时推进 LANES 条互不依赖的平方乘链，使乘法流水线保持饱和
+constexpr lamp_ui POW_MOD_LANES = 4;
+
+void pow_mod_lanes(const _mont64_ring& ring, const PowWindowPlan& plan, const lamp_ui* bases, lamp_ui* outs) {
+    constexpr lamp_ui L = POW_MOD_LANES;
+    const lamp_ui table_size = plan.tableSize();
+    _internal_buffer<0> _table(table_size * L);
+    lamp_ptr table = _table.data();  // table[i * L + l] = base_l^(2i+1)
+    lamp_ui x[L];
+    for (lamp_ui l = 0; l < L; l++) {
+        table[l] = ring.toMont(bases[l]);
+        x[l] = ring.mul(table[l], table[l]);
+    }
+    for (lamp_ui i = 1; i < table_size; i++) {
+        for (lamp_ui l = 0; l < L; l++) {
+            table[i * L + l] = ring.mul(table[(i - 1) * L + l], x[l]);
+        }
+    }
+    for (lamp_ui l = 0; l < L; l++) {
+        x[l] = table[(plan.first() >> 1) * L + l];
+    }
+    for (lamp_ui i = 0; i < plan.stepCount(); i++) {
+        for (lamp_ui j = plan.sqrCount(i); j > 0; j--) {
+            for (lamp_ui l = 0; l < L; l++) {
+                x[l] = ring.mul(x[l], x[l]);
+            }
+        }
+        const lamp_ui digit = plan.digit(i);
+        if (digit != 0) {
+            for (lamp_ui l = 0; l < L; l++) {
+                x[l] = ring.mul(x[l], table[(digit >> 1) * L + l]);
+            }
+        }
+    }
+    for (lamp_ui l = 0; l < L; l++) {
+        outs[l] = ring.toInt(x[l]);
+    }
+}
+
+/*
+ * 共享模数的模幂引擎：模数分解、蒙哥马利上下文与 odd^-1 mod 2^s 只计算一次，
+ * pow 为 const 且临时空间由调用者提供，可被多个线程同时调用
+ */
+class _pow_mod_engine {
+   private:
+    lamp_ui mod_len_;
+    lamp_ui tz_;       // 模数末尾 0 的个数
+    lamp_ui odd_len_;  // 奇数部分的长度，奇数部分为 1 时为 0
+    _internal_buffer<0> storage_;
+    lamp_ptr odd_;      // 模数的奇数部分
+    lamp_ptr odd_inv_;  // odd^-1 mod 2^tz
+    std::unique_ptr<MontMultiCtx> ctx_;
+    std::unique_ptr<_pow2_ring> ring_;
+
+   public:
+    _pow_mod_engine(lamp_ptr mod, lamp_ui mod_len)
+        : mod_len_(mod_len), tz_(0), odd_len_(0), storage_(2 * mod_len, 0), odd_inv_(nullptr) {
+        assert(mod_len > 0 && mod[mod_len - 1] != 0);
+        while (mod[tz_ / 64] == 0) {
+            tz_ += 64;
+        }
+        tz_ += lammp_ctz(mod[tz_ / 64]);
+        odd_ = storage_.data();
+        rshift_bits(mod, mod_len, odd_, tz_);
+        odd_len_ = rlz(odd_, mod_len);
+        if (odd_len_ == 1 && odd_[0] == 1) {
+            odd_len_ = 0;
+        }
+        if (odd_len_ > 0) {
+            ctx_.reset(new MontMultiCtx(odd_, odd_len_));
+        }
+        if (tz_ > 0) {
+            ring_.reset(new _pow2_ring(tz_));
+            if (odd_len_ > 0) {
+                // 2^tz 不超过模数，odd^-1 的字长不超过 mod_len
+                odd_inv_ = odd_ + mod_len;
+                inv_mod_2pow64(odd_, odd_len_, odd_inv_, ring_->size());
+                ring_->reduce(odd_inv_);
+            }
+        }
+    }
+
+    lamp_ui modLen() const { return mod_len_; }
+    // 单字奇数模数，可使用多路交织
+    bool isSingleOdd() const { return tz_ == 0 && odd_len_ == 1; }
+    lamp_ui oddWord() const { return odd_[0]; }
+
+    lamp_ui scratchSize(const PowWindowPlan& plan) const {
+        const lamp_ui ts = plan.tableSize();
+        lamp_ui size = 0;
+        if (ctx_) {
+            size += ctx_->workSize() + (ts + 2) * odd_len_;
+        }
+        if (ring_) {
+            const lamp_ui n2 = ring_->size();
+            size += ring_->workSize() + (ts + 4) * n2 + odd_len_ + n2;
+        }
+        return size;
+    }
+
+    // out 至少 modLen() 个字，scratch 至少 scratchSize(plan) 个字
+    lamp_ui pow(lamp_ptr base, lamp_ui base_len, const PowWindowPlan& plan, lamp_ptr out, lamp_ptr scratch) const {
+        base_len = rlz(base, base_len);
+        std::fill(out, out + mod_len_, lamp_ui(0));
+        const lamp_ui ts = plan.tableSize();
+        lamp_ptr r1 = nullptr;
+        if (ctx_) {
+            // r1 = base^exp mod odd
+            const lamp_ui n = odd_len_;
+            lamp_ptr work = scratch, b = work + ctx_->workSize(), table = b + n;
+            r1 = table + ts * n;
+            scratch = r1 + n;
+            ctx_->toMont(base, base_len, b, work);
+            pow_window_exec(*ctx_, plan, b, table, r1, work);
+            ctx_->toInt(r1, r1, work);
+            if (!ring_) {
+                std::copy(r1, r1 + n, out);
+                return rlz(out, mod_len_);
+            }
+        }
+        // r2 = base^exp mod 2^tz
+        const lamp_ui n2 = ring_->size();
+        lamp_ptr work = scratch, b = work + ring_->workSize(), table = b + n2, r2 = table + ts * n2;
+        lamp_ptr diff = r2 + n2, h = diff + n2, prod = h + n2;
+        std::fill(b, b + n2, lamp_ui(0));
+        std::copy(base, base + std::min(base_len, n2), b);
+        ring_->reduce(b);
+        pow_window_exec(*ring_, plan, b, table, r2, work);
+        if (!ctx_) {
+            std::copy(r2, r2 + n2, out);
+            return rlz(out, mod_len_);
+        }
+        // h = (r2 - r1) * odd^-1 mod 2^tz，out = r1 + odd * h < mod
+        abs_sub_binary(r2, n2, r1, std::min(odd_len_, n2), diff);
+        ring_->reduce(diff);
+        ring_->mul(diff, odd_inv_, h, work);
+        const lamp_ui prod_len = odd_len_ + n2;
+        abs_mul64(odd_, odd_len_, h, n2, prod);
+        abs_add_binary_half(prod, prod_len, r1, odd_len_, prod);
+        std::copy(prod, prod + std::min(prod_len, mod_len_), out);
+        return rlz(out, mod_len_);
+    }
+};
+}  // namespace
+
+/*
+ * @brief 计算 base^exp mod mod
+ * @details 底数只在进入蒙哥马利域前约化一次，循环内不做除法。
+ *          奇数模数直接使用 MontMultiCtx；偶数模数 mod = odd * 2^s，
+ *          分别求 r1 = base^exp mod odd 与 r2 = base^exp mod 2^s（两者共用同一指数计划），
+ *          再由 x = r1 + odd * ((r2 - r1) * odd^-1 mod 2^s) 合并
+ * @param out 结果，至少 mod_len 个字
+ * @return 结果的有效长度
+ */
+lamp_ui abs_pow_mod64(lamp_ptr base,
+                      lamp_ui base_len,
+                      lamp_ptr exp,
+                      lamp_ui exp_len,
+                      lamp_ptr mod,
+                      lamp_ui mod_len,
+                      lamp_ptr out) {
+    assert(base != nullptr && exp != nullptr && mod != nullptr && out != nullptr);
+    mod_len = rlz(mod, mod_len);
+    exp_len = rlz(exp, exp_len);
+    assert(mod_len > 0);
+    std::fill(out, out + mod_len, lamp_ui(0));
+    if (mod_len == 1 && mod[0] == 1) {
+        return 0;
+    }
+    if (exp_len == 0) {
+        out[0] = 1;
+        return 1;
+    }
+    const PowWindowPlan plan(exp, exp_len);
+    const _pow_mod_engine engine(mod, mod_len);
+    _internal_buffer<0> _scratch(engine.scratchSize(plan));
+    return engine.pow(base, base_len, plan, out, _scratch.data());
+}
+
+/*
+ * @brief 共享模数的批量模幂：outs[i] = bases[i]^exps[i] mod mod
+ * @details 模数相关的预计算（蒙哥马利上下文、odd^-1 mod 2^s）只做一次；
+ *          exp_count 为 1 时所有底数共用 exps[0]，滑动窗口计划也只构造一次。
+ *          底数按块分配到全局线程池，每块只申请一次临时空间；
+ *          单字奇数模数且共享指数时，每个线程以 POW_MOD_LANES 路交织推进。
+ * @param outs 每个结果至少 mod_len 个字
+ * @param out_lens 结果的有效长度，可以为 nullptr
+ */
+void abs_pow_mod64_batch(lamp_ptr* bases,
+                         const lamp_ui* base_lens,
+                         lamp_ui count,
+                         lamp_ptr* exps,
+                         const lamp_ui* exp_lens,
+                         lamp_ui exp_count,
+                         lamp_ptr mod,
+                         lamp_ui mod_len,
+                         lamp_ptr* outs,
+                         lamp_ui* out_lens) {
+    assert(bases != nullptr && exps != nullptr && mod != nullptr && outs != nullptr);
+    assert(exp_count == 1 || exp_count == count);
+    mod_len = rlz(mod, mod_len);
+    assert(mod_len > 0);
+    if (count == 0) {
+        return;
+    }
+    const bool shared_exp = exp_count == 1;
+    const bool trivial_mod = mod_len == 1 && mod[0] == 1;
+    const _pow_mod_engine engine(mod, mod_len);
+
+    // 共享指数时计划只构造一次，否则每个底数各自构造
+    std::unique_ptr<PowWindowPlan> shared_plan;
+    if (shared_exp && rlz(exps[0], exp_lens[0]) > 0) {
+        shared_plan.reset(new PowWindowPlan(exps[0], exp_lens[0]));
+    }
+    auto trivial = [&](lamp_ui i) -> bool {
+        const lamp_ui e_len = shared_exp ? exp_lens[0] : exp_lens[i];
+        lamp_ptr e = shared_exp ? exps[0] : exps[i];
+        if (!trivial_mod && rlz(e, e_len) > 0) {
+            return false;
+        }
+        std::fill(outs[i], outs[i] + mod_len, lamp_ui(0));
+        outs[i][0] = trivial_mod ? 0 : 1;
+        if (out_lens != nullptr) {
+            out_lens[i] = trivial_mod ? 0 : 1;
+        }
+        return true;
+    };
+    auto single = [&](lamp_ui i, lamp_ptr scratch, const PowWindowPlan& plan) {
+        const lamp_ui len = engine.pow(bases[i], base_lens[i], plan, outs[i], scratch);
+        if (out_lens != nullptr) {
+            out_lens[i] = len;
+        }
+    };
+
+    ThreadPool& pool = ThreadPool::global();
+    const bool use_lanes = shared_plan && engine.isSingleOdd();
+    const lamp_ui unit = use_lanes ? POW_MOD_LANES : 1;
+    const lamp_ui units = (count + unit - 1) / unit;
+    const lamp_ui chunks = std::min<lamp_ui>(units, pool.concurrency() * 4);
+    const lamp_ui units_per_chunk = (units + chunks - 1) / chunks;
+
+    pool.parallelFor(chunks, [&](size_t chunk) {
+        const lamp_ui begin = std::min(count, chunk * units_per_chunk * unit);
+        const lamp_ui end = std::min(count, begin + units_per_chunk * unit);
+        if (use_lanes) {
+            const _mont64_ring ring(engine.oddWord());
+            lamp_ui i = begin;
+            for (; i + POW_MOD_LANES <= end; i += POW_MOD_LANES) {
+                lamp_ui in[POW_MOD_LANES], res[POW_MOD_LANES];
+                for (lamp_ui l = 0; l < POW_MOD_LANES; l++) {
+                    // 多字底数先约化到单字
+                    const lamp_ui b_len = rlz(bases[i + l], base_lens[i + l]);
+                    in[l] = b_len == 0 ? 0 : bases[i + l][0];
+                    if (b_len > 1) {
+                        lamp_ui m = engine.oddWord();
+                        abs_mod64(bases[i + l], b_len, &m, 1, &in[l]);
+                    }
+                }
+                pow_mod_lanes(ring, *shared_plan, in, res);
+                for (lamp_ui l = 0; l < POW_MOD_LANES; l++) {
+                    outs[i + l][0] = res[l];
+                    if (out_lens != nullptr) {
+                        out_lens[i + l] = res[l] != 0 ? 1 : 0;
+                    }
+                }
+            }
+            if (i < end) {
+                _internal_buffer<0> _scratch(engine.scratchSize(*shared_plan));
+                for (; i < end; i++) {
+                    single(i, _scratch.data(), *shared_plan);
+                }
+            }
+            return;
+        }
+        if (shared_plan || shared_exp) {
+            if (!shared_plan) {
+                // 指数为零或模数为一，结果与底数无关
+                for (lamp_ui i = begin; i < end; i++) {
+                    trivial(i);
+                }
+                return;
+            }
+            _internal_buffer<0> _scratch(engine.scratchSize(*shared_plan));
+            for (lamp_ui i = begin; i < end; i++) {
+                if (!trivial(i)) {
+                    single(i, _scratch.data(), *shared_plan);
+                }
+            }
+            return;
+        }
+        _internal_buffer<0> _scratch(0);
+        for (lamp_ui i = begin; i < end; i++) {
+            if (trivial(i)) {
+                continue;
+            }
+            const PowWindowPlan plan(exps[i], exp_lens[i]);
+            const lamp_ui size = engine.scratchSize(plan);
+            if (size > _scratch.capacity()) {
+                _scratch = _internal_buffer<0>(size);
+            }
+            single(i, _scratch.data(), plan);
+        }
+    });
+}
+
+};  // namespace lammp::Arithmetic
@@ -0,0 +1,125 @@
+/*
+ * Copyright (C) 2025 HJimmyK/LAMINA
+ *
+ * This file is part of LAMMP, which is licensed under the GNU LGPL v2.1.
+ * See the LICENSE file in the project root for full license details, or visit:
+ * <https://www.gnu.org/licenses/old-licenses/lgpl-2.1.html>
+ */
+
+#include <algorithm>
+
+#include "../../../../include/lammp/prod_tree.hpp"
+#include "../../../../include/lammp/thread_pool.hpp"
+
+namespace lammp::Arithmetic {
+
+ProductTree::ProductTree(lamp_ptr* factors, const lamp_ui* lens, lamp_ui count, lamp_ui limit_len) : levels_(1) {
+    assert(count > 0);
+    levels_[0].ptr.assign(factors, factors + count);
+    levels_[0].len.resize(count);
+    for (lamp_ui i = 0; i < count; i++) {
+        levels_[0].len[i] = rlz(factors[i], lens[i]);
+        assert(levels_[0].len[i] > 0);
+    }
+    while (levels_.back().ptr.size() > 1) {
+        const std::vector<lamp_ui>& len = levels_.back().len;
+        if (limit_len != 0 && 2 * *std::max_element(len.begin(), len.end()) > limit_len) {
+            break;
+        }
+        buildLevel();
+    }
+}
+
+void ProductTree::buildLevel() {
+    levels_.emplace_back();
+    const Level& low = levels_[levels_.size() - 2];
+    Level& high = levels_.back();
+    const lamp_ui low_count = low.ptr.size();
+    const lamp_ui count = (low_count + 1) / 2;
+    high.ptr.resize(count);
+    high.len.resize(count);
+    std::vector<lamp_ui> offset(count + 1, 0);
+    for (lamp_ui i = 0; i < count; i++) {
+        const lamp_ui cap = 2 * i + 1 < low_count ? low.len[2 * i] + low.len[2 * i + 1] : 0;
+        offset[i + 1] = offset[i] + cap;
+    }
+    high.storage = _internal_buffer<0>(std::max<lamp_ui>(offset[count], 1));
+    ThreadPool::global().parallelFor(count, [&](size_t i) {
+        if (2 * i + 1 == low_count) {
+            // 落单的结点直接升上来
+            high.ptr[i] = low.ptr[2 * i];
+            high.len[i] = low.len[2 * i];
+            return;
+        }
+        const lamp_ptr out = high.storage.data() + offset[i];
+        const lamp_ui out_len = low.len[2 * i] + low.len[2 * i + 1];
+        abs_mul64(low.ptr[2 * i], low.len[2 * i], low.ptr[2 * i + 1], low.len[2 * i + 1], out);
+        high.ptr[i] = out;
+        high.len[i] = rlz(out, out_len);
+    });
+}
+
+void ProductTree::remainders(lamp_ptr in, lamp_ui len, lamp_ptr* outs, lamp_ui* out_lens, bool squared) const {
+    assert(in != nullptr || len == 0);
+    len = len == 0 ? 0 : rlz(in, len);
+    const lamp_ui mul = squared ? 2 : 1;
+    // rem_ptr[i] 为当前层结点 i 的余数，容量为结点长度（squared 时为两倍）；叶子层的余数直接写到输出
+    _internal_buffer<0> rem;
+    std::vector<lamp_ptr> rem_ptr;
+    std::vector<lamp_ui> rem_len;
+    for (size_t level = levels_.size(); level > 0; level--) {
+        const Level& node = levels_[level - 1];
+        const lamp_ui node_count = node.ptr.size();
+        std::vector<lamp_ptr> node_rem_ptr(node_count);
+        std::vector<lamp_ui> node_rem_len(node_count);
+        _internal_buffer<0> node_rem;
+        if (level > 1) {
+            lamp_ui total = 0;
+            for (lamp_ui i = 0; i < node_count; i++) {
+                total += mul * node.len[i];
+            }
+            node_rem = _internal_buffer<0>(total);
+            total = 0;
+            for (lamp_ui i = 0; i < node_count; i++) {
+                node_rem_ptr[i] = node_rem.data() + total;
+                total += mul * node.len[i];
+            }
+        } else {
+            std::copy(outs, outs + node_count, node_rem_ptr.begin());
+        }
+        const bool top = level == levels_.size();
+        ThreadPool::global().parallelFor(node_count, [&](size_t i) {
+            // 最上层直接对 in 取模，其余由父结点的余数取模
+            const lamp_ptr parent = top ? in : rem_ptr[i / 2];
+            const lamp_ui parent_len = top ? len : rem_len[i / 2];
+            if (parent_len == 0) {
+                node_rem_len[i] = 0;
+                return;
+            }
+            if (!squared) {
+                node_rem_len[i] = abs_mod64(parent, parent_len, node.ptr[i], node.len[i], node_rem_ptr[i]);
+                return;
+            }
+            // parent 不超过 2 * len - 2 个字时必小于结点的平方，不必求平方
+            if (parent_len + 2 <= 2 * node.len[i]) {
+                std::copy(parent, parent + parent_len, node_rem_ptr[i]);
+                node_rem_len[i] = parent_len;
+                return;
+            }
+            _internal_buffer<0> sq(2 * node.len[i]);
+            abs_sqr64(node.ptr[i], node.len[i], sq.data());
+            node_rem_len[i] = abs_mod64(parent, parent_len, sq.data(), 2 * node.len[i], node_rem_ptr[i]);
+        });
+        rem = std::move(node_rem);
+        rem_ptr = std::move(node_rem_ptr);
+        rem_len = std::move(node_rem_len);
+    }
+    for (lamp_ui i = 0; i < levels_[0].ptr.size(); i++) {
+        std::fill(outs[i] + rem_len[i], outs[i] + mul * levels_[0].len[i], 0);
+        if (out_lens != nullptr) {
+            out_lens[i] = rem_len[i];
+        }
+    }
+}
+
+};  // namespace lammp::Arithmetic
@@ -39,6 +39,8 @@ SOFTWARE.
 #include "../../../../include/lammp/lammp.hpp"
 #include "../../../../include/lammp/base_cal.hpp"
 #include "../../../../include/lammp/inter_buffer.hpp"
+#include "../../../../include/lammp/mat22.hpp"
+#include "../../../../include/lammp/thread_pool.hpp"
 #include <assert.h>
 
 uint64_t self_div_rem(u192 in, uint64_t divisor) {
@@ -336,9 +338,17 @@ void abs_mul64_ntt_unbalanced(lamp_ptr in1, lamp_ui len1, lamp_ptr in2, lamp_ui
     assert(in1 != NULL && in2 != NULL && out != NULL);
     assert(in1 != in2 && len1 > len2);
 
+    // 结果按块写出时 in1 还未读完，out 与 in1 重叠时先复制 in1
+    _internal_buffer<0> in1_copy(0);
+    if (out < in1 + len1 && in1 < out + len1 + len2) {
+        in1_copy.resize(len1);
+        std::copy(in1, in1 + len1, in1_copy.data());
+        in1 = in1_copy.data();
+    }
+
     lamp_ui min_sum = len2 + std::max(len2, M);
 
-    min_sum -= ((min_sum & (min_sum - 1)) == 0) ? len1 : 0;
+    min_sum -= ((min_sum & (min_sum - 1)) == 0) ? 1 : 0;
 
     int highest_bit = 63 - lammp_clz(min_sum);
     uint64_t next_power = 1ULL << (highest_bit + 1);
@@ -515,4 +525,261 @@ void abs_mul64_ntt_unbalanced(lamp_ptr in1, lamp_ui len1, lamp_ptr in2, lamp_ui
     }
 }
 
+namespace {
+
+/*
+ * 2x2 矩阵乘法在单个模数上的变换域计算，ta、tb 各为 4 个长 ntt_len 的缓冲区，结果写回 ta
+ * 负元素在变换前取模意义下的相反数，变换域中的和即为带符号的卷积
+ */
+#define define_mat22_conv(_i)                                                                                \
+    void mat22_conv_##_i(const Mat22& a, const Mat22& b, bool sqr, mont64** ta, mont64** tb, ntt_short* table, \
+                         size_t ntt_len) {                                                                   \
+        cover_nttshort_func(table->log_len, table, _i);                                                      \
+        ThreadPool::global().parallelFor(sqr ? 4 : 8, [&](size_t k) {                                         \
+            const Mat22& m = k < 4 ? a : b;                                                                  \
+            mont64* t = k < 4 ? ta[k] : tb[k - 4];                                                           \
+            const lamp_ui len = m.len[k % 4];                                                                \
+            for (size_t ii = 0; ii < len; ii++) {                                                            \
+                t[ii] = m.ptr[k % 4][ii];                                                                    \
+                _mont64_tomont_func(t[ii], _i);                                                              \
+                if (m.neg[k % 4] && t[ii] != 0) {                                                            \
+                    t[ii] = g_mod(_i) - t[ii];                                                               \
+                }                                                                                            \
+            }                                                                                                \
+            std::fill(t + len, t + ntt_len, mont64(0));                                                      \
+            ntt_dif_long_func(t, table, ntt_len, _i);                                                        \
+        });                                                                                                  \
+        for (size_t ii = 0; ii < ntt_len; ii++) {                                                            \
+            mont64 a0 = ta[0][ii], a1 = ta[1][ii], a2 = ta[2][ii], a3 = ta[3][ii], p0, p1;                   \
+            if (sqr) {                                                                                       \
+                mont64 bc, s;                                                                                \
+                _mont64_mul_func(bc, a1, a2, _i);                                                            \
+                _mont64_add_func(s, a0, a3, _i);                                                             \
+                _mont64_mul_func(p0, a0, a0, _i);                                                            \
+                _mont64_add_func(ta[0][ii], p0, bc, _i);                                                     \
+                _mont64_mul_func(ta[1][ii], a1, s, _i);                                                      \
+                _mont64_mul_func(ta[2][ii], a2, s, _i);                                                      \
+                _mont64_mul_func(p0, a3, a3, _i);                                                            \
+                _mont64_add_func(ta[3][ii], p0, bc, _i);                                                     \
+                continue;                                                                                    \
+            }                                                                                                \
+            const mont64 b0 = tb[0][ii], b1 = tb[1][ii], b2 = tb[2][ii], b3 = tb[3][ii];                     \
+            _mont64_mul_func(p0, a0, b0, _i);                                                                \
+            _mont64_mul_func(p1, a1, b2, _i);                                                                \
+            _mont64_add_func(ta[0][ii], p0, p1, _i);                                                         \
+            _mont64_mul_func(p0, a0, b1, _i);                                                                \
+            _mont64_mul_func(p1, a1, b3, _i);                                                                \
+            _mont64_add_func(ta[1][ii], p0, p1, _i);                                                         \
+            _mont64_mul_func(p0, a2, b0, _i);                                                                \
+            _mont64_mul_func(p1, a3, b2, _i);                                                                \
+            _mont64_add_func(ta[2][ii], p0, p1, _i);                                                         \
+            _mont64_mul_func(p0, a2, b1, _i);                                                                \
+            _mont64_mul_func(p1, a3, b3, _i);                                                                \
+            _mont64_add_func(ta[3][ii], p0, p1, _i);                                                         \
+        }                                                                                                    \
+        ThreadPool::global().parallelFor(4, [&](size_t k) { ntt_idit_long_func(ta[k], table, ntt_len, _i); });  \
+    }
+
+define_mat22_conv(1)
+define_mat22_conv(2)
+define_mat22_conv(3)
+
+#undef define_mat22_conv
+
+// 带符号的 crt3：结果大于 mod123 / 2 时视为负数，以 192 位补码表示
+inline void crt3_signed(mont64 a, mont64 b, mont64 c, u192 res) {
+    static const u192 mod123 = {8610882487532388353ull, 1266215182732886016ull, 59403314713853952ull};
+    static const u192 half = {(mod123[0] >> 1) | (mod123[1] << 63), (mod123[1] >> 1) | (mod123[2] << 63),
+                              mod123[2] >> 1};
+    crt3(a, b, c, res);
+    if (_u192cmp(half, res)) {
+        _u192sub(res, mod123);
+    }
+}
+
+/*
+ * 单个模数上长为 ntt_len 的循环卷积平方，不补零；
+ * 负循环时先乘 psi^j、平方后再乘 psi^-j，psi 为 2 * ntt_len 次单位根
+ */
+#define define_sqr_wrap(_i)                                                                       \
+    void sqr_wrap_##_i(mont64* buf, ntt_short* table, size_t ntt_len, bool negacyclic) {          \
+        cover_nttshort_func(table->log_len, table, _i);                                           \
+        for (size_t ii = 0; ii < ntt_len; ii++) {                                                 \
+            _mont64_tomont_func(buf[ii], _i);                                                     \
+        }                                                                                         \
+        mont64 psi = g_root(_i), psi_inv = g_rootinv(_i), w = g_one(_i);                          \
+        if (negacyclic) {                                                                         \
+            _mont64_tomont_func(psi, _i);                                                         \
+            psi = _mont64_qpow_func_name(_i)(psi, (g_mod(_i) - 1) / (ntt_len * 2));               \
+            _mont64_tomont_func(psi_inv, _i);                                                     \
+            psi_inv = _mont64_qpow_func_name(_i)(psi_inv, (g_mod(_i) - 1) / (ntt_len * 2));       \
+            for (size_t ii = 0; ii < ntt_len; ii++) {                                             \
+                _mont64_mulinto_func(buf[ii], w, _i);                                             \
+                _mont64_mulinto_func(w, psi, _i);                                                 \
+            }                                                                                     \
+        }                                                                                         \
+        conv_sqr_func(buf, buf, table, ntt_len, _i);                                              \
+        if (negacyclic) {                                                                         \
+            w = g_one(_i);                                                                        \
+            for (size_t ii = 0; ii < ntt_len; ii++) {                                             \
+                _mont64_mulinto_func(buf[ii], w, _i);                                             \
+                _mont64_mulinto_func(w, psi_inv, _i);                                             \
+            }                                                                                     \
+        }                                                                                         \
+    }
+
+define_sqr_wrap(1)
+define_sqr_wrap(2)
+define_sqr_wrap(3)
+
+#undef define_sqr_wrap
+
+// 192 位数右移 bits（1 <= bits <= 64）位，signed 时为算术右移
+inline void u192_shr(u192 x, lamp_ui bits, bool signed_shift) {
+    const lamp_ui fill = signed_shift && lamp_si(x[2]) < 0 ? ~lamp_ui(0) : 0;
+    if (bits == 64) {
+        x[0] = x[1];
+        x[1] = x[2];
+        x[2] = fill;
+        return;
+    }
+    x[0] = (x[0] >> bits) | (x[1] << (64 - bits));
+    x[1] = (x[1] >> bits) | (x[2] << (64 - bits));
+    x[2] = (x[2] >> bits) | (fill << (64 - bits));
+}
+
+};  // namespace
+
+void mat22_mul_ntt(const Mat22& a, const Mat22& b, Mat22& c) {
+    const bool sqr = &a == &b;
+    const lamp_ui len_a = *std::max_element(a.len, a.len + 4), len_b = *std::max_element(b.len, b.len + 4);
+    assert(len_a > 0 && len_b > 0);
+    // 每个系数至多为两个乘积之和，远小于 mod123 / 2，可以带符号地还原
+    const lamp_ui conv_len = len_a + len_b - 1, out_len = conv_len + 2;
+    const lamp_ui ntt_len = int_ceil2(conv_len);
+
+    ntt_short table;
+    table.ntt_len = (ntt_len < long_threshold) ? ntt_len : long_threshold;
+    table.log_len = log2_64(table.ntt_len);
+    _internal_buffer<0, MONT64BIT> table_buf1(table.ntt_len);
+    _internal_buffer<0, MONT64BIT> table_buf2(table.ntt_len);
+    table.omega = table_buf1.data();
+    table.iomega = table_buf2.data();
+
+    // 三个模数上的结果各占 4 个缓冲区，b 的变换在模数之间复用
+    _internal_buffer<0, MONT64BIT> res_buf(ntt_len * 12), b_buf(sqr ? 0 : ntt_len * 4);
+    mont64* res[3][4];
+    mont64* tb[4];
+    for (size_t k = 0; k < 4; k++) {
+        res[0][k] = res_buf.data() + ntt_len * k;
+        res[1][k] = res_buf.data() + ntt_len * (k + 4);
+        res[2][k] = res_buf.data() + ntt_len * (k + 8);
+        tb[k] = sqr ? nullptr : b_buf.data() + ntt_len * k;
+    }
+    mat22_conv_1(a, b, sqr, res[0], tb, &table, ntt_len);
+    mat22_conv_2(a, b, sqr, res[1], tb, &table, ntt_len);
+    mat22_conv_3(a, b, sqr, res[2], tb, &table, ntt_len);
+
+    ThreadPool::global().parallelFor(4, [&](size_t k) {
+        lamp_ptr out = c.ptr[k];
+        u192 carry = {0, 0, 0};
+        for (size_t ii = 0; ii < conv_len; ii++) {
+            u192 temp = {0, 0, 0};
+            crt3_signed(res[0][k][ii], res[1][k][ii], res[2][k][ii], temp);
+            _u192add(carry, temp);
+            out[ii] = carry[0];
+            carry[0] = carry[1];
+            carry[1] = carry[2];
+            carry[2] = lamp_si(carry[2]) < 0 ? ~lamp_ui(0) : 0;
+        }
+        out[conv_len] = carry[0];
+        out[conv_len + 1] = carry[1];
+        // 补码取反
+        c.neg[k] = lamp_si(carry[1]) < 0;
+        if (c.neg[k]) {
+            lamp_ui borrow = 1;
+            for (size_t ii = 0; ii < out_len; ii++) {
+                out[ii] = ~out[ii] + borrow;
+                borrow = borrow && out[ii] == 0;
+            }
+        }
+        c.len[k] = rlz(out, out_len);
+        c.neg[k] = c.neg[k] && c.len[k] > 0;
+    });
+}
+
+/*
+ * x^2 mod (2^n - 1) 或 (2^n + 1)，n = bits * ntt_len：x 拆成 ntt_len 个 bits 位的数字，
+ * 2^n 恰好是卷积回绕的位置，循环（负循环）卷积直接得到回绕后的系数，变换长度不必翻倍，也不需要单独的归约
+ * 三个模数并行计算；进位时把每个系数的低 bits 位写入对应数字，最后的进位 C 回绕到最低位（负循环时取反）
+ */
+void abs_sqr64_ntt_wrap(lamp_ptr in, lamp_ui len, lamp_ui bits, lamp_ui ntt_len, bool negacyclic, lamp_ptr out) {
+    assert(in != NULL && out != NULL);
+    assert(bits > 0 && bits <= 64 && (ntt_len & (ntt_len - 1)) == 0 && bits * ntt_len > 128);
+    const lamp_ui mask = bits == 64 ? ~lamp_ui(0) : (lamp_ui(1) << bits) - 1;
+    const lamp_ui out_len = bits * ntt_len / 64 + 3;
+    assert(bit_length(in, len) <= bits * ntt_len);
+
+    _internal_buffer<0, MONT64BIT> buf(ntt_len * 3);
+    mont64* bufs[3] = {buf.data(), buf.data() + ntt_len, buf.data() + ntt_len * 2};
+    for (size_t ii = 0; ii < ntt_len; ii++) {
+        const lamp_ui pos = ii * bits, word = pos / 64, shift = pos % 64;
+        lamp_ui digit = word < len ? in[word] >> shift : 0;
+        if (shift != 0 && shift + bits > 64 && word + 1 < len) {
+            digit |= in[word + 1] << (64 - shift);
+        }
+        bufs[0][ii] = bufs[1][ii] = bufs[2][ii] = digit & mask;
+    }
+
+    ntt_short tables[3];
+    _internal_buffer<0, MONT64BIT> table_buf(std::min<lamp_ui>(ntt_len, long_threshold) * 6);
+    for (size_t k = 0; k < 3; k++) {
+        tables[k].ntt_len = (ntt_len < long_threshold) ? ntt_len : long_threshold;
+        tables[k].log_len = log2_64(tables[k].ntt_len);
+        tables[k].omega = table_buf.data() + tables[k].ntt_len * (k * 2);
+        tables[k].iomega = table_buf.data() + tables[k].ntt_len * (k * 2 + 1);
+    }
+    ThreadPool::global().parallelFor(3, [&](size_t k) {
+        if (k == 0) {
+            sqr_wrap_1(bufs[0], &tables[0], ntt_len, negacyclic);
+        } else if (k == 1) {
+            sqr_wrap_2(bufs[1], &tables[1], ntt_len, negacyclic);
+        } else {
+            sqr_wrap_3(bufs[2], &tables[2], ntt_len, negacyclic);
+        }
+    });
+
+    std::fill(out, out + out_len, lamp_ui(0));
+    u192 carry = {0, 0, 0};
+    for (size_t ii = 0; ii < ntt_len; ii++) {
+        u192 temp = {0, 0, 0};
+        if (negacyclic) {
+            crt3_signed(bufs[0][ii], bufs[1][ii], bufs[2][ii], temp);
+        } else {
+            crt3(bufs[0][ii], bufs[1][ii], bufs[2][ii], temp);
+        }
+        _u192add(carry, temp);
+        const lamp_ui digit = carry[0] & mask, pos = ii * bits, word = pos / 64, shift = pos % 64;
+        out[word] |= digit << shift;
+        if (shift != 0 && shift + bits > 64) {
+            out[word + 1] |= digit >> (64 - shift);
+        }
+        u192_shr(carry, bits, negacyclic);
+    }
+    // 循环：+C；负循环：-C，C > 0 时先加上 2^n + 1 使结果非负（C < 2^128 < 2^n）
+    lamp_ui c[2] = {carry[0], carry[1]};
+    if (!negacyclic || lamp_si(carry[2]) < 0) {
+        if (negacyclic) {
+            c[0] = ~c[0] + 1;
+            c[1] = ~c[1] + (c[0] == 0);
+        }
+        abs_add_binary(out, out_len - 1, c, 2, out);
+        return;
+    }
+    lamp_ui one = 1;
+    set_bit(out, out_len, bits * ntt_len);
+    abs_add_binary(out, out_len - 1, &one, 1, out);
+    abs_sub_binary(out, out_len, c, 2, out);
+}
+
 };   // namespace lammp::Arithmetic
\ No newline at end of file
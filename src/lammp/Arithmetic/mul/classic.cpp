@@ -163,6 +163,7 @@ void abs_mul64_classic(lamp_ptr in1,
     }
     if (1 == len2) {
         abs_mul_add_num64(in1, len1, out, 0, in2[0]);
+        std::fill(out + len1 + 1, out + out_len, lamp_ui(0));
         return;
     }
     // Get enough work memory
@@ -183,4 +184,48 @@ void abs_mul64_classic(lamp_ptr in1,
     std::copy(out_temp, out_temp + work_size, out);
     std::fill(out + work_size, out + out_len, lamp_ui(0));
 }
+
+// 朴素平方，交叉项只计算一次再左移一位，乘法次数约为朴素乘法的一半
+void abs_sqr64_classic(lamp_ptr in, lamp_ui len, lamp_ptr out, lamp_ptr work_begin, lamp_ptr work_end) {
+    const lamp_ui out_len = len * 2;
+    len = rlz(in, len);
+    if (0 == len || nullptr == in) {
+        std::fill_n(out, out_len, lamp_ui(0));
+        return;
+    }
+    if (1 == len) {
+        lamp_ui lo, hi;
+        mul64x64to128(in[0], in[0], lo, hi);
+        out[0] = lo;
+        out[1] = hi;
+        std::fill(out + 2, out + out_len, lamp_ui(0));
+        return;
+    }
+    // Get enough work memory
+    _internal_buffer<0> work_mem(0);
+    const lamp_ui work_size = len * 2;
+    if (work_begin + work_size > work_end) {
+        work_mem.resize(work_size);
+        work_begin = work_mem.data();
+        work_end = work_begin + work_mem.capacity();
+    }
+    std::fill_n(work_begin, work_size, lamp_ui(0));
+    auto out_temp = work_begin;
+    // 交叉项 sum(in[i] * in[j] * B^(i+j)), i < j
+    for (lamp_ui i = 0; i < len - 1; i++) {
+        mul64_sub_proc(in + i + 1, len - i - 1, out_temp + 2 * i + 1, in[i]);
+    }
+    // 交叉项乘二
+    lshift_in_word_half(out_temp, work_size, out_temp, 1);
+    // 加上对角项 in[i]^2 * B^(2i)
+    bool carry = false;
+    for (lamp_ui i = 0; i < len; i++) {
+        lamp_ui lo, hi;
+        mul64x64to128(in[i], in[i], lo, hi);
+        out_temp[2 * i] = add_carry(out_temp[2 * i], lo, carry);
+        out_temp[2 * i + 1] = add_carry(out_temp[2 * i + 1], hi, carry);
+    }
+    std::copy(out_temp, out_temp + work_size, out);
+    std::fill(out + work_size, out + out_len, lamp_ui(0));
+}
 }; // namespace lammp::Arithmetic
\ No newline at end of file
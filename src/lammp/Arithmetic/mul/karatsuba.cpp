@@ -167,4 +167,66 @@ void abs_mul64_karatsuba(lamp_ptr in1, lamp_ui len1, lamp_ptr in2, lamp_ui len2,
     abs_mul64_karatsuba_buffered(in1, len1, in2, len2, out, nullptr, nullptr);
 }
 
+// Karatsuba 平方
+void abs_sqr64_karatsuba_buffered(lamp_ptr in, lamp_ui len, lamp_ptr out, lamp_ptr buffer_begin, lamp_ptr buffer_end) {
+    const lamp_ui out_len = len * 2;
+    len = rlz(in, len);
+    if (0 == len || nullptr == in) {
+        std::fill_n(out, out_len, lamp_ui(0));
+        return;
+    }
+    if (len < KARATSUBA_MIN_THRESHOLD) {
+        abs_sqr64_classic(in, len, out, buffer_begin, buffer_end);
+        std::fill(out + len * 2, out + out_len, lamp_ui(0));
+        return;
+    }
+    // Split A^2 -> (AH * BASE + AL)^2
+    // Let M = AL^2,
+    //     N = AH^2,
+    //     K = (AH - AL)^2
+    //       = AH^2 - 2 * AH * AL + AL^2
+    //
+    // A^2 = N * BASE^2 + (M + N - K) * BASE + M
+    const lamp_ui base_len = (len + 1) / 2;
+    const lamp_ui len_low = base_len, len_high = len - base_len;
+
+    lamp_ui m_len = len_low * 2;
+    lamp_ui n_len = len_high * 2;
+
+    // Get enough buffer
+    _internal_buffer<0> buffer(0);
+    const lamp_ui buffer_size = m_len + n_len + len_low + m_len;
+    if (buffer_begin + buffer_size > buffer_end) {
+        buffer.resize(buffer_size * 2 + 1);
+        buffer_begin = buffer.data();
+        buffer_end = buffer_begin + buffer.capacity();
+    }
+    auto m = buffer_begin, n = m + m_len, k1 = n + n_len, k = k1 + len_low;
+
+    // Compute M,N
+    abs_sqr64_karatsuba_buffered(in, len_low, m, buffer_begin + buffer_size, buffer_end);
+    abs_sqr64_karatsuba_buffered(in + base_len, len_high, n, buffer_begin + buffer_size, buffer_end);
+
+    // Compute K1 = |AH - AL|, K = K1^2
+    lamp_ui in_low_len = rlz(in, len_low);
+    (void)abs_difference_binary(in, in_low_len, in + base_len, len_high, k1);
+    lamp_ui k1_len = rlz(k1, get_sub_len(in_low_len, len_high));
+    abs_sqr64_karatsuba_buffered(k1, k1_len, k, buffer_begin + buffer_size, buffer_end);
+    lamp_ui k_len = rlz(k, k1_len * 2);
+
+    // Combine the result, out = M + N * BASE^2 + (M + N - K) * BASE
+    m_len = rlz(m, m_len);
+    n_len = rlz(n, n_len);
+    std::fill(out, out + out_len, lamp_ui(0));
+    std::copy(m, m + m_len, out);
+    std::copy(n, n + n_len, out + base_len * 2);
+    abs_add_binary_half(out + base_len, out_len - base_len, m, m_len, out + base_len);
+    abs_add_binary_half(out + base_len, out_len - base_len, n, n_len, out + base_len);
+    abs_sub_binary(out + base_len, out_len - base_len, k, k_len, out + base_len);
+}
+
+void abs_sqr64_karatsuba(lamp_ptr in, lamp_ui len, lamp_ptr out) {
+    abs_sqr64_karatsuba_buffered(in, len, out, nullptr, nullptr);
+}
+
 };  // namespace lammp::Arithmetic
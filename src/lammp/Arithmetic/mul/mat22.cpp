@@ -0,0 +1,203 @@
+/*
+ * Copyright (C) 2025 HJimmyK/LAMINA
+ *
+ * This file is part of LAMMP, which is licensed under the GNU LGPL v2.1.
+ * See the LICENSE file in the project root for full license details, or visit:
+ * <https://www.gnu.org/licenses/old-licenses/lgpl-2.1.html>
+ */
+
+#include "../../../../include/lammp/mat22.hpp"
+#include "../../../../include/lammp/thread_pool.hpp"
+
+/*
+ * 2x2 矩阵乘法 C = A * B，A = [a b; c d]，B = [e f; g h]
+ * Strassen-Winograd 形式：
+ *   s1 = c + d，s2 = s1 - a，s3 = a - c，s4 = b - s2
+ *   t1 = f - e，t2 = h - t1，t3 = h - f，t4 = t2 - g
+ *   m1 = ae，m2 = bg，m3 = s4 h，m4 = d t4，m5 = s1 t1，m6 = s2 t2，m7 = s3 t3
+ *   u2 = m1 + m6，u3 = u2 + m7
+ *   C = [m1 + m2, u2 + m5 + m3; u3 - m4, u3 + m5]
+ * s、t 比元素至多长一个字，7 次乘法互不依赖，交给全局线程池
+ */
+namespace lammp::Arithmetic {
+
+namespace {
+
+// 有符号大整数的视图
+struct _snum {
+    lamp_ptr ptr;
+    lamp_ui len;
+    bool neg;
+};
+
+// out = x * y，out 的长度至少为 x.len + y.len
+_snum _mul(const _snum& x, const _snum& y, lamp_ptr out) {
+    if (x.len == 0 || y.len == 0) {
+        return {out, 0, false};
+    }
+    abs_mul64(x.ptr, x.len, y.ptr, y.len, out);
+    return {out, rlz(out, x.len + y.len), x.neg != y.neg};
+}
+
+// out = x ± y，out 的长度至少为 max(x.len, y.len) + 1，不可与 x、y 相同
+_snum _add(const _snum& x, const _snum& y, bool sub, lamp_ptr out) {
+    const bool y_neg = y.neg != sub;
+    if (x.len == 0 || y.len == 0) {
+        const _snum& s = x.len == 0 ? y : x;
+        std::copy(s.ptr, s.ptr + s.len, out);
+        return {out, s.len, x.len == 0 ? y_neg && s.len > 0 : x.neg};
+    }
+    const lamp_ui cap = std::max(x.len, y.len) + 1;
+    if (x.neg == y_neg) {
+        abs_add_binary(x.ptr, x.len, y.ptr, y.len, out);
+        return {out, rlz(out, cap), x.neg};
+    }
+    const lamp_si sign = abs_difference_binary(x.ptr, x.len, y.ptr, y.len, out);
+    const lamp_ui len = rlz(out, cap - 1);
+    return {out, len, len > 0 && (sign > 0 ? x.neg : y_neg)};
+}
+
+_snum _entry(const Mat22& m, int i) {
+    const lamp_ui len = rlz(m.ptr[i], m.len[i]);
+    return {m.ptr[i], len, m.neg[i] && len > 0};
+}
+
+void _store(const _snum& x, Mat22& c, int i) {
+    std::copy(x.ptr, x.ptr + x.len, c.ptr[i]);
+    c.len[i] = x.len;
+    c.neg[i] = x.neg;
+}
+
+// 逐项相乘，8 次乘法
+void _mul_classic(const _snum* a, const _snum* b, Mat22& c, lamp_ptr work) {
+    for (int r = 0; r < 2; r++) {
+        for (int k = 0; k < 2; k++) {
+            const _snum p0 = _mul(a[r * 2], b[k], work);
+            const _snum p1 = _mul(a[r * 2 + 1], b[k + 2], p0.ptr + p0.len);
+            _store(_add(p0, p1, false, p1.ptr + p1.len), c, r * 2 + k);
+        }
+    }
+}
+
+// A^2 = [a^2 + bc, b(a + d); c(a + d), d^2 + bc]，5 次乘法
+void _sqr(const _snum* a, Mat22& c, lamp_ui len, lamp_ptr work) {
+    const lamp_ui prod_len = len * 2 + 1;
+    const _snum s = _add(a[0], a[3], false, work);
+    lamp_ptr prod = work + len + 1;
+    _snum m[5];
+    ThreadPool::global().parallelFor(5, [&](size_t k) {
+        static const int lhs[5] = {0, 3, 1, 1, 2}, rhs[5] = {0, 3, 2, -1, -1};
+        m[k] = _mul(a[lhs[k]], rhs[k] < 0 ? s : a[rhs[k]], prod + prod_len * k);
+    });
+    lamp_ptr sum = prod + prod_len * 5;
+    _store(_add(m[0], m[2], false, sum), c, 0);
+    _store(m[3], c, 1);
+    _store(m[4], c, 2);
+    _store(_add(m[1], m[2], false, sum), c, 3);
+}
+
+void _mul_winograd(const _snum* a, const _snum* b, Mat22& c, lamp_ui len_a, lamp_ui len_b, lamp_ptr work) {
+    const lamp_ui sa = len_a + 1, sb = len_b + 1, prod_len = sa + sb;
+    _snum s[4], t[4], m[7];
+    s[0] = _add(a[2], a[3], false, work);
+    s[1] = _add(s[0], a[0], true, work + sa);
+    s[2] = _add(a[0], a[2], true, work + sa * 2);
+    s[3] = _add(a[1], s[1], true, work + sa * 3);
+    work += sa * 4;
+    t[0] = _add(b[1], b[0], true, work);
+    t[1] = _add(b[3], t[0], true, work + sb);
+    t[2] = _add(b[3], b[1], true, work + sb * 2);
+    t[3] = _add(t[1], b[2], true, work + sb * 3);
+    work += sb * 4;
+    const _snum lhs[7] = {a[0], a[1], s[3], a[3], s[0], s[1], s[2]};
+    const _snum rhs[7] = {b[0], b[2], b[3], t[3], t[0], t[1], t[2]};
+    ThreadPool::global().parallelFor(7, [&](size_t k) { m[k] = _mul(lhs[k], rhs[k], work + prod_len * k); });
+    work += prod_len * 7;
+    const _snum u2 = _add(m[0], m[5], false, work);
+    const _snum u3 = _add(u2, m[6], false, work + prod_len + 2);
+    lamp_ptr sum = work + (prod_len + 2) * 2;
+    _store(_add(m[0], m[1], false, sum), c, 0);
+    const _snum u4 = _add(u2, m[4], false, sum);
+    _store(_add(u4, m[2], false, sum + prod_len + 2), c, 1);
+    _store(_add(u3, m[3], true, sum), c, 2);
+    _store(_add(u3, m[4], false, sum), c, 3);
+}
+
+};  // namespace
+
+void mat22_mul(const Mat22& a, const Mat22& b, Mat22& c) {
+    const bool sqr = &a == &b;
+    _snum ea[4], eb[4];
+    lamp_ui len_a = 0, len_b = 0;
+    for (int i = 0; i < 4; i++) {
+        ea[i] = _entry(a, i);
+        eb[i] = _entry(b, i);
+        len_a = std::max(len_a, ea[i].len);
+        len_b = std::max(len_b, eb[i].len);
+    }
+    if (len_a == 0 || len_b == 0) {
+        for (int i = 0; i < 4; i++) {
+            c.ptr[i][0] = 0;
+            c.len[i] = 0;
+            c.neg[i] = false;
+        }
+        return;
+    }
+    // 元素长度相近且都走 NTT 时，在变换域中共享正变换
+    const lamp_ui short_len = std::min(len_a, len_b), long_len = std::max(len_a, len_b);
+    if (short_len >= KARATSUBA_MAX_THRESHOLD && long_len < short_len * 3) {
+        mat22_mul_ntt(a, b, c);
+        return;
+    }
+    // s、t、7 个乘积与末尾的和，足够所有路径使用
+    _internal_buffer<0> work((len_a + len_b + 2) * 16);
+    if (sqr) {
+        _sqr(ea, c, len_a, work.data());
+    } else if (short_len < KARATSUBA_MIN_THRESHOLD) {
+        _mul_classic(ea, eb, c, work.data());
+    } else {
+        _mul_winograd(ea, eb, c, len_a, len_b, work.data());
+    }
+}
+
+void mat22_pow(const Mat22& a, lamp_ui exp, _internal_buffer<0>& buf, Mat22& c) {
+    if (exp == 0) {
+        buf = _internal_buffer<0>(4, 0);
+        for (int i = 0; i < 4; i++) {
+            c.ptr[i] = buf.data() + i;
+            c.len[i] = 0;
+            c.neg[i] = false;
+        }
+        buf.data()[0] = buf.data()[3] = 1;
+        c.len[0] = c.len[3] = 1;
+        return;
+    }
+    // c = a
+    lamp_ui cap = *std::max_element(a.len, a.len + 4);
+    buf = _internal_buffer<0>(cap * 4 + 4, 0);
+    for (int i = 0; i < 4; i++) {
+        c.ptr[i] = buf.data() + (cap + 1) * i;
+        std::copy(a.ptr[i], a.ptr[i] + a.len[i], c.ptr[i]);
+        c.len[i] = rlz(c.ptr[i], a.len[i]);
+        c.neg[i] = a.neg[i] && c.len[i] > 0;
+    }
+    auto step = [&c, &buf](const Mat22& x, const Mat22& y) {
+        const lamp_ui len = get_mat22_mul_len(x, y);
+        _internal_buffer<0> next(len * 4);
+        Mat22 res;
+        for (int i = 0; i < 4; i++) {
+            res.ptr[i] = next.data() + len * i;
+        }
+        mat22_mul(x, y, res);
+        buf = std::move(next);
+        c = res;
+    };
+    for (int bit = 62 - lammp_clz(exp); bit >= 0; bit--) {
+        step(c, c);
+        if ((exp >> bit) & 1) {
+            step(c, a);
+        }
+    }
+}
+
+};  // namespace lammp::Arithmetic
@@ -68,6 +68,10 @@ void abs_mul64(lamp_ptr in1,
                lamp_ptr out,
                lamp_ptr work_begin,
                lamp_ptr work_end) {
+    if (in1 == in2 && len1 == len2) {
+        abs_sqr64(in1, len1, out, work_begin, work_end);
+        return;
+    }
     if (len1 < len2) {
         std::swap(in1, in2);
         std::swap(len1, len2);
@@ -113,4 +117,14 @@ void abs_mul64(lamp_ptr in1,
     }
     std::copy(total_prod, total_prod + len1 + len2, out);
 }
+
+void abs_sqr64(lamp_ptr in, lamp_ui len, lamp_ptr out, lamp_ptr work_begin, lamp_ptr work_end) {
+    if (len <= KARATSUBA_MIN_THRESHOLD) {
+        abs_sqr64_classic(in, len, out, work_begin, work_end);
+    } else if (len <= KARATSUBA_MAX_THRESHOLD) {
+        abs_sqr64_karatsuba_buffered(in, len, out, work_begin, work_end);
+    } else {
+        abs_sqr64_ntt(in, len, out);
+    }
+}
 }; // namespace lammp::Arithmetic
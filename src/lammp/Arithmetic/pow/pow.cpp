@@ -0,0 +1,198 @@
+/*
+ * Copyright (C) 2025 HJimmyK/LAMINA
+ *
+ * This file is part of LAMMP, which is licensed under the GNU LGPL v2.1.
+ * See the LICENSE file in the project root for full license details, or visit:
+ * <https://www.gnu.org/licenses/old-licenses/lgpl-2.1.html>
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "../../../../include/lammp/inter_buffer.hpp"
+#include "../../../../include/lammp/lammp.hpp"
+#include "../../../../include/lammp/mont_multi.hpp"
+
+/*
+ * 整数幂 base^e：先拆出 base = odd * 2^t，2^(t * e) 最后一次移位完成，2 的幂底数不做任何乘法。
+ * 单字底数：指数最高的若干位直接在一个字内算完，之后按固定窗口 w 左到右推进，
+ *   每个窗口 w 次平方加一次单字乘法，b^j（j < 2^w）预先算好且都能放进一个字。
+ * 多字底数：沿用模幂的滑动窗口计划，预计算奇数次幂 base^1, base^3, ...，平方走专门的平方路径。
+ * 结果长度由 e * log2(base) 预先估计，缓冲区只分配一次
+ */
+namespace lammp::Arithmetic {
+
+namespace {
+
+// 单字窗口的上限，b = 3 时 3^31 已能放进一个字
+constexpr lamp_ui POW_WORD_WINDOW_MAX = 5;
+
+// log2(x) 的上界，x > 0，取最高 64 位计算
+double _log2_upper(const lamp_ptr x, lamp_ui n) {
+    const int c = lammp_clz(x[n - 1]);
+    lamp_ui top = x[n - 1] << c;
+    if (c != 0 && n > 1) {
+        top |= x[n - 2] >> (64 - c);
+    }
+    // 截断的低位最多使 top 小 1
+    return double(lamp_si(n * 64) - c - 64) + std::log2(double(top) + 1.0);
+}
+
+// a（a_len 个字）左到右乘方，b 为大于 1 的奇数单字，e 的 [0, bits) 位尚未处理
+lamp_ui _pow_word_tail(lamp_ui b, lamp_ui e, int bits, _internal_buffer<0>& a, lamp_ui a_len, _internal_buffer<0>& t) {
+    // pw[j] = b^j，取最大的 w 使 b^(2^w - 1) 不溢出
+    lamp_ui pw[1 << POW_WORD_WINDOW_MAX];
+    pw[0] = 1;
+    lamp_ui w = 0, filled = 1;
+    while (w < POW_WORD_WINDOW_MAX) {
+        const lamp_ui next = lamp_ui(1) << (w + 1);
+        bool fits = true;
+        for (lamp_ui j = filled; j < next; j++) {
+            lamp_ui lo, hi;
+            mul64x64to128(pw[j - 1], b, lo, hi);
+            if (hi != 0) {
+                fits = false;
+                break;
+            }
+            pw[j] = lo;
+        }
+        if (!fits) {
+            break;
+        }
+        filled = next;
+        w++;
+    }
+    w = std::max<lamp_ui>(w, 1);
+    while (bits > 0) {
+        const int step = std::min<int>(bits, int(w));
+        bits -= step;
+        for (int i = 0; i < step; i++) {
+            abs_sqr64(a.data(), a_len, t.data());
+            a_len = rlz(t.data(), 2 * a_len);
+            std::swap(a, t);
+        }
+        const lamp_ui digit = (e >> bits) & ((lamp_ui(1) << step) - 1);
+        if (digit != 0) {
+            abs_mul_add_num64(a.data(), a_len, a.data(), 0, pw[digit]);
+            a_len = rlz(a.data(), a_len + 1);
+        }
+    }
+    return a_len;
+}
+
+// odd^e，odd 为大于 1 的单字奇数
+lamp_ui _pow_word(lamp_ui b, lamp_ui e, _internal_buffer<0>& a, _internal_buffer<0>& t) {
+    // 指数最高的若干位在一个字内算完
+    lamp_ui v = 1;
+    int bit = lammp_bit_length(e) - 1;
+    for (; bit >= 0; bit--) {
+        lamp_ui lo, hi;
+        mul64x64to128(v, v, lo, hi);
+        if (hi == 0 && ((e >> bit) & 1)) {
+            const lamp_ui sq = lo;
+            mul64x64to128(sq, b, lo, hi);
+        }
+        if (hi != 0) {
+            break;
+        }
+        v = lo;
+    }
+    a.set(0, v);
+    return _pow_word_tail(b, e, bit + 1, a, 1, t);
+}
+
+// odd^e，odd 为多字奇数，滑动窗口
+lamp_ui _pow_multi(const lamp_ptr odd, lamp_ui odd_len, lamp_ui e, _internal_buffer<0>& a, _internal_buffer<0>& t) {
+    PowWindowPlan plan(&e, 1);
+    const lamp_ui table_size = plan.tableSize();
+    std::vector<_internal_buffer<0>> table(table_size);
+    std::vector<lamp_ui> table_len(table_size);
+    table[0] = _internal_buffer<0>(odd_len);
+    std::copy(odd, odd + odd_len, table[0].data());
+    table_len[0] = odd_len;
+    if (table_size > 1) {
+        _internal_buffer<0> sq(2 * odd_len);
+        abs_sqr64(odd, odd_len, sq.data());
+        const lamp_ui sq_len = rlz(sq.data(), 2 * odd_len);
+        for (lamp_ui i = 1; i < table_size; i++) {
+            const lamp_ui len = table_len[i - 1] + sq_len;
+            table[i] = _internal_buffer<0>(len);
+            abs_mul64(table[i - 1].data(), table_len[i - 1], sq.data(), sq_len, table[i].data());
+            table_len[i] = rlz(table[i].data(), len);
+        }
+    }
+    const lamp_ui first = plan.first() >> 1;
+    std::copy(table[first].data(), table[first].data() + table_len[first], a.data());
+    lamp_ui a_len = table_len[first];
+    for (lamp_ui i = 0; i < plan.stepCount(); i++) {
+        for (lamp_ui j = plan.sqrCount(i); j > 0; j--) {
+            abs_sqr64(a.data(), a_len, t.data());
+            a_len = rlz(t.data(), 2 * a_len);
+            std::swap(a, t);
+        }
+        const lamp_ui digit = plan.digit(i) >> 1;
+        if (plan.digit(i) != 0) {
+            abs_mul64(a.data(), a_len, table[digit].data(), table_len[digit], t.data());
+            a_len = rlz(t.data(), a_len + table_len[digit]);
+            std::swap(a, t);
+        }
+    }
+    return a_len;
+}
+
+};  // namespace
+
+/*
+ * @brief base^e 的字长上界，由 e * log2(base) 估计，多留一个字供移位使用
+ */
+lamp_ui get_pow_len(const lamp_ptr base, lamp_ui base_len, lamp_ui e) {
+    base_len = rlz(base, base_len);
+    if (e == 0 || base_len == 0) {
+        return 1;
+    }
+    const double bits = double(e) * _log2_upper(base, base_len);
+    return lamp_ui(bits * (1 + 1e-12) / 64) + 2;
+}
+
+/*
+ * @brief 计算 out = base^e（0^0 = 1）
+ * @param out 输出数组，长度至少为 get_pow_len(base, base_len, e)，不可与 base 重叠
+ * @return 结果的长度，结果为零时返回 0
+ */
+lamp_ui abs_pow64(const lamp_ptr base, lamp_ui base_len, lamp_ui e, lamp_ptr out) {
+    assert(out != nullptr);
+    const lamp_ui cap = get_pow_len(base, base_len, e);
+    std::fill(out, out + cap, 0);
+    base_len = rlz(base, base_len);
+    if (e == 0) {
+        out[0] = 1;
+        return 1;
+    }
+    if (base_len == 0) {
+        return 0;
+    }
+    // base = odd * 2^tz
+    lamp_ui tz_words = 0;
+    while (base[tz_words] == 0) {
+        tz_words++;
+    }
+    const lamp_ui tz = tz_words * 64 + lammp_ctz(base[tz_words]);
+    const lamp_ui shift = tz * e;
+    lamp_ui odd_len = base_len - tz_words;
+    _internal_buffer<0> odd(odd_len);
+    rshift_bits(base, base_len, odd.data(), tz);
+    odd_len = rlz(odd.data(), odd_len);
+    if (odd_len == 1 && odd[0] == 1) {
+        out[shift / 64] = lamp_ui(1) << (shift % 64);
+        return shift / 64 + 1;
+    }
+    // odd^e 的长度不超过 cap - shift / 64，多留一个字给单字乘法
+    const lamp_ui buf_len = cap - shift / 64 + 1;
+    _internal_buffer<0> a(buf_len), t(buf_len);
+    const lamp_ui a_len = odd_len == 1 ? _pow_word(odd[0], e, a, t) : _pow_multi(odd.data(), odd_len, e, a, t);
+    lshift_bits(a.data(), a_len, out, shift);
+    return rlz(out, std::min(cap, a_len + shift / 64 + 1));
+}
+
+};  // namespace lammp::Arithmetic
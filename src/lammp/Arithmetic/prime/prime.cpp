@@ -0,0 +1,394 @@
+/*
+ * Copyright (C) 2025 HJimmyK/LAMINA
+ *
+ * This file is part of LAMMP, which is licensed under the GNU LGPL v2.1.
+ * See the LICENSE file in the project root for full license details, or visit:
+ * <https://www.gnu.org/licenses/old-licenses/lgpl-2.1.html>
+ */
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "../../../../include/lammp/mont_multi.hpp"
+#include "../../../../include/lammp/thread_pool.hpp"
+
+/*
+ * 素性测试（Baillie-PSW）分三级，越往后越贵，绝大多数合数在前两级就被排除：
+ *   1. 试除：小素数按顺序打包成不超过 2^64 的乘积，每个乘积只需对 x 做一遍 abs_div_rem_num64，
+ *      再用单字余数逐个检查其中的素数
+ *   2. 以 2 为底的强伪素数测试（Miller-Rabin），在多字蒙哥马利域内计算
+ *   3. 强 Lucas 测试，Selfridge 参数 P = 1，Q = (1 - D) / 4
+ * 目前没有已知的 BPSW 伪素数，小于 2^64 时结果是确定的
+ */
+namespace lammp::Arithmetic {
+
+namespace {
+
+// 试除素数的上界
+constexpr uint32_t TRIAL_PRIME_LIMIT = 1u << 16;
+
+// 每个字最多试除的素数乘积个数，试除的代价与 x 的长度成正比，上界随长度增长
+constexpr lamp_ui TRIAL_LIMBS_PER_WORD = 8;
+
+// 试除用的奇素数表，以及按顺序打包的素数乘积
+class _trial_table {
+   private:
+    _trial_table() {
+        std::vector<bool> composite(TRIAL_PRIME_LIMIT, false);
+        for (uint32_t p = 3; p < TRIAL_PRIME_LIMIT; p += 2) {
+            if (composite[p]) {
+                continue;
+            }
+            primes.push_back(p);
+            for (uint32_t j = p * p; j < TRIAL_PRIME_LIMIT; j += 2 * p) {
+                composite[j] = true;
+            }
+        }
+        lamp_ui prod = 1;
+        limb_begin.push_back(0);
+        for (size_t i = 0; i < primes.size(); i++) {
+            lamp_ui hi, lo;
+            mul64x64to128(prod, primes[i], lo, hi);
+            if (hi != 0) {
+                limbs.push_back(prod);
+                limb_begin.push_back(uint32_t(i));
+                prod = 1;
+            }
+            prod *= primes[i];
+        }
+        limbs.push_back(prod);
+        limb_begin.push_back(uint32_t(primes.size()));
+    }
+
+   public:
+    std::vector<uint32_t> primes;      // 3, 5, 7, ...，小于 TRIAL_PRIME_LIMIT
+    std::vector<lamp_ui> limbs;        // limbs[i] 为 primes[limb_begin[i], limb_begin[i + 1]) 之积
+    std::vector<uint32_t> limb_begin;  // 长度为 limbs.size() + 1
+
+    static const _trial_table& get() {
+        static const _trial_table table;
+        return table;
+    }
+};
+
+enum class _trial_result { composite, unknown, prime };
+
+/*
+ * 对奇数 x 试除，x > 2
+ * @param quot abs_div_rem_num64 的商，至少 n 个字，只作为临时空间
+ */
+_trial_result _trial_divide(const lamp_ptr x, lamp_ui n, lamp_ptr quot) {
+    const _trial_table& table = _trial_table::get();
+    if (n == 1 && x[0] < TRIAL_PRIME_LIMIT) {
+        return std::binary_search(table.primes.begin(), table.primes.end(), uint32_t(x[0])) ? _trial_result::prime
+                                                                                            : _trial_result::composite;
+    }
+    const lamp_ui limb_count = std::min<lamp_ui>(table.limbs.size(), TRIAL_LIMBS_PER_WORD * n);
+    for (lamp_ui i = 0; i < limb_count; i++) {
+        const lamp_ui r = abs_div_rem_num64(x, n, quot, table.limbs[i]);
+        for (uint32_t j = table.limb_begin[i]; j < table.limb_begin[i + 1]; j++) {
+            if (r % table.primes[j] == 0) {
+                return _trial_result::composite;
+            }
+        }
+    }
+    // 没有不超过 p 的素因子且 x < (p + 2)^2 时 x 为素数
+    const lamp_ui p = table.primes[table.limb_begin[limb_count] - 1];
+    if (n == 1 && x[0] < (p + 2) * (p + 2)) {
+        return _trial_result::prime;
+    }
+    return _trial_result::unknown;
+}
+
+// 蒙哥马利域内的模加减，a、b、out 均为 size() 个字，out 可以与 a 或 b 相同
+void _mod_add(const MontMultiCtx& ctx, lamp_ptr a, lamp_ptr b, lamp_ptr out) {
+    const lamp_ui n = ctx.size();
+    const bool carry = abs_add_binary_half(a, n, b, n, out);
+    if (carry || abs_compare(out, n, ctx.mod(), n) >= 0) {
+        abs_sub_binary(out, n, ctx.mod(), n, out);
+    }
+}
+
+void _mod_sub(const MontMultiCtx& ctx, lamp_ptr a, lamp_ptr b, lamp_ptr out) {
+    const lamp_ui n = ctx.size();
+    if (abs_compare(a, n, b, n) >= 0) {
+        abs_sub_binary(a, n, b, n, out);
+    } else {
+        // a + mod - b = mod - (b - a)
+        abs_sub_binary(b, n, a, n, out);
+        abs_sub_binary(ctx.mod(), n, out, n, out);
+    }
+}
+
+bool _is_zero(const lamp_ptr a, lamp_ui n) { return rlz(a, n) == 0; }
+
+bool _equal(const lamp_ptr a, const lamp_ptr b, lamp_ui n) { return std::equal(a, a + n, b); }
+
+/*
+ * 以 2 为底的强伪素数测试：x - 1 = d * 2^s，d 为奇数，
+ * 2^d ≡ 1 或存在 0 <= r < s 使 2^(d * 2^r) ≡ -1 (mod x)
+ */
+bool _strong_prp2(const MontMultiCtx& ctx) {
+    const lamp_ui n = ctx.size();
+    const lamp_ptr x = ctx.mod();
+    _internal_buffer<0> _d(n, 0);
+    lamp_ptr d = _d.data();
+    // x 为奇数，x - 1 只需清除最低位
+    std::copy(x, x + n, d);
+    d[0] &= ~lamp_ui(1);
+    lamp_ui s = 0;
+    while (d[s / 64] == 0) {
+        s += 64;
+    }
+    s += lammp_ctz(d[s / 64]);
+    rshift_bits(d, n, d, s);
+    const lamp_ui d_len = rlz(d, n);
+
+    const PowWindowPlan plan(d, d_len);
+    _internal_buffer<0> _buf((plan.tableSize() + 4) * n + ctx.workSize(), 0);
+    lamp_ptr base = _buf.data(), y = base + n, one = y + n, minus_one = one + n;
+    lamp_ptr table = minus_one + n, work = table + plan.tableSize() * n;
+    ctx.one(one);
+    _mod_add(ctx, one, one, base);
+    abs_sub_binary(x, n, one, n, minus_one);
+    pow_window_exec(ctx, plan, base, table, y, work);
+    if (_equal(y, one, n) || _equal(y, minus_one, n)) {
+        return true;
+    }
+    for (lamp_ui r = 1; r < s; r++) {
+        ctx.sqr(y, y, work);
+        if (_equal(y, minus_one, n)) {
+            return true;
+        }
+        if (_equal(y, one, n)) {
+            return false;
+        }
+    }
+    return false;
+}
+
+// Jacobi 符号 (a / m)，m 为奇数
+int _jacobi(lamp_ui a, lamp_ui m) {
+    int t = 1;
+    a %= m;
+    while (a != 0) {
+        const int z = lammp_ctz(a);
+        a >>= z;
+        if ((z & 1) && ((m & 7) == 3 || (m & 7) == 5)) {
+            t = -t;
+        }
+        std::swap(a, m);
+        if ((a & 3) == 3 && (m & 3) == 3) {
+            t = -t;
+        }
+        a %= m;
+    }
+    return m == 1 ? t : 0;
+}
+
+/*
+ * Selfridge 方法 A：在 5, -7, 9, -11, ... 中取第一个使 (D / x) = -1 的 D
+ * @return 找到的 D；x 必为合数（D 与 x 有公因子或 x 为完全平方数）时返回 0
+ */
+lamp_si _selfridge_d(const lamp_ptr x, lamp_ui n, lamp_ptr quot) {
+    // 完全平方数找不到 (D / x) = -1，试过几个 D 之后再检查，多数 x 在此之前已经找到
+    constexpr int SQUARE_CHECK_AFTER = 4;
+    lamp_si d = 5;
+    for (int i = 0;; i++) {
+        const lamp_ui a = lamp_ui(d < 0 ? -d : d);
+        // (a / x) = (x / a) * (-1)^((a - 1) / 2 * (x - 1) / 2)，D < 0 时再乘以 (-1 / x) = (-1)^((x - 1) / 2)
+        int j = _jacobi(abs_div_rem_num64(x, n, quot, a), a);
+        if (j == 0) {
+            return 0;
+        }
+        if ((a & 3) == 3 && (x[0] & 3) == 3) {
+            j = -j;
+        }
+        if (d < 0 && (x[0] & 3) == 3) {
+            j = -j;
+        }
+        if (j == -1) {
+            return d;
+        }
+        if (i + 1 == SQUARE_CHECK_AFTER && abs_is_square64(x, n)) {
+            return 0;
+        }
+        d = d < 0 ? 2 - d : -2 - d;
+    }
+}
+
+/*
+ * 强 Lucas 测试，P = 1，Q = (1 - D) / 4：x + 1 = d * 2^s，d 为奇数，
+ * U_d ≡ 0 或存在 0 <= r < s 使 V_(d * 2^r) ≡ 0 (mod x)
+ * 只沿 d 的二进制位推进 (V_k, V_(k+1), Q^k)：
+ *   V_2k = V_k^2 - 2Q^k，V_(2k+1) = V_k * V_(k+1) - P * Q^k
+ * 再由 D * U_d = 2V_(d+1) - P * V_d 判断 U_d，D 与 x 互素
+ */
+bool _strong_lucas(const MontMultiCtx& ctx, lamp_si d_param) {
+    const lamp_ui n = ctx.size();
+    const lamp_ptr x = ctx.mod();
+    const lamp_si q_param = (1 - d_param) / 4;
+
+    // x + 1 可能进位到第 n 个字
+    _internal_buffer<0> _d(n + 1, 0);
+    lamp_ptr d = _d.data();
+    lamp_ui one_word = 1;
+    abs_add_binary(x, n, &one_word, 1, d);
+    lamp_ui s = 0;
+    while (d[s / 64] == 0) {
+        s += 64;
+    }
+    s += lammp_ctz(d[s / 64]);
+    rshift_bits(d, n + 1, d, s);
+    const lamp_ui d_len = rlz(d, n + 1);
+
+    _internal_buffer<0> _buf(6 * n + ctx.workSize(), 0);
+    lamp_ptr v = _buf.data(), v1 = v + n, qk = v1 + n, q = qk + n, qkq = q + n, t = qkq + n;
+    lamp_ptr work = t + n;
+    lamp_ui q_abs = lamp_ui(q_param < 0 ? -q_param : q_param);
+    ctx.toMont(&q_abs, 1, q, work);
+    if (q_param < 0) {
+        abs_sub_binary(x, n, q, n, q);
+    }
+    // D = 5 时 Q = -1，Q^k 只取决于 k 的奇偶，省去每一位上对 Q^k 的乘法
+    const bool q_neg_one = q_param == -1;
+    // k = 0：V_0 = 2，V_1 = P = 1，Q^0 = 1
+    ctx.one(qk);
+    ctx.one(v1);
+    _mod_add(ctx, qk, qk, v);
+    for (lamp_ui i = bit_length(d, d_len); i-- > 0;) {
+        if (get_bit(d, d_len, i)) {
+            // k -> 2k + 1
+            if (q_neg_one) {
+                abs_sub_binary(x, n, qk, n, qkq);
+            } else {
+                ctx.mul(qk, q, qkq, work);
+            }
+            ctx.mul(v, v1, v, work);
+            _mod_sub(ctx, v, qk, v);
+            ctx.sqr(v1, v1, work);
+            _mod_add(ctx, qkq, qkq, t);
+            _mod_sub(ctx, v1, t, v1);
+            if (q_neg_one) {
+                std::copy(q, q + n, qk);
+            } else {
+                ctx.mul(qk, qkq, qk, work);
+            }
+        } else {
+            // k -> 2k
+            ctx.mul(v, v1, v1, work);
+            _mod_sub(ctx, v1, qk, v1);
+            ctx.sqr(v, v, work);
+            _mod_add(ctx, qk, qk, t);
+            _mod_sub(ctx, v, t, v);
+            if (q_neg_one) {
+                ctx.one(qk);
+            } else {
+                ctx.sqr(qk, qk, work);
+            }
+        }
+    }
+    // U_d ≡ 0 等价于 2V_(d+1) ≡ V_d
+    _mod_add(ctx, v1, v1, t);
+    if (_is_zero(v, n) || _equal(t, v, n)) {
+        return true;
+    }
+    for (lamp_ui r = 1; r < s; r++) {
+        ctx.sqr(v, v, work);
+        _mod_add(ctx, qk, qk, t);
+        _mod_sub(ctx, v, t, v);
+        if (_is_zero(v, n)) {
+            return true;
+        }
+        if (q_neg_one) {
+            ctx.one(qk);
+        } else {
+            ctx.sqr(qk, qk, work);
+        }
+    }
+    return false;
+}
+
+// 小数与试除阶段，unknown 表示需要继续做 BPSW
+_trial_result _prime_screen(const lamp_ptr in, lamp_ui len, lamp_ptr quot) {
+    if (len == 0 || (len == 1 && in[0] < 2)) {
+        return _trial_result::composite;
+    }
+    if ((in[0] & 1) == 0) {
+        return len == 1 && in[0] == 2 ? _trial_result::prime : _trial_result::composite;
+    }
+    return _trial_divide(in, len, quot);
+}
+
+// 通过试除的奇数 in 做 BPSW
+bool _bpsw(lamp_ptr in, lamp_ui len, lamp_ptr quot) {
+    const MontMultiCtx ctx(in, len);
+    if (!_strong_prp2(ctx)) {
+        return false;
+    }
+    const lamp_si d = _selfridge_d(in, len, quot);
+    return d != 0 && _strong_lucas(ctx, d);
+}
+
+};  // namespace
+
+/*
+ * @brief 判断 in 是否为素数（BPSW 概率素性测试，小于 2^64 时结果是确定的）
+ * @note 先试除，再做以 2 为底的强伪素数测试，最后做强 Lucas 测试
+ */
+bool abs_is_prime64(lamp_ptr in, lamp_ui len) {
+    assert(in != nullptr || len == 0);
+    len = rlz(in, len);
+    _internal_buffer<0> _quot(std::max<lamp_ui>(len, 1));
+    const _trial_result res = _prime_screen(in, len, _quot.data());
+    if (res != _trial_result::unknown) {
+        return res == _trial_result::prime;
+    }
+    return _bpsw(in, len, _quot.data());
+}
+
+/*
+ * @brief 批量素性测试：outs[i] = abs_is_prime64(ins[i], lens[i])
+ * @details 按阶段筛选：所有候选先按块并行试除，只把剩下的候选逐个分配到全局线程池做 BPSW，
+ *          这样线程的负载只取决于真正需要做模幂的候选，而不是它们在输入中的位置
+ */
+void abs_is_prime64_batch(lamp_ptr* ins, const lamp_ui* lens, lamp_ui count, bool* outs) {
+    assert(count == 0 || (ins != nullptr && lens != nullptr && outs != nullptr));
+    if (count == 0) {
+        return;
+    }
+    ThreadPool& pool = ThreadPool::global();
+    const lamp_ui chunks = std::min<lamp_ui>(count, pool.concurrency() * 4);
+    const lamp_ui per_chunk = (count + chunks - 1) / chunks;
+    std::vector<char> pending(count, 0);
+    pool.parallelFor(chunks, [&](size_t chunk) {
+        const lamp_ui begin = std::min(count, chunk * per_chunk);
+        const lamp_ui end = std::min(count, begin + per_chunk);
+        _internal_buffer<0> _quot(0);
+        for (lamp_ui i = begin; i < end; i++) {
+            const lamp_ui len = rlz(ins[i], lens[i]);
+            if (std::max<lamp_ui>(len, 1) > _quot.capacity()) {
+                _quot = _internal_buffer<0>(std::max<lamp_ui>(len, 1));
+            }
+            const _trial_result res = _prime_screen(ins[i], len, _quot.data());
+            outs[i] = res == _trial_result::prime;
+            pending[i] = res == _trial_result::unknown;
+        }
+    });
+
+    std::vector<lamp_ui> survivors;
+    for (lamp_ui i = 0; i < count; i++) {
+        if (pending[i]) {
+            survivors.push_back(i);
+        }
+    }
+    pool.parallelFor(survivors.size(), [&](size_t k) {
+        const lamp_ui i = survivors[k];
+        const lamp_ui len = rlz(ins[i], lens[i]);
+        _internal_buffer<0> _quot(len);
+        outs[i] = _bpsw(ins[i], len, _quot.data());
+    });
+}
+
+};  // namespace lammp::Arithmetic
@@ -0,0 +1,291 @@
+/*
+ * Copyright (C) 2025 HJimmyK/LAMINA
+ *
+ * This file is part of LAMMP, which is licensed under the GNU LGPL v2.1.
+ * See the LICENSE file in the project root for full license details, or visit:
+ * <https://www.gnu.org/licenses/old-licenses/lgpl-2.1.html>
+ */
+
+#include <cmath>
+#include <vector>
+
+#include "../../../../include/lammp/inter_buffer.hpp"
+#include "../../../../include/lammp/lammp.hpp"
+
+/*
+ * k 次方根：牛顿迭代 s <- ((k - 1) * s + x / s^(k-1)) / k，从不小于真值的初值出发单调下降，
+ * 第一次不再下降时即为 floor(x^(1/k))。初值由精度倍增得到：根的位数 rb 不超过 40 时用浮点
+ * 估计，否则对 x >> (k * h)（h = rb / 2）递归求根 r，取 (r + 1) << h 作为初值，
+ * 此时初值已有一半精度，全尺寸上只需两三次迭代，大部分工作都在较短的数上完成
+ */
+namespace lammp::Arithmetic {
+
+namespace {
+
+// out = base^e，返回长度
+lamp_ui _pow_ui(const lamp_ptr base, lamp_ui base_len, lamp_ui e, _internal_buffer<0>& out) {
+    out = _internal_buffer<0>(get_pow_len(base, base_len, e));
+    return abs_pow64(base, base_len, e, out.data());
+}
+
+// log2(x)，x > 0，取最高 64 位计算
+double _log2(const lamp_ptr x, lamp_ui n) {
+    if (n == 1) {
+        return std::log2(double(x[0]));
+    }
+    const int c = lammp_clz(x[n - 1]);
+    const lamp_ui top = c == 0 ? x[n - 1] : (x[n - 1] << c) | (x[n - 2] >> (64 - c));
+    return double(n * 64 - c - 64) + std::log2(double(top));
+}
+
+// 从不小于真值的 s 出发做牛顿迭代，结束时 s = floor(x^(1/k))，k >= 3
+void _root_newton(const lamp_ptr x, lamp_ui n, lamp_ui k, _internal_buffer<0>& s, lamp_ui& s_len) {
+    while (true) {
+        _internal_buffer<0> p;
+        const lamp_ui p_len = _pow_ui(s.data(), s_len, k - 1, p);
+        // y = ((k - 1) * s + x / s^(k-1)) / k
+        const lamp_ui y_cap = std::max(n, s_len) + 4;
+        _internal_buffer<0> y(y_cap, 0);
+        if (abs_compare(x, n, p.data(), p_len) >= 0) {
+            abs_div64(x, n, p.data(), p_len, y.data());
+        }
+        lamp_ui y_len = rlz(y.data(), y_cap);
+        _internal_buffer<0> t(s_len + 1, 0);
+        abs_mul_add_num64(s.data(), s_len, t.data(), 0, k - 1);
+        const lamp_ui t_len = rlz(t.data(), s_len + 1);
+        abs_add_binary(y.data(), std::max(y_len, t_len), t.data(), t_len, y.data());
+        y_len = rlz(y.data(), std::max(y_len, t_len) + 1);
+        abs_div_rem_num64(y.data(), y_len, y.data(), k);
+        y_len = rlz(y.data(), y_len);
+        if (abs_compare(y.data(), y_len, s.data(), s_len) >= 0) {
+            return;
+        }
+        s = std::move(y);
+        s_len = y_len;
+    }
+}
+
+// s = floor(x^(1/k))，x > 0，k >= 3
+void _root_floor(const lamp_ptr x, lamp_ui n, lamp_ui k, _internal_buffer<0>& s, lamp_ui& s_len) {
+    const lamp_ui b = bit_length(x, n);
+    const lamp_ui rb = (b + k - 1) / k;
+    if (rb <= 40) {
+        const double est = std::exp2(_log2(x, n) / double(k));
+        s = _internal_buffer<0>(2, 0);
+        s.set(0, lamp_ui(est * (1 + 1e-9)) + 2);
+        s_len = 1;
+    } else {
+        // 对 x >> (k * h) 求根得到高半部分，初值 (r + 1) << h 不小于真值
+        const lamp_ui h = rb / 2, shift = k * h;
+        const lamp_ui hi_len = n - shift / 64;
+        _internal_buffer<0> x_hi(hi_len + 1, 0);
+        rshift_bits(x, n, x_hi.data(), shift);
+        _internal_buffer<0> r;
+        lamp_ui r_len;
+        _root_floor(x_hi.data(), rlz(x_hi.data(), hi_len), k, r, r_len);
+        _internal_buffer<0> r1(r_len + 1, 0);
+        lamp_ui one = 1;
+        abs_add_binary(r.data(), r_len, &one, 1, r1.data());
+        r_len = rlz(r1.data(), r_len + 1);
+        s_len = r_len + h / 64 + 1;
+        s = _internal_buffer<0>(s_len + 1, 0);
+        lshift_in_word(r1.data(), r_len, s.data() + h / 64, int(h % 64));
+        s_len = rlz(s.data(), s_len);
+    }
+    _root_newton(x, n, k, s, s_len);
+}
+
+// x mod q，q < 2^32
+lamp_ui _mod_small(const lamp_ptr x, lamp_ui n, lamp_ui q) {
+    lamp_ui r = 0;
+    for (lamp_ui i = n; i-- > 0;) {
+        lamp_ui lo = x[i];
+        div128by64to64(r, lo, q);
+        r = lo;
+    }
+    return r;
+}
+
+// a^e mod q，q < 2^32
+lamp_ui _pow_mod_small(lamp_ui a, lamp_ui e, lamp_ui q) {
+    lamp_ui r = 1 % q;
+    a %= q;
+    while (e > 0) {
+        if (e & 1) {
+            r = r * a % q;
+        }
+        a = a * a % q;
+        e >>= 1;
+    }
+    return r;
+}
+
+bool _is_prime_small(lamp_ui q) {
+    if (q < 2) {
+        return false;
+    }
+    for (lamp_ui d = 2; d * d <= q; d++) {
+        if (q % d == 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/*
+ * 模 q 的 k 次剩余筛：q 为素数且 q ≡ 1 (mod k) 时，k 次剩余只占 1/k，
+ * x 若为 k 次方则 x^((q-1)/k) ≡ 0 或 1 (mod q)
+ */
+bool _is_power_residue(lamp_ui r, lamp_ui k, lamp_ui q) { return r == 0 || _pow_mod_small(r, (q - 1) / k, q) == 1; }
+
+// 大于 q 的下一个满足 q ≡ 1 (mod k) 的素数（k 为奇数），超出 32 位时返回 0
+lamp_ui _next_residue_prime(lamp_ui k, lamp_ui q) {
+    for (q += 2 * k; q < (1ull << 32); q += 2 * k) {
+        if (_is_prime_small(q)) {
+            return q;
+        }
+    }
+    return 0;
+}
+
+// x == r^k，r 单字
+bool _is_exact_power(const lamp_ptr x, lamp_ui n, lamp_ui r, lamp_ui k) {
+    _internal_buffer<0> p;
+    const lamp_ui p_len = _pow_ui(&r, 1, k, p);
+    return abs_compare(x, n, p.data(), p_len) == 0;
+}
+
+};  // namespace
+
+/*
+ * @brief 计算 root = floor(in^(1/k))，rem = in - root^k
+ * @param root 输出数组，长度至少为 (len + k - 1) / k
+ * @param rem 余数输出数组，长度至少为 len，可以为 nullptr
+ * @return 余数的长度
+ * @note k == 2 时转到 abs_sqrtrem64
+ */
+lamp_ui abs_rootrem64(lamp_ptr in, lamp_ui len, lamp_ui k, lamp_ptr root, lamp_ptr rem) {
+    assert(k > 0);
+    len = rlz(in, len);
+    const lamp_ui root_cap = (len + k - 1) / k;
+    if (len == 0) {
+        return 0;
+    }
+    if (k == 1) {
+        std::copy(in, in + len, root);
+        return 0;
+    }
+    if (k == 2) {
+        return abs_sqrtrem64(in, len, root, rem);
+    }
+    std::fill(root, root + root_cap, 0);
+    _internal_buffer<0> s;
+    lamp_ui s_len;
+    if (k >= bit_length(in, len)) {
+        // 1 <= in < 2^k，根为 1
+        s = _internal_buffer<0>(1, 1);
+        s_len = 1;
+    } else {
+        _root_floor(in, len, k, s, s_len);
+    }
+    std::copy(s.data(), s.data() + s_len, root);
+    if (rem == nullptr) {
+        return 0;
+    }
+    _internal_buffer<0> p;
+    const lamp_ui p_len = _pow_ui(s.data(), s_len, k, p);
+    abs_sub_binary(in, len, p.data(), p_len, rem);
+    return rlz(rem, len);
+}
+
+/*
+ * @brief 判断 in 是否为完全幂 y^k（k >= 2），0 和 1 视为完全幂
+ * @param odd_only 为 true 时只考虑奇数 k（用于负数）
+ * @note 只需检查素数 k；in 含因子 2^v 时 k 必须整除 v。根不超过 40 位时由 log2(in) / k
+ *       的浮点值直接得到候选根，其余 k 先做模 q ≡ 1 (mod k) 的 k 次剩余筛，通过后才开方
+ */
+bool abs_is_perfect_power64(lamp_ptr in, lamp_ui len, bool odd_only) {
+    len = rlz(in, len);
+    if (len == 0 || (len == 1 && in[0] == 1)) {
+        return true;
+    }
+    if (!odd_only && abs_is_square64(in, len)) {
+        return true;
+    }
+    const lamp_ui b = bit_length(in, len);
+    lamp_ui v = 0;
+    while (in[v / 64] == 0) {
+        v += 64;
+    }
+    v += lammp_ctz(in[v / 64]);
+    // v > 0 时候选 k 为 v 的奇素因子，否则为不超过 b 的奇素数
+    const lamp_ui k_max = v > 0 ? v : b;
+    std::vector<bool> composite(k_max + 1, false);
+    const double l = _log2(in, len);
+    constexpr lamp_ui check_q = 4294967291ull;  // 小于 2^32 的最大素数
+    const lamp_ui in_mod_q = _mod_small(in, len, check_q);
+    std::vector<lamp_ui> ks, qs;
+    for (lamp_ui k = 3; k <= k_max; k += 2) {
+        if (composite[k]) {
+            continue;
+        }
+        for (lamp_ui j = k * k; j <= k_max; j += 2 * k) {
+            composite[j] = true;
+        }
+        if (v > 0 && v % k != 0) {
+            continue;
+        }
+        if (l / double(k) < 40.0) {
+            // 根不超过 40 位，浮点对数已能确定候选根
+            // 根接近 40 位时浮点比较几乎总能通过，先比较模 q 的余数再做精确检查
+            const double r = std::round(std::exp2(l / double(k)));
+            if (r >= 2.0 && std::fabs(double(k) * std::log2(r) - l) <= 1e-12 * (l + 1.0) &&
+                _pow_mod_small(lamp_ui(r), k, check_q) == in_mod_q && _is_exact_power(in, len, lamp_ui(r), k)) {
+                return true;
+            }
+            continue;
+        }
+        ks.push_back(k);
+        qs.push_back(_next_residue_prime(k, 1));
+    }
+    if (ks.empty()) {
+        return false;
+    }
+    // 先求 in mod prod(q)，各 q 的余数再由这个短得多的数得到，避免对 in 做多遍单字取模
+    std::vector<lamp_ui> prod(qs.size() + 1, 0);
+    prod[0] = 1;
+    lamp_ui prod_len = 1;
+    for (lamp_ui q : qs) {
+        abs_mul_add_num64(prod.data(), prod_len, prod.data(), 0, q);
+        prod_len = rlz(prod.data(), prod_len + 1);
+    }
+    std::vector<lamp_ui> rem(prod_len, 0);
+    const lamp_ui rem_len = abs_mod64(in, len, prod.data(), prod_len, rem.data());
+    for (size_t i = 0; i < ks.size(); i++) {
+        const lamp_ui k = ks[i];
+        lamp_ui q = qs[i];
+        if (!_is_power_residue(_mod_small(rem.data(), rem_len, q), k, q)) {
+            continue;
+        }
+        // 通过第一个筛的 k 很少，再直接用两个 q 筛一次
+        bool pass = true;
+        for (int t = 0; t < 2 && pass; t++) {
+            q = _next_residue_prime(k, q);
+            pass = q == 0 || _is_power_residue(_mod_small(in, len, q), k, q);
+        }
+        if (!pass) {
+            continue;
+        }
+        _internal_buffer<0> s;
+        lamp_ui s_len;
+        _root_floor(in, len, k, s, s_len);
+        _internal_buffer<0> p;
+        const lamp_ui p_len = _pow_ui(s.data(), s_len, k, p);
+        if (abs_compare(in, len, p.data(), p_len) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+};  // namespace lammp::Arithmetic
@@ -130,7 +130,6 @@ void rshift_in_word(lamp_ptr in, lamp_ui len, lamp_ptr out, int shift) {
 void lshift_bits(lamp_ptr in, lamp_ui len, lamp_ptr out, lamp_ui shift) {
     lamp_ui shift_word = shift / 64;
     lamp_ui shift_bits = shift % 64;
-    assert(shift_word < len);
     if (shift_bits == 0) {
         std::copy(in, in + len, out + shift_word);
     } else {
@@ -0,0 +1,234 @@
+/*
+ * Copyright (C) 2025 HJimmyK/LAMINA
+ *
+ * This file is part of LAMMP, which is licensed under the GNU LGPL v2.1.
+ * See the LICENSE file in the project root for full license details, or visit:
+ * <https://www.gnu.org/licenses/old-licenses/lgpl-2.1.html>
+ */
+
+#include <array>
+#include <cmath>
+
+#include "../../../../include/lammp/inter_buffer.hpp"
+#include "../../../../include/lammp/lammp.hpp"
+
+/*
+ * Karatsuba 平方根（Zimmermann）：设 a = (a_hi * B^l + a1) * B^l + a0，其中 a_hi 占 2h 字，
+ *   (s', r') = sqrtrem(a_hi)
+ *   (q, u)   = divrem(r' * B^l + a1, 2 * s')
+ *   s = s' * B^l + q，r = u * B^l + a0 - q^2
+ *   若 r < 0，则 r += 2 * s - 1，s -= 1
+ * 要求 a 的最高字不小于 2^62（规格化），此时 s' 的最高位为 1，
+ * 除以 2 * s' 可改写为 (r' * B^l + a1) / 2 除以 s'，直接使用 abs_div_recursive。
+ * 每层的代价为一次 h 字除法加一次 l 字平方
+ */
+namespace lammp::Arithmetic {
+
+namespace {
+
+// 128 位规格化（hi >= 2^62）整数的平方根，rem 占 2 字
+lamp_ui _sqrtrem128(lamp_ui hi, lamp_ui lo, lamp_ptr rem) {
+    // 由浮点估计得到一个不小于真值的初值，再做整数牛顿迭代（从上方单调收敛）
+    const double est = std::sqrt(std::ldexp(double(hi), 64) + double(lo)) + 8192.0;
+    lamp_ui s = est >= 18446744073709551615.0 ? LAMP_UI_MAX : lamp_ui(est);
+    while (hi < s) {
+        lamp_ui r = lo;
+        const lamp_ui q = div128by64to64(hi, r, s);
+        if (q >= s) {
+            break;
+        }
+        // (s + q) / 2，避免溢出
+        s = (s >> 1) + (q >> 1) + (s & q & 1);
+    }
+    lamp_ui sq_lo, sq_hi;
+    mul64x64to128(s, s, sq_lo, sq_hi);
+    bool borrow = false;
+    rem[0] = sub_borrow(lo, sq_lo, borrow);
+    rem[1] = sub_borrow(hi, sq_hi, borrow);
+    return s;
+}
+
+/*
+ * a 占 2n 字且 a[2n - 1] >= 2^62，s 输出 n 字，r 输出 n + 1 字
+ */
+void _sqrtrem_rec(const lamp_ptr a, lamp_ui n, lamp_ptr s, lamp_ptr r) {
+    if (n == 1) {
+        r[1] = 0;
+        s[0] = _sqrtrem128(a[1], a[0], r);
+        return;
+    }
+    const lamp_ui l = n / 2, h = n - l;
+    // (s', r') = sqrtrem(a_hi)，s' 直接写入 s 的高 h 字
+    _internal_buffer<0> _r_hi(h + 1);
+    lamp_ptr s_hi = s + l;
+    _sqrtrem_rec(a + 2 * l, h, s_hi, _r_hi.data());
+
+    // num = (r' * B^l + a1) / 2，最低位单独记下
+    const lamp_ui num_cap = l + h + 2;
+    _internal_buffer<0> _num(num_cap, 0);
+    lamp_ptr num = _num.data();
+    std::copy(a + l, a + 2 * l, num);
+    std::copy(_r_hi.data(), _r_hi.data() + h + 1, num + l);
+    const lamp_ui low_bit = num[0] & 1;
+    rshift_in_word(num, l + h + 1, num, 1);
+    const lamp_ui num_len = rlz(num, l + h + 1);
+
+    // q = num / s'，q <= B^l
+    _internal_buffer<0> _q(l + 2, 0);
+    _internal_buffer<0> _u(h, 0);
+    lamp_ptr q = _q.data(), u = _u.data();
+    if (num_len >= h) {
+        abs_div_recursive(num, num_len, s_hi, h, q, u);
+    } else {
+        std::copy(num, num + h, u);
+    }
+    const lamp_ui q_len = rlz(q, l + 1);
+
+    // t = u * B^l + a0，u = 2 * (num % s') + low_bit
+    _internal_buffer<0> _t(n + 2, 0);
+    lamp_ptr t = _t.data();
+    std::copy(a, a + l, t);
+    lshift_in_word(u, h, t + l, 1);
+    t[l] |= low_bit;
+
+    // s = s' * B^l + q，q 可能等于 B^l，因此在 n + 1 字内进位
+    _internal_buffer<0> _s_full(n + 2, 0);
+    lamp_ptr s_full = _s_full.data();
+    std::copy(s_hi, s_hi + h, s_full + l);
+    abs_add_binary(s_full, n + 1, q, q_len, s_full);
+
+    // r = t - q^2，r < 0 时修正一次
+    _internal_buffer<0> _qq(2 * l + 3, 0);
+    lamp_ptr qq = _qq.data();
+    if (q_len > 0) {
+        abs_sqr64(q, q_len, qq);
+    }
+    const lamp_ui qq_len = rlz(qq, 2 * q_len);
+    const lamp_ui t_len = rlz(t, n + 1);
+    std::fill(r, r + n + 1, 0);
+    if (abs_compare(t, t_len, qq, qq_len) >= 0) {
+        abs_sub_binary(t, t_len, qq, qq_len, r);
+    } else {
+        // r = 2 * s - 1 - (q^2 - t)，s -= 1
+        abs_sub_binary(qq, qq_len, t, t_len, qq);
+        lamp_ui d_len = rlz(qq, qq_len);
+        lshift_in_word(s_full, n + 1, t, 1);
+        abs_sub_binary_num(t, n + 2, 1, t);
+        abs_sub_binary(t, n + 2, qq, d_len, t);
+        std::copy(t, t + n + 1, r);
+        abs_sub_binary_num(s_full, n + 1, 1, s_full);
+    }
+    std::copy(s_full, s_full + n, s);
+}
+
+/*
+ * 平方剩余筛：x 若为完全平方数，则 x mod m 必为模 m 的二次剩余。
+ * 先看最低字 mod 256，再利用 2^48 ≡ 1 (mod 2^48 - 1) 一次遍历得到 x mod (2^48 - 1)，
+ * 由其约化出 mod 63、65、17、97，四个模数都整除 2^48 - 1
+ */
+template <lamp_ui M>
+struct _qr_table {
+    std::array<bool, M> is_qr{};
+    constexpr _qr_table() {
+        for (lamp_ui i = 0; i < M; i++) {
+            is_qr[i * i % M] = true;
+        }
+    }
+};
+
+constexpr _qr_table<256> QR256;
+constexpr _qr_table<63> QR63;
+constexpr _qr_table<65> QR65;
+constexpr _qr_table<17> QR17;
+constexpr _qr_table<97> QR97;
+
+lamp_ui _mod_2pow48m1(const lamp_ptr in, lamp_ui len) {
+    constexpr lamp_ui MASK48 = (1ull << 48) - 1;
+    lamp_ui acc = 0;
+    for (lamp_ui i = 0; i < len; i++) {
+        // in[i] * 2^(64 i) ≡ in[i] * 2^k，k = 64 i mod 48 ∈ {0, 16, 32}
+        const int k = int((i % 3) * 16);
+        const lamp_ui w = in[i];
+        acc += ((w << k) & MASK48) + (w >> (48 - k));
+        acc = (acc & MASK48) + (acc >> 48);
+    }
+    while (acc >= MASK48) {
+        acc -= MASK48;
+    }
+    return acc;
+}
+
+};  // namespace
+
+/*
+ * @brief 计算 root = floor(sqrt(in))，rem = in - root^2
+ * @param root 输出数组，长度至少为 (len + 1) / 2
+ * @param rem 余数输出数组，长度至少为 (len + 1) / 2 + 1，可以为 nullptr
+ * @return 余数的长度
+ * @note 输入先规格化为偶数字长、最高字不小于 2^62，再做 Karatsuba 平方根，最后移回并修正余数
+ */
+lamp_ui abs_sqrtrem64(lamp_ptr in, lamp_ui len, lamp_ptr root, lamp_ptr rem) {
+    len = rlz(in, len);
+    if (len == 0) {
+        return 0;
+    }
+    const lamp_ui n = (len + 1) / 2;
+    // 左移 2t 位：补齐到 2n 字，并使最高字的最高两位不全为零
+    const lamp_ui shift2 = lamp_ui(lammp_clz(in[len - 1]) & ~1) + (len & 1) * 64;
+    const lamp_ui t = shift2 / 2;
+    _internal_buffer<0> _a(2 * n + 1, 0);
+    lshift_in_word(in, len, _a.data() + shift2 / 64, int(shift2 % 64));
+
+    _internal_buffer<0> _s(n + 1, 0);
+    _internal_buffer<0> _r(n + 3, 0);
+    _sqrtrem_rec(_a.data(), n, _s.data(), _r.data());
+    lamp_ptr s = _s.data(), r = _r.data();
+
+    // root = s' >> t，t < 64
+    rshift_in_word(s, n, root, int(t));
+    if (rem == nullptr) {
+        return 0;
+    }
+    if (t == 0) {
+        const lamp_ui r_len = rlz(r, n + 1);
+        std::copy(r, r + r_len, rem);
+        return r_len;
+    }
+    // in - root^2 = (r' + s0 * (2 s' - s0)) / 4^t，s0 = s' mod 2^t
+    const lamp_ui s0 = s[0] & ((1ull << t) - 1);
+    _internal_buffer<0> _v(n + 3, 0);
+    lamp_ptr v = _v.data();
+    lshift_in_word(s, n, v, 1);
+    abs_sub_binary_num(v, n + 1, s0, v);
+    _internal_buffer<0> _w(n + 3, 0);
+    abs_mul_add_num64(v, n + 1, _w.data(), 0, s0);
+    abs_add_binary(_w.data(), n + 2, r, n + 1, _w.data());
+    rshift_bits(_w.data(), n + 3, _w.data(), 2 * t);
+    const lamp_ui r_len = rlz(_w.data(), n + 1);
+    std::copy(_w.data(), _w.data() + r_len, rem);
+    return r_len;
+}
+
+/*
+ * @brief 判断 in 是否为完全平方数
+ * @note 先用模 256、63、65、17、97 的二次剩余表排除，约 99.6% 的非平方数在 O(len) 内被拒绝
+ */
+bool abs_is_square64(lamp_ptr in, lamp_ui len) {
+    len = rlz(in, len);
+    if (len == 0) {
+        return true;
+    }
+    if (!QR256.is_qr[in[0] & 255]) {
+        return false;
+    }
+    const lamp_ui r = _mod_2pow48m1(in, len);
+    if (!QR63.is_qr[r % 63] || !QR65.is_qr[r % 65] || !QR17.is_qr[r % 17] || !QR97.is_qr[r % 97]) {
+        return false;
+    }
+    const lamp_ui n = (len + 1) / 2;
+    _internal_buffer<0> _root(n);
+    _internal_buffer<0> _rem(n + 1);
+    return abs_sqrtrem64(in, len, _root.data(), _rem.data()) == 0;
+}
+
+};  // namespace lammp::Arithmetic
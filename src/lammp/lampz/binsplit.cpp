@@ -0,0 +1,66 @@
+/*
+ * Copyright (C) 2025 HJimmyK/LAMINA
+ *
+ * This file is part of LAMMP, which is licensed under the GNU LGPL v2.1.
+ * See the LICENSE file in the project root for full license details, or visit:
+ * <https://www.gnu.org/licenses/old-licenses/lgpl-2.1.html>
+ */
+
+#include "../../../include/lammp/binsplit.hpp"
+#include "../../../include/lammp/inter_buffer.hpp"
+#include "../../../include/lammp/lampz.h"
+
+static lammp::Arithmetic::BinSplitTerm __lampz_series_term(lampz_series_term f, void* ctx) {
+    if (f == nullptr) {
+        return nullptr;
+    }
+    return [f, ctx](lamp_ui k, lamp_ptr out, bool& neg) -> lamp_ui { return f(ctx, k, out, &neg); };
+}
+
+static lammp::Arithmetic::BinSplitSeries __lampz_series(const lampz_series_t* series) {
+    return {__lampz_series_term(series->p, series->ctx), __lampz_series_term(series->q, series->ctx),
+            __lampz_series_term(series->a, series->ctx), __lampz_series_term(series->b, series->ctx)};
+}
+
+static bool __lampz_series_valid(const lampz_series_t* series) {
+    return series != nullptr && series->p != nullptr && series->q != nullptr && series->a != nullptr;
+}
+
+static void __lampz_store_num(lampz_t z, const lammp::Arithmetic::BinSplitNum& num) {
+    __lampz_store_abs(z, num.buf.data(), num.len, num.neg);
+}
+
+void lampz_series_split(lampz_t P, lampz_t Q, lampz_t B, lampz_t T, const lampz_series_t* series, lamp_ui n) {
+    if (!__lampz_series_valid(series)) {
+        if (P != nullptr) {
+            lampz_free(P);
+        }
+        if (B != nullptr) {
+            lampz_free(B);
+        }
+        lampz_free(Q);
+        lampz_free(T);
+        return;
+    }
+    lammp::Arithmetic::BinSplitNum _p, _q, _b, _t;
+    lammp::Arithmetic::binary_split(__lampz_series(series), n, P != nullptr ? &_p : nullptr, _q,
+                                    B != nullptr ? &_b : nullptr, _t);
+    if (P != nullptr) {
+        __lampz_store_num(P, _p);
+    }
+    if (B != nullptr) {
+        __lampz_store_num(B, _b);
+    }
+    __lampz_store_num(Q, _q);
+    __lampz_store_num(T, _t);
+}
+
+void lampz_series_fixed(lampz_t z, const lampz_series_t* series, lamp_ui n, lamp_ui frac_bits) {
+    if (!__lampz_series_valid(series)) {
+        lampz_free(z);
+        return;
+    }
+    lammp::Arithmetic::BinSplitNum _out;
+    lammp::Arithmetic::binary_split_fixed(__lampz_series(series), n, frac_bits, _out);
+    __lampz_store_num(z, _out);
+}
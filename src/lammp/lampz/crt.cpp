@@ -0,0 +1,100 @@
+/*
+ * Copyright (C) 2025 HJimmyK/LAMINA
+ *
+ * This file is part of LAMMP, which is licensed under the GNU LGPL v2.1.
+ * See the LICENSE file in the project root for full license details, or visit:
+ * <https://www.gnu.org/licenses/old-licenses/lgpl-2.1.html>
+ */
+
+#include <memory>
+#include <vector>
+
+#include "../../../include/lammp/lampz.h"
+#include "../../../include/lammp/prod_tree.hpp"
+
+// 由模数构造 CRT 计划，模数无效时返回空
+static std::unique_ptr<lammp::Arithmetic::CrtPlan> __lampz_crt_plan(const lampz_t m[],
+                                                                   lamp_sz count,
+                                                                   std::vector<lamp_ptr>& mods,
+                                                                   std::vector<lamp_ui>& mod_lens) {
+    if (count == 0) {
+        return nullptr;
+    }
+    mods.resize(count);
+    mod_lens.resize(count);
+    for (lamp_sz i = 0; i < count; i++) {
+        if (lampz_is_nan(m[i])) {
+            return nullptr;
+        }
+        mods[i] = m[i]->begin;
+        mod_lens[i] = lammp::Arithmetic::rlz(m[i]->begin, lampz_get_len(m[i]));
+        if (mod_lens[i] == 0) {
+            return nullptr;
+        }
+    }
+    std::unique_ptr<lammp::Arithmetic::CrtPlan> plan(
+        new lammp::Arithmetic::CrtPlan(mods.data(), mod_lens.data(), count));
+    if (!plan->valid()) {
+        return nullptr;
+    }
+    return plan;
+}
+
+// 由一组余数重建 z
+static void __lampz_crt_row(lampz_t z,
+                            const lampz_t r[],
+                            const lammp::Arithmetic::CrtPlan& plan,
+                            const std::vector<lamp_ptr>& mods,
+                            const std::vector<lamp_ui>& mod_lens) {
+    const lamp_sz count = mods.size();
+    std::vector<lamp_ptr> res(count);
+    std::vector<lamp_ui> res_lens(count);
+    // 负余数先换成 |m| - (|r| mod |m|)
+    std::vector<lammp::_internal_buffer<0>> neg_res;
+    for (lamp_sz i = 0; i < count; i++) {
+        if (lampz_is_nan(r[i])) {
+            lampz_free(z);
+            return;
+        }
+        res[i] = r[i]->begin;
+        res_lens[i] = lampz_get_len(r[i]);
+        if (lampz_get_sign(r[i]) >= 0) {
+            continue;
+        }
+        neg_res.emplace_back(mod_lens[i], 0);
+        const lamp_ptr t = neg_res.back().data();
+        const lamp_ui t_len = lammp::Arithmetic::abs_mod64(res[i], res_lens[i], mods[i], mod_lens[i], t);
+        if (t_len > 0) {
+            lammp::Arithmetic::abs_sub_binary(mods[i], mod_lens[i], t, t_len, t);
+        }
+        res[i] = t;
+        res_lens[i] = mod_lens[i];
+    }
+    lammp::_internal_buffer<0> _out(plan.size());
+    const lamp_sz out_len = plan.reconstruct(res.data(), res_lens.data(), _out.data());
+    __lampz_store_abs(z, _out.data(), out_len, false);
+}
+
+void lampz_crt(lampz_t z, const lampz_t r[], const lampz_t m[], lamp_sz count) {
+    std::vector<lamp_ptr> mods;
+    std::vector<lamp_ui> mod_lens;
+    const auto plan = __lampz_crt_plan(m, count, mods, mod_lens);
+    if (plan == nullptr) {
+        lampz_free(z);
+        return;
+    }
+    __lampz_crt_row(z, r, *plan, mods, mod_lens);
+}
+
+void lampz_crt_batch(lampz_t z[], const lampz_t r[], lamp_sz batch, const lampz_t m[], lamp_sz count) {
+    std::vector<lamp_ptr> mods;
+    std::vector<lamp_ui> mod_lens;
+    const auto plan = __lampz_crt_plan(m, count, mods, mod_lens);
+    for (lamp_sz j = 0; j < batch; j++) {
+        if (plan == nullptr) {
+            lampz_free(z[j]);
+            continue;
+        }
+        __lampz_crt_row(z[j], r + j * count, *plan, mods, mod_lens);
+    }
+}
@@ -0,0 +1,19 @@
+/*
+ * Copyright (C) 2025 HJimmyK/LAMINA
+ *
+ * This file is part of LAMMP, which is licensed under the GNU LGPL v2.1.
+ * See the LICENSE file in the project root for full license details, or visit:
+ * <https://www.gnu.org/licenses/old-licenses/lgpl-2.1.html>
+ */
+
+#include "../../../include/lammp/lammp.hpp"
+#include "../../../include/lammp/lampz.h"
+
+void lampz_factorial(lampz_t z, lamp_ui n) {
+    const lamp_sz len = lammp::Arithmetic::get_factorial_len(n);
+    if (!__lampz_reserve(z, len)) {
+        lampz_free(z);
+        return;
+    }
+    z->len = (lamp_si)lammp::Arithmetic::abs_factorial64(n, z->begin);
+}
@@ -0,0 +1,32 @@
+/*
+ * Copyright (C) 2025 HJimmyK/LAMINA
+ *
+ * This file is part of LAMMP, which is licensed under the GNU LGPL v2.1.
+ * See the LICENSE file in the project root for full license details, or visit:
+ * <https://www.gnu.org/licenses/old-licenses/lgpl-2.1.html>
+ */
+
+#include "../../../include/lammp/inter_buffer.hpp"
+#include "../../../include/lammp/lammp.hpp"
+#include "../../../include/lammp/lampz.h"
+
+void lampz_fib(lampz_t z, lamp_ui n) { lampz_fib2(z, nullptr, n); }
+
+void lampz_fib2(lampz_t z, lampz_t z_prev, lamp_ui n) {
+    const lamp_sz cap = lammp::Arithmetic::get_fib_len(n);
+    lammp::_internal_buffer<0> _fn(cap), _fn_1(cap);
+    lamp_ui fn_1_len = 0;
+    const lamp_sz fn_len = lammp::Arithmetic::abs_fib64(n, _fn.data(), z_prev != nullptr ? _fn_1.data() : nullptr,
+                                                        &fn_1_len);
+    __lampz_store_abs(z, _fn.data(), fn_len, false);
+    if (z_prev != nullptr) {
+        __lampz_store_abs(z_prev, _fn_1.data(), fn_1_len, false);
+    }
+}
+
+void lampz_lucnum(lampz_t z, lamp_ui n) {
+    const lamp_sz cap = lammp::Arithmetic::get_fib_len(n) + 1;
+    lammp::_internal_buffer<0> _ln(cap);
+    const lamp_sz ln_len = lammp::Arithmetic::abs_lucnum64(n, _ln.data());
+    __lampz_store_abs(z, _ln.data(), ln_len, false);
+}
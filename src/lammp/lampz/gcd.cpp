@@ -0,0 +1,142 @@
+/*
+ * Copyright (C) 2025 HJimmyK/LAMINA
+ *
+ * This file is part of LAMMP, which is licensed under the GNU LGPL v2.1.
+ * See the LICENSE file in the project root for full license details, or visit:
+ * <https://www.gnu.org/licenses/old-licenses/lgpl-2.1.html>
+ */
+
+#include "../../../include/lammp/inter_buffer.hpp"
+#include "../../../include/lammp/lammp.hpp"
+#include "../../../include/lammp/lampz.h"
+
+void lampz_gcd(lampz_t z, const lampz_t a, const lampz_t b) {
+    if (lampz_is_nan(a) || lampz_is_nan(b)) {
+        lampz_free(z);
+        return;
+    }
+    const lamp_sz a_len = lammp::Arithmetic::rlz(a->begin, lampz_get_len(a));
+    const lamp_sz b_len = lammp::Arithmetic::rlz(b->begin, lampz_get_len(b));
+    lammp::_internal_buffer<0> _g(std::max(std::max(a_len, b_len), lamp_sz(1)));
+    const lamp_sz g_len = lammp::Arithmetic::abs_gcd64(a->begin, a_len, b->begin, b_len, _g.data());
+    __lampz_store_abs(z, _g.data(), g_len, false);
+}
+
+void lampz_lcm(lampz_t z, const lampz_t a, const lampz_t b) {
+    if (lampz_is_nan(a) || lampz_is_nan(b)) {
+        lampz_free(z);
+        return;
+    }
+    lamp_sz a_len = lammp::Arithmetic::rlz(a->begin, lampz_get_len(a));
+    lamp_sz b_len = lammp::Arithmetic::rlz(b->begin, lampz_get_len(b));
+    if (a_len == 0 || b_len == 0) {
+        __lampz_store_abs(z, nullptr, 0, false);
+        return;
+    }
+    lammp::_internal_buffer<0> _g(std::max(a_len, b_len));
+    const lamp_sz g_len = lammp::Arithmetic::abs_gcd64(a->begin, a_len, b->begin, b_len, _g.data());
+    // lcm = (a / g) * b，先除后乘使被除数最短
+    if (a_len > b_len) {
+        std::swap(a, b);
+        std::swap(a_len, b_len);
+    }
+    const lamp_sz q_len = a_len - g_len + 1;
+    lammp::_internal_buffer<0> _q(q_len + 2, 0);
+    lammp::Arithmetic::abs_div64(a->begin, a_len, _g.data(), g_len, _q.data());
+    const lamp_sz q_real = lammp::Arithmetic::rlz(_q.data(), q_len);
+    lammp::_internal_buffer<0> _res(q_real + b_len);
+    lammp::Arithmetic::abs_mul64(b->begin, b_len, _q.data(), q_real, _res.data());
+    __lampz_store_abs(z, _res.data(), lammp::Arithmetic::rlz(_res.data(), q_real + b_len), false);
+}
+
+void lampz_gcdext(lampz_t g, lampz_t s, lampz_t t, const lampz_t a, const lampz_t b) {
+    if (lampz_is_nan(a) || lampz_is_nan(b)) {
+        lampz_free(g);
+        if (s != nullptr) {
+            lampz_free(s);
+        }
+        if (t != nullptr) {
+            lampz_free(t);
+        }
+        return;
+    }
+    const lamp_sz a_len = lammp::Arithmetic::rlz(a->begin, lampz_get_len(a));
+    const lamp_sz b_len = lammp::Arithmetic::rlz(b->begin, lampz_get_len(b));
+    const bool a_neg = lampz_get_sign(a) < 0, b_neg = lampz_get_sign(b) < 0;
+    const lamp_sz max_len = std::max(std::max(a_len, b_len), lamp_sz(1));
+
+    // |a| * s' + |b| * t' = g，再按 a、b 的符号调整 s、t
+    lammp::_internal_buffer<0> _g(max_len);
+    lammp::_internal_buffer<0> _s(max_len);
+    lammp::_internal_buffer<0> _t(1, 0);
+    lamp_ui s_len = 0, t_len = 0;
+    bool s_neg = false, t_neg = false;
+    lamp_sz g_len;
+    if (b_len == 0) {
+        // gcd(a, 0) = |a|，s' = 1（a 也为零时取 0）
+        std::copy(a->begin, a->begin + a_len, _g.data());
+        g_len = a_len;
+        _s.set(0, 1);
+        s_len = a_len > 0;
+    } else {
+        g_len = lammp::Arithmetic::abs_gcdext64(a->begin, a_len, b->begin, b_len, _g.data(), _s.data(), s_len,
+                                                s_neg);
+        if (t != nullptr) {
+            // t' = (g - s' * |a|) / |b|，必为整除
+            const lamp_sz num_cap = std::max(lamp_sz(s_len + a_len), g_len) + 2;
+            lammp::_internal_buffer<0> _num(num_cap, 0);
+            lamp_ptr num = _num.data();
+            if (s_len > 0 && a_len > 0) {
+                lammp::Arithmetic::abs_mul64(_s.data(), s_len, a->begin, a_len, num);
+            }
+            lamp_sz num_len = lammp::Arithmetic::rlz(num, s_len + a_len);
+            if (s_neg) {
+                lammp::Arithmetic::abs_add_binary(num, num_len, _g.data(), g_len, num);
+            } else if (lammp::Arithmetic::abs_compare(num, num_len, _g.data(), g_len) >= 0) {
+                t_neg = true;
+                lammp::Arithmetic::abs_sub_binary(num, num_len, _g.data(), g_len, num);
+            } else {
+                lammp::Arithmetic::abs_sub_binary(_g.data(), g_len, num, num_len, num);
+            }
+            num_len = lammp::Arithmetic::rlz(num, num_cap);
+            if (num_len >= b_len) {
+                _t = lammp::_internal_buffer<0>(num_len - b_len + 3, 0);
+                lammp::Arithmetic::abs_div64(num, num_len, b->begin, b_len, _t.data());
+                t_len = lammp::Arithmetic::rlz(_t.data(), num_len - b_len + 1);
+            }
+            t_neg = t_neg && t_len > 0;
+        }
+    }
+    if (s != nullptr) {
+        __lampz_store_abs(s, _s.data(), s_len, s_neg != a_neg);
+    }
+    if (t != nullptr) {
+        __lampz_store_abs(t, _t.data(), t_len, t_neg != b_neg);
+    }
+    __lampz_store_abs(g, _g.data(), g_len, false);
+}
+
+void lampz_inv_mod(lampz_t z, const lampz_t a, const lampz_t mod) {
+    if (lampz_is_nan(a) || lampz_is_nan(mod)) {
+        lampz_free(z);
+        return;
+    }
+    const lamp_sz a_len = lammp::Arithmetic::rlz(a->begin, lampz_get_len(a));
+    const lamp_sz mod_len = lammp::Arithmetic::rlz(mod->begin, lampz_get_len(mod));
+    if (mod_len == 0) {
+        lampz_free(z);
+        return;
+    }
+    lammp::_internal_buffer<0> _res(mod_len);
+    lamp_ui res_len = 0;
+    if (!lammp::Arithmetic::abs_inv_mod64(a->begin, a_len, mod->begin, mod_len, _res.data(), res_len)) {
+        lampz_free(z);
+        return;
+    }
+    // (-a)^-1 = mod - a^-1
+    if (lampz_get_sign(a) < 0 && res_len > 0) {
+        lammp::Arithmetic::abs_sub_binary(mod->begin, mod_len, _res.data(), res_len, _res.data());
+        res_len = lammp::Arithmetic::rlz(_res.data(), mod_len);
+    }
+    __lampz_store_abs(z, _res.data(), res_len, false);
+}
@@ -0,0 +1,62 @@
+/*
+ * Copyright (C) 2025 HJimmyK/LAMINA
+ *
+ * This file is part of LAMMP, which is licensed under the GNU LGPL v2.1.
+ * See the LICENSE file in the project root for full license details, or visit:
+ * <https://www.gnu.org/licenses/old-licenses/lgpl-2.1.html>
+ */
+
+#include "../../../include/lammp/inter_buffer.hpp"
+#include "../../../include/lammp/lampz.h"
+#include "../../../include/lammp/mat22.hpp"
+
+static bool __lampz_mat22_view(const lampz_t m[], lammp::Arithmetic::Mat22& v) {
+    for (int i = 0; i < 4; i++) {
+        if (lampz_is_nan(m[i])) {
+            return false;
+        }
+        v.ptr[i] = m[i]->begin;
+        v.len[i] = lampz_get_len(m[i]);
+        v.neg[i] = lampz_get_sign(m[i]) < 0;
+    }
+    return true;
+}
+
+static void __lampz_mat22_store(lampz_t c[], const lammp::Arithmetic::Mat22& v) {
+    for (int i = 0; i < 4; i++) {
+        __lampz_store_abs(c[i], v.ptr[i], v.len[i], v.neg[i]);
+    }
+}
+
+static void __lampz_mat22_nan(lampz_t c[]) {
+    for (int i = 0; i < 4; i++) {
+        lampz_free(c[i]);
+    }
+}
+
+void lampz_mat22_mul(lampz_t c[], const lampz_t a[], const lampz_t b[]) {
+    lammp::Arithmetic::Mat22 _a, _b, _c;
+    if (!__lampz_mat22_view(a, _a) || !__lampz_mat22_view(b, _b)) {
+        __lampz_mat22_nan(c);
+        return;
+    }
+    // 先写入临时缓冲区，c 可以与 a、b 相同
+    const lamp_sz cap = lammp::Arithmetic::get_mat22_mul_len(_a, _b);
+    lammp::_internal_buffer<0> _res(cap * 4);
+    for (int i = 0; i < 4; i++) {
+        _c.ptr[i] = _res.data() + cap * i;
+    }
+    lammp::Arithmetic::mat22_mul(_a, a == b ? _a : _b, _c);
+    __lampz_mat22_store(c, _c);
+}
+
+void lampz_mat22_pow(lampz_t c[], const lampz_t a[], lamp_ui exp) {
+    lammp::Arithmetic::Mat22 _a, _c;
+    if (!__lampz_mat22_view(a, _a)) {
+        __lampz_mat22_nan(c);
+        return;
+    }
+    lammp::_internal_buffer<0> _res;
+    lammp::Arithmetic::mat22_pow(_a, exp, _res, _c);
+    __lampz_mat22_store(c, _c);
+}
@@ -0,0 +1,62 @@
+/*
+ * Copyright (C) 2025 HJimmyK/LAMINA
+ *
+ * This file is part of LAMMP, which is licensed under the GNU LGPL v2.1.
+ * See the LICENSE file in the project root for full license details, or visit:
+ * <https://www.gnu.org/licenses/old-licenses/lgpl-2.1.html>
+ */
+
+#include <vector>
+
+#include "../../../include/lammp/inter_buffer.hpp"
+#include "../../../include/lammp/lammp.hpp"
+#include "../../../include/lammp/lampz.h"
+
+void lampz_mod_multi(lampz_t z[], const lampz_t x, const lampz_t m[], lamp_sz count) {
+    if (lampz_is_nan(x)) {
+        for (lamp_sz i = 0; i < count; i++) {
+            lampz_free(z[i]);
+        }
+        return;
+    }
+    // 收集有效的模数，无效项直接置为 nan
+    std::vector<lamp_sz> index;
+    std::vector<lamp_ptr> mods;
+    std::vector<lamp_ui> mod_lens;
+    index.reserve(count);
+    lamp_sz total = 0;
+    for (lamp_sz i = 0; i < count; i++) {
+        const lamp_sz len = lampz_is_nan(m[i]) ? 0 : lammp::Arithmetic::rlz(m[i]->begin, lampz_get_len(m[i]));
+        if (len == 0) {
+            lampz_free(z[i]);
+            continue;
+        }
+        index.push_back(i);
+        mods.push_back(m[i]->begin);
+        mod_lens.push_back(len);
+        total += len;
+    }
+    const lamp_sz valid = index.size();
+    if (valid == 0) {
+        return;
+    }
+    lammp::_internal_buffer<0> _res(total);
+    std::vector<lamp_ptr> outs(valid);
+    std::vector<lamp_ui> out_lens(valid);
+    total = 0;
+    for (lamp_sz i = 0; i < valid; i++) {
+        outs[i] = _res.data() + total;
+        total += mod_lens[i];
+    }
+    const bool neg = lampz_get_sign(x) < 0;
+    lammp::Arithmetic::abs_mod_multi64(x->begin, lampz_get_len(x), mods.data(), mod_lens.data(), valid, outs.data(),
+                                       out_lens.data());
+    for (lamp_sz i = 0; i < valid; i++) {
+        // x < 0 时 x mod m = |m| - (|x| mod m)
+        if (neg && out_lens[i] > 0) {
+            lammp::Arithmetic::abs_sub_binary(mods[i], mod_lens[i], outs[i], out_lens[i], outs[i]);
+            out_lens[i] = lammp::Arithmetic::rlz(outs[i], mod_lens[i]);
+        }
+        __lampz_store_abs(z[index[i]], outs[i], out_lens[i], false);
+    }
+}
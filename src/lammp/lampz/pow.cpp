@@ -0,0 +1,25 @@
+/*
+ * Copyright (C) 2025 HJimmyK/LAMINA
+ *
+ * This file is part of LAMMP, which is licensed under the GNU LGPL v2.1.
+ * See the LICENSE file in the project root for full license details, or visit:
+ * <https://www.gnu.org/licenses/old-licenses/lgpl-2.1.html>
+ */
+
+#include "../../../include/lammp/inter_buffer.hpp"
+#include "../../../include/lammp/lammp.hpp"
+#include "../../../include/lammp/lampz.h"
+
+void lampz_pow(lampz_t z, const lampz_t base, lamp_ui exp) {
+    if (lampz_is_nan(base)) {
+        lampz_free(z);
+        return;
+    }
+    const lamp_sz base_len = lampz_get_len(base);
+    const bool neg = lampz_get_sign(base) < 0 && exp % 2 == 1;
+    // 先写入临时缓冲区，z 可以与 base 相同
+    const lamp_sz cap = lammp::Arithmetic::get_pow_len(base->begin, base_len, exp);
+    lammp::_internal_buffer<0> _res(cap);
+    const lamp_sz res_len = lammp::Arithmetic::abs_pow64(base->begin, base_len, exp, _res.data());
+    __lampz_store_abs(z, _res.data(), res_len, neg);
+}
@@ -0,0 +1,111 @@
+/*
+ * Copyright (C) 2025 HJimmyK/LAMINA
+ *
+ * This file is part of LAMMP, which is licensed under the GNU LGPL v2.1.
+ * See the LICENSE file in the project root for full license details, or visit:
+ * <https://www.gnu.org/licenses/old-licenses/lgpl-2.1.html>
+ */
+
+#include <vector>
+#include "../../../include/lammp/inter_buffer.hpp"
+#include "../../../include/lammp/lammp.hpp"
+#include "../../../include/lammp/lampz.h"
+
+// res 为 |base|^exp mod mod，负底数的奇数次幂取 mod - res，返回新的长度
+static lamp_sz __lampz_pow_mod_sign(lamp_ptr res,
+                                    lamp_sz res_len,
+                                    const lampz_t base,
+                                    const lampz_t exp,
+                                    lamp_ptr mod,
+                                    lamp_sz mod_len) {
+    const lamp_sz exp_len = lammp::Arithmetic::rlz(exp->begin, lampz_get_len(exp));
+    if (lampz_get_sign(base) < 0 && exp_len > 0 && (exp->begin[0] & 1) == 1 && res_len > 0) {
+        lammp::Arithmetic::abs_sub_binary(mod, mod_len, res, res_len, res);
+        res_len = lammp::Arithmetic::rlz(res, mod_len);
+    }
+    return res_len;
+}
+
+void lampz_pow_mod(lampz_t z, const lampz_t base, const lampz_t exp, const lampz_t mod) {
+    if (lampz_is_nan(base) || lampz_is_nan(exp) || lampz_is_nan(mod) || lampz_get_sign(exp) < 0) {
+        lampz_free(z);
+        return;
+    }
+    lamp_sz base_len = lammp::Arithmetic::rlz(base->begin, lampz_get_len(base));
+    lamp_sz exp_len = lammp::Arithmetic::rlz(exp->begin, lampz_get_len(exp));
+    lamp_sz mod_len = lammp::Arithmetic::rlz(mod->begin, lampz_get_len(mod));
+    if (mod_len == 0) {
+        lampz_free(z);
+        return;
+    }
+    // 先写入临时缓冲区，z 可以与任一参数相同
+    lammp::_internal_buffer<0> _res(mod_len);
+    lamp_ptr res = _res.data();
+    lamp_sz res_len = lammp::Arithmetic::abs_pow_mod64(base->begin, base_len, exp->begin, exp_len, mod->begin,
+                                                       mod_len, res);
+    res_len = __lampz_pow_mod_sign(res, res_len, base, exp, mod->begin, mod_len);
+    __lampz_store_abs(z, res, res_len, false);
+}
+
+void lampz_pow_mod_batch(lampz_t z[],
+                         const lampz_t base[],
+                         lamp_sz count,
+                         const lampz_t exp[],
+                         lamp_sz exp_count,
+                         const lampz_t mod) {
+    const bool shared_exp = exp_count == 1;
+    lamp_sz mod_len = lampz_is_nan(mod) ? 0 : lammp::Arithmetic::rlz(mod->begin, lampz_get_len(mod));
+    if (mod_len == 0 || (!shared_exp && exp_count != count) ||
+        (shared_exp && (lampz_is_nan(exp[0]) || lampz_get_sign(exp[0]) < 0))) {
+        for (lamp_sz i = 0; i < count; i++) {
+            lampz_free(z[i]);
+        }
+        return;
+    }
+    // 收集有效的参数；z[i] 可能与 base、exp 中的元素或 mod 是同一对象，
+    // 因此全部读取（计算、符号修正）完成之后才写入 z，无效项最后置为 nan
+    std::vector<lamp_sz> index, invalid;
+    std::vector<lamp_ptr> bases, exps;
+    std::vector<lamp_ui> base_lens, exp_lens;
+    index.reserve(count);
+    for (lamp_sz i = 0; i < count; i++) {
+        const lampz_t& e = shared_exp ? exp[0] : exp[i];
+        if (lampz_is_nan(base[i]) || lampz_is_nan(e) || lampz_get_sign(e) < 0) {
+            invalid.push_back(i);
+            continue;
+        }
+        index.push_back(i);
+        bases.push_back(base[i]->begin);
+        base_lens.push_back(lampz_get_len(base[i]));
+        if (!shared_exp || exps.empty()) {
+            exps.push_back(e->begin);
+            exp_lens.push_back(lampz_get_len(e));
+        }
+    }
+    const lamp_sz valid = index.size();
+    if (valid == 0) {
+        for (lamp_sz i : invalid) {
+            lampz_free(z[i]);
+        }
+        return;
+    }
+    lammp::_internal_buffer<0> _res(valid * mod_len);
+    std::vector<lamp_ptr> outs(valid);
+    std::vector<lamp_ui> out_lens(valid);
+    for (lamp_sz i = 0; i < valid; i++) {
+        outs[i] = _res.data() + i * mod_len;
+    }
+    lammp::Arithmetic::abs_pow_mod64_batch(bases.data(), base_lens.data(), valid, exps.data(), exp_lens.data(),
+                                           exps.size(), mod->begin, mod_len, outs.data(), out_lens.data());
+    for (lamp_sz i = 0; i < valid; i++) {
+        const lamp_sz k = index[i];
+        out_lens[i] = __lampz_pow_mod_sign(outs[i], out_lens[i], base[k], shared_exp ? exp[0] : exp[k], mod->begin,
+                                           mod_len);
+    }
+    for (lamp_sz i : invalid) {
+        lampz_free(z[i]);
+    }
+    for (lamp_sz i = 0; i < valid; i++) {
+        __lampz_store_abs(z[index[i]], outs[i], out_lens[i], false);
+    }
+}
@@ -0,0 +1,45 @@
+/*
+ * Copyright (C) 2025 HJimmyK/LAMINA
+ *
+ * This file is part of LAMMP, which is licensed under the GNU LGPL v2.1.
+ * See the LICENSE file in the project root for full license details, or visit:
+ * <https://www.gnu.org/licenses/old-licenses/lgpl-2.1.html>
+ */
+
+#include <memory>
+#include <vector>
+#include "../../../include/lammp/lammp.hpp"
+#include "../../../include/lammp/lampz.h"
+
+bool lampz_is_prime(const lampz_t n) {
+    if (lampz_is_nan(n) || lampz_get_sign(n) < 0) {
+        return false;
+    }
+    return lammp::Arithmetic::abs_is_prime64(n->begin, lampz_get_len(n));
+}
+
+void lampz_is_prime_batch(bool res[], const lampz_t n[], lamp_sz count) {
+    // 负数与 nan 直接为 false，其余交给 abs_is_prime64_batch
+    std::vector<lamp_sz> index;
+    std::vector<lamp_ptr> ins;
+    std::vector<lamp_ui> lens;
+    index.reserve(count);
+    for (lamp_sz i = 0; i < count; i++) {
+        if (lampz_is_nan(n[i]) || lampz_get_sign(n[i]) < 0) {
+            res[i] = false;
+            continue;
+        }
+        index.push_back(i);
+        ins.push_back(n[i]->begin);
+        lens.push_back(lampz_get_len(n[i]));
+    }
+    const lamp_sz valid = index.size();
+    if (valid == 0) {
+        return;
+    }
+    std::unique_ptr<bool[]> outs(new bool[valid]);
+    lammp::Arithmetic::abs_is_prime64_batch(ins.data(), lens.data(), valid, outs.get());
+    for (lamp_sz i = 0; i < valid; i++) {
+        res[index[i]] = outs[i];
+    }
+}
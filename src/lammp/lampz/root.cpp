@@ -0,0 +1,42 @@
+/*
+ * Copyright (C) 2025 HJimmyK/LAMINA
+ *
+ * This file is part of LAMMP, which is licensed under the GNU LGPL v2.1.
+ * See the LICENSE file in the project root for full license details, or visit:
+ * <https://www.gnu.org/licenses/old-licenses/lgpl-2.1.html>
+ */
+
+#include "../../../include/lammp/inter_buffer.hpp"
+#include "../../../include/lammp/lammp.hpp"
+#include "../../../include/lammp/lampz.h"
+
+void lampz_rootrem(lampz_t z, lampz_t r, const lampz_t x, lamp_ui k) {
+    const bool neg = !lampz_is_nan(x) && lampz_get_sign(x) < 0;
+    if (lampz_is_nan(x) || k == 0 || (neg && k % 2 == 0)) {
+        lampz_free(z);
+        if (r != nullptr) {
+            lampz_free(r);
+        }
+        return;
+    }
+    const lamp_sz x_len = lammp::Arithmetic::rlz(x->begin, lampz_get_len(x));
+    const lamp_sz root_len = (x_len + k - 1) / k;
+    // 先写入临时缓冲区，z、r 可以与 x 相同；(-x)^(1/k) = -(x^(1/k))，余数与 x 同号
+    lammp::_internal_buffer<0> _root(root_len + 1, 0);
+    lammp::_internal_buffer<0> _rem(x_len + 1, 0);
+    const lamp_sz rem_len = lammp::Arithmetic::abs_rootrem64(x->begin, x_len, k, _root.data(),
+                                                             r != nullptr ? _rem.data() : nullptr);
+    __lampz_store_abs(z, _root.data(), lammp::Arithmetic::rlz(_root.data(), root_len), neg);
+    if (r != nullptr) {
+        __lampz_store_abs(r, _rem.data(), rem_len, neg);
+    }
+}
+
+void lampz_root(lampz_t z, const lampz_t x, lamp_ui k) { lampz_rootrem(z, nullptr, x, k); }
+
+bool lampz_perfect_power_p(const lampz_t x) {
+    if (lampz_is_nan(x)) {
+        return false;
+    }
+    return lammp::Arithmetic::abs_is_perfect_power64(x->begin, lampz_get_len(x), lampz_get_sign(x) < 0);
+}
@@ -0,0 +1,28 @@
+/*
+ * Copyright (C) 2025 HJimmyK/LAMINA
+ *
+ * This file is part of LAMMP, which is licensed under the GNU LGPL v2.1.
+ * See the LICENSE file in the project root for full license details, or visit:
+ * <https://www.gnu.org/licenses/old-licenses/lgpl-2.1.html>
+ */
+
+#include "../../../include/lammp/inter_buffer.hpp"
+#include "../../../include/lammp/lammp.hpp"
+#include "../../../include/lammp/lampz.h"
+
+// 平方与符号无关，只用 |x|；先写入临时缓冲区，z 可以与 x 相同
+static void __lampz_sqr_mod_2pow(lampz_t z, const lampz_t x, lamp_ui p, bool plus) {
+    if (lampz_is_nan(x) || p == 0) {
+        lampz_free(z);
+        return;
+    }
+    const lamp_sz x_len = lammp::Arithmetic::rlz(x->begin, lampz_get_len(x));
+    lammp::_internal_buffer<0> _res(p / 64 + 1);
+    const lamp_sz res_len = plus ? lammp::Arithmetic::abs_sqr_mod_fermat64(x->begin, x_len, p, _res.data())
+                                 : lammp::Arithmetic::abs_sqr_mod_mersenne64(x->begin, x_len, p, _res.data());
+    __lampz_store_abs(z, _res.data(), res_len, false);
+}
+
+void lampz_sqr_mod_mersenne(lampz_t z, const lampz_t x, lamp_ui p) { __lampz_sqr_mod_2pow(z, x, p, false); }
+
+void lampz_sqr_mod_fermat(lampz_t z, const lampz_t x, lamp_ui p) { __lampz_sqr_mod_2pow(z, x, p, true); }
@@ -0,0 +1,41 @@
+/*
+ * Copyright (C) 2025 HJimmyK/LAMINA
+ *
+ * This file is part of LAMMP, which is licensed under the GNU LGPL v2.1.
+ * See the LICENSE file in the project root for full license details, or visit:
+ * <https://www.gnu.org/licenses/old-licenses/lgpl-2.1.html>
+ */
+
+#include "../../../include/lammp/inter_buffer.hpp"
+#include "../../../include/lammp/lammp.hpp"
+#include "../../../include/lammp/lampz.h"
+
+void lampz_sqrtrem(lampz_t s, lampz_t r, const lampz_t x) {
+    if (lampz_is_nan(x) || lampz_get_sign(x) < 0) {
+        lampz_free(s);
+        if (r != nullptr) {
+            lampz_free(r);
+        }
+        return;
+    }
+    const lamp_sz x_len = lammp::Arithmetic::rlz(x->begin, lampz_get_len(x));
+    const lamp_sz root_len = (x_len + 1) / 2;
+    // 先写入临时缓冲区，s、r 可以与 x 相同
+    lammp::_internal_buffer<0> _root(root_len + 1, 0);
+    lammp::_internal_buffer<0> _rem(root_len + 2, 0);
+    const lamp_sz rem_len = lammp::Arithmetic::abs_sqrtrem64(x->begin, x_len, _root.data(),
+                                                             r != nullptr ? _rem.data() : nullptr);
+    __lampz_store_abs(s, _root.data(), lammp::Arithmetic::rlz(_root.data(), root_len), false);
+    if (r != nullptr) {
+        __lampz_store_abs(r, _rem.data(), rem_len, false);
+    }
+}
+
+void lampz_sqrt(lampz_t z, const lampz_t x) { lampz_sqrtrem(z, nullptr, x); }
+
+bool lampz_is_square(const lampz_t x) {
+    if (lampz_is_nan(x) || lampz_get_sign(x) < 0) {
+        return false;
+    }
+    return lammp::Arithmetic::abs_is_square64(x->begin, lampz_get_len(x));
+}
@@ -6,12 +6,32 @@
  * <https://www.gnu.org/licenses/old-licenses/lgpl-2.1.html>
  */
 
+#include "../../../include/lammp/inter_buffer.hpp"
 #include "../../../include/lammp/lammp.hpp"
 #include "../../../include/lammp/lampz.h"
 #include "../../../include/lammp/numeral_table.h"
 #include "math.h"
 #include <stdexcept>
 #include <cstring>
+#include <cerrno>
+#include <algorithm>
+#include <vector>
+#if defined(__SSE4_1__)
+#include <smmintrin.h>
+#endif
+#if defined(_WIN32)
+#include <fcntl.h>
+#include <io.h>
+#define __lampz_write _write
+#define __lampz_read _read
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define __lampz_write write
+#define __lampz_read read
+#endif
 
 void str_reverse(char* s) {
     if (s == NULL || *s == '\0') { 
@@ -33,18 +53,14 @@ void str_reverse(char* s) {
 lamp_sz lampz_to_str_len(const lampz_t z, lamp_sz base) {
     lamp_sz len = lampz_get_len(z);
     lamp_sz res = 0;
-    if (base == 2) {
-        res = len * LAMPUI_BITS;
-    } else if (base == 16) {
-        res = len * 8;
+    if ((base & (base - 1)) == 0) {
+        // 2 的幂进制每个字符恰好 log2(base) 位
+        const lamp_sz bits = lamp_sz(log2(base) + 0.5);
+        res = (len * LAMPUI_BITS + bits - 1) / bits;
     } else {
-        if (len <= 1) {
-            res = GET_BASE_LEN(base);
-        } else if (len == 2) {
-            res = 2 * GET_BASE_LEN(base);
-        } else {
-            res = ceil((double)len * double(LAMPUI_BITS) / log2(base)) + GET_BASE_LEN(base);
-        }
+        // binary2base 的结果不超过 floor(64 * len / log2(base_num)) + 1 个 base_num 位，每位 GET_BASE_LEN(base) 个字符
+        const double limb_bits = double(GET_BASE_LEN(base)) * log2(double(base));
+        res = (lamp_sz(double(len) * double(LAMPUI_BITS) / limb_bits) + 1) * GET_BASE_LEN(base);
     }
     return res + 2; // 加上'\0'和'-'符号位
 }
@@ -60,6 +76,112 @@ lamp_sz to_lampz_len(lamp_sz str_len, lamp_sz base) {
     return (bit + LAMPUI_BITS - 1) / LAMPUI_BITS;
 }
 
+/*
+ * SWAR 解析：一次装载 8 个字符到一个 64 位字，校验与数值合并在同一遍内完成。
+ * 十进制相邻的 2、4、8 位依次乘 10、100、10000 后相加，3 次乘法得到 8 位数字；十六进制只需移位拼接。
+ * msb_first 为 true 时 p[0] 为最高位（流式输入），否则 p[0] 为最低位（set_str 的小端序字符数组）。
+ * 按小端序装载，LAMMP 只面向小端平台；编译器开启 SSE4.1 时十进制一次处理 16 个字符
+ */
+constexpr lamp_ui SWAR_ONES = 0x0101010101010101ull;
+constexpr lamp_ui SWAR_HIGH = 0x8080808080808080ull;
+
+static inline lamp_ui __lampz_load8(const char* p) {
+    lamp_ui v;
+    std::memcpy(&v, p, 8);
+    return v;
+}
+
+// 每个字节的最高位：x >= c 时为 1，要求每个字节 < 0x80
+static inline lamp_ui __lampz_swar_ge(lamp_ui x, lamp_ui c) { return (x + (0x80 - c) * SWAR_ONES) & SWAR_HIGH; }
+
+// 8 个十进制字符，非法字符返回 false
+template <bool msb_first>
+static inline bool __lampz_parse8_dec(const char* p, lamp_ui& out) {
+    lamp_ui t = __lampz_load8(p) - '0' * SWAR_ONES;
+    // 小于 '0' 时借位使最高位置 1，大于 '9' 时加 0x76 后最高位置 1
+    if (((t | (t + 0x76 * SWAR_ONES)) & SWAR_HIGH) != 0) {
+        return false;
+    }
+    constexpr lamp_ui m8 = 0x00FF00FF00FF00FFull, m16 = 0x0000FFFF0000FFFFull, m32 = 0x00000000FFFFFFFFull;
+    if (msb_first) {
+        t = (t & m8) * 10 + ((t >> 8) & m8);
+        t = (t & m16) * 100 + ((t >> 16) & m16);
+        out = (t & m32) * 10000 + (t >> 32);
+    } else {
+        t = (t & m8) + ((t >> 8) & m8) * 10;
+        t = (t & m16) + ((t >> 16) & m16) * 100;
+        out = (t & m32) + (t >> 32) * 10000;
+    }
+    return true;
+}
+
+// 16 个十进制字符
+template <bool msb_first>
+static inline bool __lampz_parse16_dec(const char* p, lamp_ui& out) {
+#if defined(__SSE4_1__)
+    const __m128i t = _mm_sub_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)), _mm_set1_epi8('0'));
+    if (_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_max_epu8(t, _mm_set1_epi8(9)), _mm_set1_epi8(9))) != 0xFFFF) {
+        return false;
+    }
+    // 相邻两字节、两个 16 位、两个 32 位依次合并，得到两个 8 位数字
+    const __m128i w1 = msb_first ? _mm_set1_epi16(0x010A) : _mm_set1_epi16(0x0A01);
+    const __m128i w2 = msb_first ? _mm_set1_epi32(0x00010064) : _mm_set1_epi32(0x00640001);
+    const __m128i w4 = msb_first ? _mm_set1_epi32(0x00012710) : _mm_set1_epi32(0x27100001);
+    __m128i v = _mm_madd_epi16(_mm_maddubs_epi16(t, w1), w2);
+    v = _mm_madd_epi16(_mm_packus_epi32(v, v), w4);
+    const lamp_ui first = lamp_ui(uint32_t(_mm_cvtsi128_si32(v))), second = lamp_ui(uint32_t(_mm_extract_epi32(v, 1)));
+    out = msb_first ? first * 100000000 + second : first + second * 100000000;
+    return true;
+#else
+    lamp_ui first, second;
+    if (!__lampz_parse8_dec<msb_first>(p, first) || !__lampz_parse8_dec<msb_first>(p + 8, second)) {
+        return false;
+    }
+    out = msb_first ? first * 100000000 + second : first + second * 100000000;
+    return true;
+#endif
+}
+
+// 8 个 2^bits 进制字符（bits <= 5，'0'-'9'、'a'-'v'，大小写均可），得到 8 * bits 位
+template <int bits, bool msb_first>
+static inline bool __lampz_parse8_pow2(const char* p, lamp_ui& out) {
+    const lamp_ui v = __lampz_load8(p);
+    if ((v & SWAR_HIGH) != 0) {
+        return false;
+    }
+    const lamp_ui x = v | 0x20 * SWAR_ONES;  // 'A'-'Z' -> 'a'-'z'，数字不变
+    const lamp_ui digit = __lampz_swar_ge(v, '0') & ~__lampz_swar_ge(v, '9' + 1);
+    const lamp_ui alpha = __lampz_swar_ge(x, 'a') & ~__lampz_swar_ge(x, 'z' + 1);
+    // 数字取低 4 位；字母取低 5 位再加 9（'a' & 0x1F = 1），alpha >> 3 在字母字节上为 0x10
+    lamp_ui t = (x & 0x0F * SWAR_ONES) + (x & (alpha >> 3)) + (alpha >> 7) * 9;
+    if ((digit | alpha) != SWAR_HIGH || __lampz_swar_ge(t, lamp_ui(1) << bits) != 0) {
+        return false;
+    }
+    constexpr lamp_ui m8 = 0x00FF00FF00FF00FFull, m16 = 0x0000FFFF0000FFFFull, m32 = 0x00000000FFFFFFFFull;
+    if (msb_first) {
+        t = ((t & m8) << bits) | ((t >> 8) & m8);
+        t = ((t & m16) << (2 * bits)) | ((t >> 16) & m16);
+        out = ((t & m32) << (4 * bits)) | (t >> 32);
+    } else {
+        t = (t & m8) | (((t >> 8) & m8) << bits);
+        t = (t & m16) | (((t >> 16) & m16) << (2 * bits));
+        out = (t & m32) | ((t >> 32) << (4 * bits));
+    }
+    return true;
+}
+
+// __lampz_parse8_pow2 的逆：v 的低 8 * bits 位写成 8 个小写字符，p[0] 为最低位
+template <int bits>
+static inline void __lampz_format8_pow2(lamp_ui v, char* p) {
+    constexpr lamp_ui m1 = (lamp_ui(1) << bits) - 1, m2 = (lamp_ui(1) << (2 * bits)) - 1;
+    constexpr lamp_ui m4 = (lamp_ui(1) << (4 * bits)) - 1;
+    lamp_ui t = (v & m4) | ((v >> (4 * bits)) << 32);
+    t = (t & m2 * 0x0000000100000001ull) | (((t >> (2 * bits)) & m2 * 0x0000000100000001ull) << 16);
+    t = (t & m1 * 0x0001000100010001ull) | (((t >> bits) & m1 * 0x0001000100010001ull) << 8);
+    t += '0' * SWAR_ONES + (__lampz_swar_ge(t, 10) >> 7) * ('a' - '0' - 10);
+    std::memcpy(p, &t, 8);
+}
+
 /**
  * @brief 小端序二进制字符串数组 -> 64位无符号整数
  * @param bin_array 输入：二进制字符数组（每个元素是'0'或'1'），小端序（索引0=数字低位）
@@ -87,6 +209,14 @@ lamp_ui bin_array_le_to_ui(const char bin_array[], lamp_sz len) {
 lamp_ui hex_array_le_to_ui(const char hex_array[], lamp_sz len) {
     assert(hex_array != nullptr && len > 0 && len <= 16);
 
+    if (len == 16) {
+        lamp_ui lo, hi;
+        if (!__lampz_parse8_pow2<4, false>(hex_array, lo) || !__lampz_parse8_pow2<4, false>(hex_array + 8, hi)) {
+            assert(false && "hex_array_le_to_ui: invalid hex character");
+            return 0;
+        }
+        return lo | (hi << 32);
+    }
     lamp_ui result = 0;
     for (lamp_sz i = 0; i < len; ++i) {
         char c = hex_array[i];
@@ -119,7 +249,25 @@ lamp_ui char_array_le_to_ui(const char char_array[], lamp_sz len, lamp_sz base)
     assert(char_array != nullptr && len > 0 && len <= GET_BASE_LEN(base));
     lamp_ui result = 0;
     lamp_ui pow_i = 1;
-    for (lamp_sz i = 0; i < len; ++i) {
+    lamp_sz i = 0;
+    if (base == 10) {
+        // 十进制整块由 SWAR 处理，剩余不足 8 位的逐字符处理
+        for (lamp_ui chunk; i + 16 <= len; i += 16, pow_i *= 10000000000000000ull) {
+            if (!__lampz_parse16_dec<false>(char_array + i, chunk)) {
+                assert(false && "char_array_le_to_ui: invalid decimal character");
+                return 0;
+            }
+            result += chunk * pow_i;
+        }
+        for (lamp_ui chunk; i + 8 <= len; i += 8, pow_i *= 100000000ull) {
+            if (!__lampz_parse8_dec<false>(char_array + i, chunk)) {
+                assert(false && "char_array_le_to_ui: invalid decimal character");
+                return 0;
+            }
+            result += chunk * pow_i;
+        }
+    }
+    for (; i < len; ++i) {
         char c = char_array[i];
         lamp_ui val;
         if (c >= '0' && c <= '9') {
@@ -172,15 +320,12 @@ void ui_to_hex_array_le(lamp_ui val, char hex_array[], lamp_sz len) {
  * @param char_array 输出：通用进制字符缓冲区，小端序（索引0=数字低位）
  * @param len 输入：缓冲区长度
  * @param base 输入：转换进制（2~36）
+ * @note 十进制按 10^8、10^4 拆分后查表，见 base_num2str
  */
 void ui_to_char_array_le(lamp_ui val, char char_array[], lamp_sz len, lamp_sz base) {
     assert(base >= 2 && base <= 36);
     assert(char_array != nullptr && len > 0 && len <= GET_BASE_LEN(base));
-    for (lamp_sz i = 0; i < len; ++i) {
-        lamp_ui tmp = val % base;  
-        char_array[i] = (tmp < 10) ? ('0' + char(tmp)) : ('a' + char(tmp - 10));
-        val /= base;
-    }
+    lammp::Arithmetic::Numeral::base_num2str(val, base, len, char_array, false);
 }
 
 void set_bin_str(lampz_t z, const char* str, lamp_sz str_len) {
@@ -244,6 +389,72 @@ void get_bin_str(const lampz_t z, char* str, lamp_sz str_len) {
     }
 }
 
+/*
+ * 2^bits 进制（4、8、32 进制）与二进制之间只是按位重新打包：每 8 个字符由 SWAR 合成 8 * bits 位，
+ * 依次拼接到输出字中（8 进制、32 进制的字符会跨越字的边界），线性时间，不经过 base2binary / binary2base
+ */
+template <int bits>
+void set_pow2_str(lampz_t z, const char* str, lamp_sz str_len) {
+    assert(__lampz_get_capacity(z) >= (str_len * bits + 63) / 64);
+    lamp_ptr out = z->begin;
+    lamp_ui acc = 0;
+    int acc_bits = 0;
+    // 追加 v 的低 w 位，写满一个字即输出
+    auto put = [&](lamp_ui v, int w) {
+        acc |= v << acc_bits;
+        acc_bits += w;
+        if (acc_bits >= 64) {
+            *out++ = acc;
+            acc_bits -= 64;
+            acc = v >> (w - acc_bits);
+        }
+    };
+    lamp_sz i = 0;
+    for (; i + 8 <= str_len; i += 8) {
+        lamp_ui v = 0;
+        if (!__lampz_parse8_pow2<bits, false>(str + i, v)) {
+            assert(false && "set_pow2_str: invalid character");
+            v = 0;
+        }
+        put(v, 8 * bits);
+    }
+    for (; i < str_len; i++) {
+        put(char_array_le_to_ui(str + i, 1, lamp_ui(1) << bits), bits);
+    }
+    if (acc_bits > 0) {
+        *out++ = acc;
+    }
+    const lamp_ui len = lammp::Arithmetic::rlz(z->begin, lamp_ui(out - z->begin));
+    z->len = len == 0 ? 1 : len;
+}
+
+// in 从第 pos 位起的 count 位（count < 64），超出 len 的部分为 0
+static inline lamp_ui __lampz_get_bits(const lamp_ui* in, lamp_sz len, lamp_sz pos, int count) {
+    const lamp_sz w = pos / 64;
+    const int s = int(pos % 64);
+    lamp_ui v = w < len ? in[w] >> s : 0;
+    if (s != 0 && w + 1 < len) {
+        v |= in[w + 1] << (64 - s);
+    }
+    return v & ((lamp_ui(1) << count) - 1);
+}
+
+template <int bits>
+void get_pow2_str(const lampz_t z, char* str, lamp_sz str_len) {
+    const lamp_sz len = lampz_get_len(z), digits = (len * 64 + bits - 1) / bits;
+    assert(digits <= str_len);
+    lamp_sz i = 0;
+    for (; i + 8 <= digits; i += 8) {
+        __lampz_format8_pow2<bits>(__lampz_get_bits(z->begin, len, i * bits, 8 * bits), str + i);
+    }
+    if (i < digits) {
+        char tail[8];
+        __lampz_format8_pow2<bits>(__lampz_get_bits(z->begin, len, i * bits, 8 * bits), tail);
+        std::copy(tail, tail + (digits - i), str + i);
+    }
+    std::fill(str + digits, str + str_len, '0');
+}
+
 void lampz_set_str(lampz_t z, const char* str, lamp_sz str_len, lamp_sz base) {
     assert(base >= 2 && base <= 36 && "set_str: only support base 2-36");
     
@@ -276,6 +487,15 @@ void lampz_set_str(lampz_t z, const char* str, lamp_sz str_len, lamp_sz base) {
     } else if (base == 16) {
         set_hex_str(z, str, str_len);
         return;
+    } else if (base == 4) {
+        set_pow2_str<2>(z, str, str_len);
+        return;
+    } else if (base == 8) {
+        set_pow2_str<3>(z, str, str_len);
+        return;
+    } else if (base == 32) {
+        set_pow2_str<5>(z, str, str_len);
+        return;
     } else {
         lamp_ui __z_len = str_len / GET_BASE_LEN(base) + 1;
         lampz_t __z;
@@ -307,22 +527,420 @@ lamp_sz lampz_to_str(char* str, const lamp_sz str_len, const lampz_t z, lamp_sz
         get_bin_str(z, str, str_len);
     } else if (base == 16) {
         get_hex_str(z, str, str_len);
+    } else if (base == 4) {
+        get_pow2_str<2>(z, str, str_len);
+    } else if (base == 8) {
+        get_pow2_str<3>(z, str, str_len);
+    } else if (base == 32) {
+        get_pow2_str<5>(z, str, str_len);
     } else {
-        lampz_t __z_copy;
-        __lampz_init(__z_copy);
-        lampz_copy(__z_copy, z);
-        lamp_sz __z_copy_len = lampz_get_len(__z_copy);
-        lamp_sz __out_len = lammp::Arithmetic::Numeral::get_buffer_size(__z_copy_len, GET_BASE_D(base));
+        // binary2base 不修改输入，直接在 z 上转换，只需分配 base_num 进制的结果
+        lamp_sz __z_len = lampz_get_len(z);
+        lamp_sz __out_len = lammp::Arithmetic::Numeral::get_buffer_size(__z_len, GET_BASE_D(base));
         lampz_t __out;
         __lampz_init(__out);
         __lampz_talloc(__out, __out_len);
-        __out->len = lammp::Arithmetic::Numeral::binary2base(__z_copy->begin, __z_copy_len, base, __out->begin);
+        __out->len = lammp::Arithmetic::Numeral::binary2base(z->begin, __z_len, base, __out->begin);
         get_base_str(__out, str, str_len, base);
-        lampz_free(__z_copy);  // 释放临时大整数
         lampz_free(__out);  // 释放临时大整数
     }
     lamp_sz __str_len = str_len;
     while (__str_len > 1 && str[__str_len - 1] == '0') __str_len--;  // 去除末尾0
     str[__str_len] = '\0';
     return __str_len;
+}
+
+// lampz_out_str_fd 的输出缓冲区大小（字节），写满后整块 write
+constexpr lamp_sz OUT_STR_BLOCK = lamp_sz(1) << 20;
+
+// 写入 [data, data + len)，处理部分写入与 EINTR，失败返回 false
+static bool __lampz_write_all(int fd, const char* data, lamp_sz len) {
+    while (len > 0) {
+        const auto n = __lampz_write(fd, data, (unsigned int)std::min<lamp_sz>(len, OUT_STR_BLOCK));
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            return false;
+        }
+        data += n;
+        len -= lamp_sz(n);
+    }
+    return true;
+}
+
+lamp_sz lampz_out_str_fd(int fd, const lampz_t z, lamp_sz base) {
+    if (base < 2 || base > 36 || lampz_is_nan(z)) {
+        return 0;
+    }
+    std::vector<char> block;
+    block.reserve(OUT_STR_BLOCK);
+    lamp_sz written = 0;
+    auto flush = [&]() {
+        if (!__lampz_write_all(fd, block.data(), block.size())) {
+            return false;
+        }
+        written += block.size();
+        block.clear();
+        return true;
+    };
+    if (lampz_get_sign(z) < 0 && lammp::Arithmetic::rlz(z->begin, lampz_get_len(z)) > 0) {
+        block.push_back('-');
+    }
+    const bool ok = lammp::Arithmetic::Numeral::binary2str(
+        z->begin, lampz_get_len(z), base, [&](const char* chars, lamp_ui len) {
+            if (block.size() + len > OUT_STR_BLOCK && !flush()) {
+                return false;
+            }
+            if (len >= OUT_STR_BLOCK) {
+                if (!__lampz_write_all(fd, chars, len)) {
+                    return false;
+                }
+                written += len;
+                return true;
+            }
+            block.insert(block.end(), chars, chars + len);
+            return true;
+        });
+    return ok && flush() ? written : 0;
+}
+
+// lampz_inp_str_fd 每次 read 的字节数
+constexpr lamp_sz INP_STR_BLOCK = lamp_sz(1) << 20;
+
+/*
+ * 高位在前的字符流逐块转换为二进制：每满 MIN_LEN 个 base_num 位即用 base2binary 转换为一个叶子压栈，
+ * 栈顶两块层数相同时合并为 hi * P_j + lo（P_j = base_num^(MIN_LEN * 2^j)，二进制计数器），
+ * 因此栈中至多 log 块，不需要保存整个字符串，也不需要 base_num 进制的完整副本。
+ * P_j 与 base2binary 共用进程级的幂次缓存（Numeral::get_base_power）。
+ * 输入结束后由低位到高位折叠剩余的块：acc = block * W + acc，W 为 acc 对应的基数幂
+ */
+class __lampz_str_reader {
+    // reader 持有的缓冲区的总字数及其峰值
+    struct _usage {
+        lamp_sz words = 0, peak = 0;
+        void add(lamp_si w) {
+            words += w;
+            peak = std::max(peak, words);
+        }
+    };
+
+    // 一块二进制数，缓冲区的字数在构造时计入 usage，析构时扣除
+    struct _block {
+        lammp::_internal_buffer<0> v;
+        lamp_ui cap, len = 0;
+        int level;
+        _usage* usage;
+
+        _block(_usage& u, lamp_ui capacity, int lv = 0) : v(capacity, 0), cap(capacity), level(lv), usage(&u) {
+            usage->add(lamp_si(cap));
+        }
+        _block(_block&& other) noexcept
+            : v(std::move(other.v)), cap(other.cap), len(other.len), level(other.level), usage(other.usage) {
+            other.usage = nullptr;
+        }
+        _block& operator=(_block&& other) noexcept {
+            if (this != &other) {
+                _release();
+                v = std::move(other.v);
+                cap = other.cap;
+                len = other.len;
+                level = other.level;
+                usage = other.usage;
+                other.usage = nullptr;
+            }
+            return *this;
+        }
+        ~_block() { _release(); }
+
+       private:
+        void _release() {
+            if (usage != nullptr) {
+                usage->add(-lamp_si(cap));
+                usage = nullptr;
+            }
+        }
+    };
+
+    lamp_ui base_, digits_;
+    _usage usage_;
+    lammp::_internal_buffer<0> leaf_;  // 当前叶子，高位在前
+    lamp_ui leaf_len_ = 0;
+    lamp_ui limb_ = 0, limb_digits_ = 0;  // 当前 base_num 位及其字符数
+    std::vector<_block> stack_;
+    std::vector<lammp::Arithmetic::Numeral::BasePower> pows_;  // 本次读取已取出的 P_j
+
+    // limbs 为 len 个 base_num 位（低位在前），转换为二进制
+    _block _convert(lamp_ptr limbs, lamp_ui len) {
+        _block b(usage_, lammp::Arithmetic::Numeral::get_buffer_size(len, 1.0 / GET_BASE_D(base_)) + 1);
+        b.len = len == 0 ? 0 : lammp::Arithmetic::Numeral::base2binary(limbs, len, base_, b.v.data());
+        return b;
+    }
+
+    // P_level，读取期间一直持有并按其长度计入 usage，缓存被清空或超出上限时也只计算一次
+    const lammp::Arithmetic::Numeral::BasePower& _pow(int level) {
+        while (int(pows_.size()) <= level) {
+            pows_.push_back(lammp::Arithmetic::Numeral::get_base_power(
+                base_, lammp::Arithmetic::Numeral::MIN_LEN << pows_.size()));
+            usage_.add(lamp_si(pows_.back().len));
+        }
+        return pows_[level];
+    }
+
+    // hi * w + lo，lo < w
+    _block _fold(const _block& hi, const lamp_ui* w, lamp_ui w_len, const _block& lo, int level) {
+        const lamp_ui cap = hi.len + w_len + 1;
+        _block out(usage_, cap, level);
+        if (hi.len > 0 && w_len > 0) {
+            lammp::Arithmetic::abs_mul64(const_cast<lamp_ptr>(hi.v.data()), hi.len, const_cast<lamp_ptr>(w), w_len,
+                                         out.v.data());
+        }
+        lammp::Arithmetic::abs_add_binary(out.v.data(), cap - 1, const_cast<lamp_ptr>(lo.v.data()), lo.len,
+                                          out.v.data());
+        out.len = lammp::Arithmetic::rlz(out.v.data(), cap);
+        return out;
+    }
+
+    // base_num^len * t，len < MIN_LEN
+    _block _tail_weight(lamp_ui len, const _block& t) {
+        _block one(usage_, len + 1);
+        one.v.data()[len] = 1;
+        return _fold(_convert(one.v.data(), len + 1), t.v.data(), t.len, _block(usage_, 1), 0);
+    }
+
+    void _push_leaf() {
+        std::reverse(leaf_.data(), leaf_.data() + leaf_len_);
+        stack_.push_back(_convert(leaf_.data(), leaf_len_));
+        leaf_len_ = 0;
+        while (stack_.size() >= 2 && stack_[stack_.size() - 2].level == stack_.back().level) {
+            const int level = stack_.back().level;
+            _block lo = std::move(stack_.back());
+            stack_.pop_back();
+            _block hi = std::move(stack_.back());
+            stack_.pop_back();
+            const auto& p = _pow(level);
+            stack_.push_back(_fold(hi, p.data, p.len, lo, level + 1));
+        }
+    }
+
+    void _push_limb() {
+        leaf_.data()[leaf_len_++] = limb_;
+        limb_ = 0;
+        limb_digits_ = 0;
+        if (leaf_len_ == lammp::Arithmetic::Numeral::MIN_LEN) {
+            _push_leaf();
+        }
+    }
+
+   public:
+    explicit __lampz_str_reader(lamp_ui base)
+        : base_(base),
+          digits_(GET_BASE_LEN(base)),
+          leaf_(lammp::Arithmetic::Numeral::MIN_LEN, 0) {
+        usage_.add(lamp_si(leaf_.capacity()));
+    }
+
+    // 逐字符累积到 base_num 位，非法字符返回 false
+    // 十进制在 base_num 位的边界上且剩余足够时，整个 base_num 位（19 个字符）由 SWAR 一次解析
+    bool feed(const char* p, lamp_sz n) {
+        for (lamp_sz i = 0; i < n; i++) {
+            lamp_ui hi;
+            if (base_ == 10 && limb_digits_ == 0 && i + 19 <= n && __lampz_parse16_dec<true>(p + i, hi)) {
+                const lamp_ui d0 = lamp_ui(p[i + 16] - '0'), d1 = lamp_ui(p[i + 17] - '0'), d2 = lamp_ui(p[i + 18] - '0');
+                if (d0 < 10 && d1 < 10 && d2 < 10) {
+                    limb_ = hi * 1000 + d0 * 100 + d1 * 10 + d2;
+                    limb_digits_ = digits_;
+                    _push_limb();
+                    i += 18;
+                    continue;
+                }
+            }
+            const char c = p[i];
+            lamp_ui val = base_;
+            if (c >= '0' && c <= '9') {
+                val = c - '0';
+            } else if (c >= 'a' && c <= 'z') {
+                val = 10 + (c - 'a');
+            } else if (c >= 'A' && c <= 'Z') {
+                val = 10 + (c - 'A');
+            }
+            if (val >= base_) {
+                return false;
+            }
+            limb_ = limb_ * base_ + val;
+            if (++limb_digits_ == digits_) {
+                _push_limb();
+            }
+        }
+        return true;
+    }
+
+    // 折叠剩余的块写入 z（绝对值）
+    void finish(lampz_t z, bool neg) {
+        // 末尾不足一个叶子的部分：acc = leaf * base^t + limb，W = base_num^leaf_len * base^t
+        lamp_ui base_t = 1;
+        for (lamp_ui i = 0; i < limb_digits_; i++) {
+            base_t *= base_;
+        }
+        _block small(usage_, 1), t(usage_, 1);
+        small.v.data()[0] = limb_;
+        small.len = limb_ != 0 ? 1 : 0;
+        t.v.data()[0] = base_t;
+        t.len = 1;
+        std::reverse(leaf_.data(), leaf_.data() + leaf_len_);
+        _block acc = _fold(_convert(leaf_.data(), leaf_len_), t.v.data(), t.len, small, 0);
+        _block w = _tail_weight(leaf_len_, t);
+        const _block zero(usage_, 1);
+        while (!stack_.empty()) {
+            _block top = std::move(stack_.back());
+            stack_.pop_back();
+            acc = _fold(top, w.v.data(), w.len, acc, 0);
+            if (!stack_.empty()) {
+                const auto& p = _pow(top.level);
+                w = _fold(w, p.data, p.len, zero, 0);
+            }
+        }
+        __lampz_store_abs(z, acc.v.data(), acc.len, neg);
+    }
+
+    // 读取期间 reader 同时持有的缓冲区（叶子、合并栈与折叠中的块、取出的 P_j）的最大字节数，
+    // 不含 base2binary 与乘法内部的临时缓冲
+    lamp_sz peak_block_bytes() const { return lamp_sz(usage_.peak) * sizeof(lamp_ui); }
+};
+
+static bool __lampz_is_space(char c) { return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' || c == '\f'; }
+
+/*
+ * 从 [p, p + n) 中解析一段：前导空白、可选的 '-'、数字、末尾空白，state 记录跨块的位置
+ * state：0 前导空白，1 已读符号或数字，2 末尾空白；返回 false 表示非法输入
+ */
+static bool __lampz_scan(__lampz_str_reader& reader, const char* p, lamp_sz n, int& state, bool& neg, lamp_sz& digits) {
+    lamp_sz i = 0;
+    if (state == 0) {
+        while (i < n && __lampz_is_space(p[i])) {
+            i++;
+        }
+        if (i == n) {
+            return true;
+        }
+        state = 1;
+        if (p[i] == '-') {
+            neg = true;
+            i++;
+        }
+    }
+    if (state == 1) {
+        lamp_sz end = i;
+        while (end < n && !__lampz_is_space(p[end])) {
+            end++;
+        }
+        if (!reader.feed(p + i, end - i)) {
+            return false;
+        }
+        digits += end - i;
+        i = end;
+        if (i < n) {
+            state = 2;
+        }
+    }
+    for (; i < n; i++) {
+        if (!__lampz_is_space(p[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+lamp_sz lampz_inp_str_fd(lampz_t z, int fd, lamp_sz base, lamp_sz* peak_block_bytes) {
+    if (base < 2 || base > 36) {
+        lampz_free(z);
+        return 0;
+    }
+    __lampz_str_reader reader(base);
+    std::vector<char> block(INP_STR_BLOCK);
+    lamp_sz total = 0, digits = 0;
+    int state = 0;
+    bool neg = false;
+    while (true) {
+        const auto n = __lampz_read(fd, block.data(), (unsigned int)block.size());
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n < 0 || !__lampz_scan(reader, block.data(), lamp_sz(n), state, neg, digits)) {
+            lampz_free(z);
+            return 0;
+        }
+        if (n == 0) {
+            break;
+        }
+        total += lamp_sz(n);
+    }
+    if (digits == 0) {
+        lampz_free(z);
+        return 0;
+    }
+    reader.finish(z, neg);
+    if (peak_block_bytes != nullptr) {
+        *peak_block_bytes = reader.peak_block_bytes() + block.size();
+    }
+    return lampz_is_nan(z) ? 0 : total;
+}
+
+lamp_sz lampz_set_str_mmap(lampz_t z, const char* path, lamp_sz base, lamp_sz* peak_block_bytes) {
+#if defined(_WIN32)
+    // Windows 下没有 mmap，按块读取
+    const int fd = _open(path, _O_RDONLY | _O_BINARY);
+    if (fd < 0) {
+        lampz_free(z);
+        return 0;
+    }
+    const lamp_sz total = lampz_inp_str_fd(z, fd, base, peak_block_bytes);
+    _close(fd);
+    return total;
+#else
+    const int fd = open(path, O_RDONLY);
+    struct stat st;
+    if (fd < 0 || fstat(fd, &st) != 0 || base < 2 || base > 36) {
+        if (fd >= 0) {
+            close(fd);
+        }
+        lampz_free(z);
+        return 0;
+    }
+    const lamp_sz size = lamp_sz(st.st_size);
+    if (size == 0) {
+        close(fd);
+        lampz_free(z);
+        return 0;
+    }
+    void* map = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        lampz_free(z);
+        return 0;
+    }
+    madvise(map, size, MADV_SEQUENTIAL);
+    __lampz_str_reader reader(base);
+    const char* p = static_cast<const char*>(map);
+    lamp_sz digits = 0;
+    int state = 0;
+    bool neg = false;
+    bool ok = true;
+    // 已解析的页面不再需要，逐块释放，常驻内存不随文件增长
+    for (lamp_sz i = 0; ok && i < size; i += INP_STR_BLOCK) {
+        const lamp_sz n = std::min(INP_STR_BLOCK, size - i);
+        ok = __lampz_scan(reader, p + i, n, state, neg, digits);
+        madvise(const_cast<char*>(p + i), n, MADV_DONTNEED);
+    }
+    munmap(map, size);
+    if (!ok || digits == 0) {
+        lampz_free(z);
+        return 0;
+    }
+    reader.finish(z, neg);
+    if (peak_block_bytes != nullptr) {
+        *peak_block_bytes = reader.peak_block_bytes();
+    }
+    return lampz_is_nan(z) ? 0 : size;
+#endif
 }
\ No newline at end of file
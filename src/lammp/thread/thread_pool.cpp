@@ -0,0 +1,113 @@
+/*
+ * Copyright (C) 2025 HJimmyK/LAMINA
+ *
+ * This file is part of LAMMP, which is licensed under the GNU LGPL v2.1.
+ * See the LICENSE file in the project root for full license details, or visit:
+ * <https://www.gnu.org/licenses/old-licenses/lgpl-2.1.html>
+ */
+
+#include "../../../include/lammp/thread_pool.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <memory>
+
+namespace lammp {
+
+ThreadPool::ThreadPool(size_t worker_count) : stop_(false) {
+    workers_.reserve(worker_count);
+    for (size_t i = 0; i < worker_count; i++) {
+        workers_.emplace_back([this] { workerLoop(); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    cv_.notify_all();
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+}
+
+ThreadPool& ThreadPool::global() {
+    static ThreadPool pool([] {
+        size_t total = std::thread::hardware_concurrency();
+        const char* env = std::getenv("LAMMP_NUM_THREADS");
+        if (env != nullptr && std::atoi(env) > 0) {
+            total = size_t(std::atoi(env));
+        }
+        return total > 1 ? total - 1 : 0;
+    }());
+    return pool;
+}
+
+void ThreadPool::workerLoop() {
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait(lock, [this] { return stop_ || !tasks_.empty(); });
+            if (stop_ && tasks_.empty()) {
+                return;
+            }
+            task = std::move(tasks_.front());
+            tasks_.pop();
+        }
+        task();
+    }
+}
+
+void ThreadPool::submit(std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        tasks_.push(std::move(task));
+    }
+    cv_.notify_one();
+}
+
+void ThreadPool::parallelFor(size_t count, const std::function<void(size_t)>& func) {
+    if (count == 0) {
+        return;
+    }
+    if (count == 1 || workers_.empty()) {
+        for (size_t i = 0; i < count; i++) {
+            func(i);
+        }
+        return;
+    }
+    // 任务下标由所有参与者共同领取；迟到的辅助任务只会发现下标已领完，
+    // 共享状态由 shared_ptr 保证在其退出前有效
+    struct State {
+        std::atomic<size_t> next{0};
+        std::atomic<size_t> done{0};
+        size_t count = 0;
+        const std::function<void(size_t)>* func = nullptr;
+        std::mutex mutex;
+        std::condition_variable cv;
+    };
+    auto state = std::make_shared<State>();
+    state->count = count;
+    state->func = &func;
+    auto run = [](State& s) {
+        size_t i;
+        while ((i = s.next.fetch_add(1)) < s.count) {
+            (*s.func)(i);
+            if (s.done.fetch_add(1) + 1 == s.count) {
+                std::lock_guard<std::mutex> lock(s.mutex);
+                s.cv.notify_all();
+            }
+        }
+    };
+    const size_t helpers = std::min(workers_.size(), count - 1);
+    for (size_t h = 0; h < helpers; h++) {
+        submit([state, run] { run(*state); });
+    }
+    run(*state);
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->cv.wait(lock, [&] { return state->done.load() == count; });
+}
+
+};  // namespace lammp
@@ -7,5 +7,25 @@ void test_shift_in_word();
 void test_shift_bits();
 void test_abs_mul64();
 void test_abs_mul64_base();
+void test_abs_mul64_classic();
+void test_abs_div64();
+void test_abs_mul64_unbalanced();
+void test_pow_mod();
+void test_pow_mod_batch();
+void test_gcd();
+void test_div_recursive();
+void test_sqrt();
+void test_root();
+void test_prime();
+void test_factorial();
+void test_fib();
+void test_pow();
+void test_mod_multi();
+void test_crt();
+void test_binsplit();
+void test_mat22();
+void test_sqr_mod();
+void test_numeral();
+void test_str();
 
 }; // namespace test_short
@@ -4,5 +4,25 @@
 
 int main() {
     test_short::test_abs_mul64_base();
+    test_short::test_abs_mul64_classic();
+    test_short::test_abs_div64();
+    test_short::test_abs_mul64_unbalanced();
+    test_short::test_pow_mod();
+    test_short::test_pow_mod_batch();
+    test_short::test_gcd();
+    test_short::test_div_recursive();
+    test_short::test_sqrt();
+    test_short::test_root();
+    test_short::test_prime();
+    test_short::test_factorial();
+    test_short::test_fib();
+    test_short::test_pow();
+    test_short::test_mod_multi();
+    test_short::test_crt();
+    test_short::test_binsplit();
+    test_short::test_mat22();
+    test_short::test_sqr_mod();
+    test_short::test_numeral();
+    test_short::test_str();
     return 0;
 }
\ No newline at end of file
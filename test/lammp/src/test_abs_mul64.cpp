@@ -1,3 +1,4 @@
+#include <random>
 #include <vector>
 
 #include "../include/test_short.hpp"
@@ -25,4 +26,122 @@ void test_abs_mul64_base() {
 
 }
 
+// 一个乘数规格化后只剩一个字时走 abs_mul_add_num64，结果高于 len1 + 1 的字也必须清零
+void test_abs_mul64_classic() {
+    using namespace lammp;
+    using namespace lammp::Arithmetic;
+    std::mt19937_64 rng(2024);
+    for (size_t len1 : {1, 2, 7, 30}) {
+        std::vector<uint64_t> in1(len1), in2 = {rng(), 0, 0, 0};
+        for (auto& w : in1) w = rng();
+        // 输出缓冲区先填满非零的垃圾
+        std::vector<uint64_t> out(len1 + in2.size(), ~uint64_t(0)), ref(len1 + in2.size(), 0);
+        abs_mul64_classic(in1.data(), len1, in2.data(), in2.size(), out.data(), nullptr, nullptr);
+        uint64_t carry = 0;
+        for (size_t i = 0; i < len1; i++) {
+            uint64_t lo, hi;
+            mul64x64to128(in1[i], in2[0], lo, hi);
+            lo += carry;
+            ref[i] = lo;
+            carry = hi + (lo < carry);
+        }
+        ref[len1] = carry;
+        if (out != ref) {
+            std::cout << "error in abs_mul64_classic, one-word multiplier, len1 = " << len1 << std::endl;
+            return;
+        }
+    }
+    std::cout << "test abs_mul64_classic passed" << std::endl;
+}
+
+// q * d + r == u 且 r < d
+static bool check_div(const std::vector<uint64_t>& u,
+                      std::vector<uint64_t> d,
+                      std::vector<uint64_t> q,
+                      std::vector<uint64_t> r) {
+    using namespace lammp::Arithmetic;
+    const size_t d_len = rlz(d.data(), d.size()), q_len = rlz(q.data(), q.size()), r_len = rlz(r.data(), r.size());
+    if (abs_compare(r.data(), r_len, d.data(), d_len) >= 0) {
+        return false;
+    }
+    std::vector<uint64_t> qd(q_len + d_len + 1, 0);
+    if (q_len > 0) {
+        abs_mul64(q.data(), q_len, d.data(), d_len, qd.data());
+    }
+    abs_add_binary(qd.data(), qd.size() - 1, r.data(), r_len, qd.data());
+    const size_t qd_len = rlz(qd.data(), qd.size());
+    return abs_compare(qd.data(), qd_len, const_cast<uint64_t*>(u.data()), rlz(const_cast<uint64_t*>(u.data()), u.size())) == 0;
+}
+
+void test_abs_div64() {
+    using namespace lammp;
+    using namespace lammp::Arithmetic;
+    // 规格化的除数，第二位商的估计需要用除数次高字修正一次，乘减后仍然借位，需要加回；
+    // 旧的循环在这里得到的商为 {2^64 - 2, 1}，正确值为 {2^64 - 3, 1}
+    {
+        const std::vector<uint64_t> u = {2, 2, 2, 0, 1}, d = {~0ull, (1ull << 63) + 1, 1ull << 63};
+        std::vector<uint64_t> in = u, q(u.size() - d.size() + 1, 0), r(d.size(), 0);
+        abs_div_knuth(in.data(), in.size(), const_cast<uint64_t*>(d.data()), d.size(), q.data(), r.data());
+        if (q[0] != ~0ull - 2 || q[1] != 1 || !check_div(u, d, q, r)) {
+            std::cout << "error in abs_div_knuth, add-back case" << std::endl;
+            return;
+        }
+    }
+    // 由接近 2^63、2^64 的字拼成的操作数，更容易触发商的修正与加回
+    std::mt19937_64 rng(2028);
+    const uint64_t pool[] = {0, 1, 2, ~0ull, ~0ull - 1, 1ull << 63, (1ull << 63) - 1, (1ull << 63) + 1};
+    for (int iter = 0; iter < 20000; iter++) {
+        const size_t n = 2 + rng() % 4, m = 1 + rng() % 4;
+        std::vector<uint64_t> u(n + m), d(n);
+        for (auto& w : u) w = pool[rng() % 8];
+        for (auto& w : d) w = pool[rng() % 8];
+        d[n - 1] |= 1ull << 63;
+        u[n + m - 1] |= 1;
+        std::vector<uint64_t> in = u, q(m + 1, 0), r(n, 0);
+        abs_div_knuth(in.data(), in.size(), d.data(), n, q.data(), r.data());
+        if (!check_div(u, d, q, r)) {
+            std::cout << "error in abs_div_knuth, n = " << n << ", m = " << m << std::endl;
+            return;
+        }
+    }
+    // 未规格化的除数：abs_div64 把 len2 个字左移后写入 len2 + 1 个字
+    for (size_t len2 : {2, 3, 17}) {
+        std::vector<uint64_t> u(len2 * 3), d(len2);
+        for (auto& w : u) w = rng();
+        for (auto& w : d) w = rng();
+        d[len2 - 1] = 1;
+        std::vector<uint64_t> q(u.size() - len2 + 2, 0), r(len2, 0);
+        abs_div64(u.data(), u.size(), d.data(), len2, q.data());
+        abs_mod64(u.data(), u.size(), d.data(), len2, r.data());
+        if (!check_div(u, d, q, r)) {
+            std::cout << "error in abs_div64, unnormalized divisor, len2 = " << len2 << std::endl;
+            return;
+        }
+    }
+    std::cout << "test abs_div64 passed" << std::endl;
+}
+
+void test_abs_mul64_unbalanced() {
+    using namespace lammp;
+    using namespace lammp::Arithmetic;
+    std::mt19937_64 rng(2032);
+    // len2 + max(len2, M) 恰为或接近 2 的幂，结果与 abs_mul64_classic 比较
+    const lamp_ui cases[][3] = {{16384, 2048, 0}, {8192, 2047, 0}, {8192, 2049, 0},
+                                {40000, 2048, 4}, {100000, 1024, 9}, {30000, 2048, 6144}};
+    for (auto& c : cases) {
+        const lamp_ui len1 = c[0], len2 = c[1], M = c[2];
+        std::vector<uint64_t> in1(len1), in2(len2), out(len1 + len2, 0), ref(len1 + len2, 0);
+        for (auto& w : in1) w = rng();
+        for (auto& w : in2) w = rng();
+        abs_mul64_ntt_unbalanced(in1.data(), len1, in2.data(), len2, M, out.data());
+        abs_mul64_classic(in1.data(), len1, in2.data(), len2, ref.data(), nullptr, nullptr);
+        if (out != ref) {
+            std::cout << "error in abs_mul64_ntt_unbalanced, len1 = " << len1 << ", len2 = " << len2 << ", M = " << M
+                      << std::endl;
+            return;
+        }
+    }
+    std::cout << "test abs_mul64_ntt_unbalanced passed" << std::endl;
+}
+
 };  // namespace test_short
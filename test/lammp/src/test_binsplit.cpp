@@ -0,0 +1,166 @@
+#include "../include/test_short.hpp"
+#include "../../../include/lammp/binsplit.hpp"
+#include <vector>
+
+namespace test_short {
+
+namespace {
+
+struct _signed {
+    std::vector<lamp_ui> v;  // 不含前导零
+    bool neg = false;
+};
+
+_signed _signed_mul(const _signed& x, const _signed& y) {
+    _signed out;
+    if (x.v.empty() || y.v.empty()) {
+        return out;
+    }
+    out.v.resize(x.v.size() + y.v.size());
+    lammp::Arithmetic::abs_mul64(lamp_ptr(x.v.data()), x.v.size(), lamp_ptr(y.v.data()), y.v.size(), out.v.data());
+    out.v.resize(lammp::Arithmetic::rlz(out.v.data(), out.v.size()));
+    out.neg = x.neg != y.neg;
+    return out;
+}
+
+_signed _signed_add(const _signed& x, const _signed& y) {
+    if (x.v.empty() || y.v.empty()) {
+        return x.v.empty() ? y : x;
+    }
+    _signed out;
+    out.v.resize(std::max(x.v.size(), y.v.size()) + 1, 0);
+    if (x.neg == y.neg) {
+        lammp::Arithmetic::abs_add_binary(lamp_ptr(x.v.data()), x.v.size(), lamp_ptr(y.v.data()), y.v.size(),
+                                          out.v.data());
+        out.neg = x.neg;
+    } else {
+        const auto sign = lammp::Arithmetic::abs_difference_binary(lamp_ptr(x.v.data()), x.v.size(),
+                                                                   lamp_ptr(y.v.data()), y.v.size(), out.v.data());
+        out.neg = sign > 0 ? x.neg : y.neg;
+    }
+    out.v.resize(lammp::Arithmetic::rlz(out.v.data(), out.v.size()));
+    out.neg = out.neg && !out.v.empty();
+    return out;
+}
+
+bool _signed_equal(const _signed& x, const lammp::Arithmetic::BinSplitNum& y) {
+    return x.v.size() == y.len && x.neg == y.neg && std::equal(x.v.begin(), x.v.end(), y.buf.data());
+}
+
+// 由 k 确定的伪随机系数，1 ~ 2 个字，可带符号
+lamp_ui _coef(lamp_ui seed, lamp_ui k, lamp_ptr out, bool& neg, bool allow_neg) {
+    lamp_ui h = (k + 1) * 0x9E3779B97F4A7C15ull ^ seed;
+    auto next = [&h]() {
+        h ^= h >> 29;
+        h *= 0xBF58476D1CE4E5B9ull;
+        h ^= h >> 32;
+        return h;
+    };
+    const lamp_ui len = 1 + next() % 2;
+    for (lamp_ui i = 0; i < len; i++) {
+        out[i] = next();
+    }
+    out[0] |= 1;
+    neg = allow_neg && (next() & 1) != 0;
+    return len;
+}
+
+};  // namespace
+
+void test_binsplit() {
+    using namespace lammp;
+    using namespace lammp::Arithmetic;
+
+    // 与逐项从左到右合并的结果比较，系数为多字且带符号，规模足以走到并行分支
+    BinSplitSeries series;
+    series.p = [](lamp_ui k, lamp_ptr out, bool& neg) { return _coef(1, k, out, neg, true); };
+    series.q = [](lamp_ui k, lamp_ptr out, bool& neg) { return _coef(2, k, out, neg, false); };
+    series.a = [](lamp_ui k, lamp_ptr out, bool& neg) { return _coef(3, k, out, neg, true); };
+    for (bool has_b : {false, true}) {
+        series.b = nullptr;
+        if (has_b) {
+            series.b = [](lamp_ui k, lamp_ptr out, bool& neg) { return _coef(4, k, out, neg, true); };
+        }
+        for (lamp_ui n : {1ull, 2ull, 7ull, 300ull, 2000ull}) {
+            _signed P, Q, B, BP, T;
+            P.v = Q.v = B.v = BP.v = {1};
+            for (lamp_ui k = 0; k < n; k++) {
+                _signed p, q, a, b;
+                lamp_ui buf[BINSPLIT_TERM_LEN];
+                p.v.assign(buf, buf + series.p(k, buf, p.neg));
+                q.v.assign(buf, buf + series.q(k, buf, q.neg));
+                a.v.assign(buf, buf + series.a(k, buf, a.neg));
+                b.v = {1};
+                if (has_b) {
+                    b.v.assign(buf, buf + series.b(k, buf, b.neg));
+                }
+                // T = b q T + B P a p
+                T = _signed_add(_signed_mul(_signed_mul(b, q), T), _signed_mul(BP, _signed_mul(a, p)));
+                BP = _signed_mul(BP, _signed_mul(b, p));
+                P = _signed_mul(P, p);
+                Q = _signed_mul(Q, q);
+                B = _signed_mul(B, b);
+            }
+            BinSplitNum rp, rq, rb, rt, rq2, rt2;
+            binary_split(series, n, &rp, rq, &rb, rt);
+            binary_split(series, n, nullptr, rq2, nullptr, rt2);
+            if (!_signed_equal(P, rp) || !_signed_equal(Q, rq) || !_signed_equal(B, rb) || !_signed_equal(T, rt) ||
+                !_signed_equal(Q, rq2) || !_signed_equal(T, rt2)) {
+                std::cout << "error in binary_split, has_b = " << has_b << ", n = " << n << std::endl;
+                return;
+            }
+        }
+    }
+
+    // 商远短于 B * Q 时只用高位相除再修正，与多算若干位后右移的结果比较
+    for (lamp_ui frac_bits : {0ull, 64ull, 1000ull}) {
+        const lamp_ui extra = 200000;
+        BinSplitNum lo, hi;
+        binary_split_fixed(series, 300, frac_bits, lo);
+        binary_split_fixed(series, 300, frac_bits + extra, hi);
+        std::vector<lamp_ui> ref(hi.len, 0);
+        rshift_bits(hi.buf.data(), hi.len, ref.data(), extra);
+        const lamp_ui ref_len = rlz(ref.data(), hi.len);
+        if (lo.len != ref_len || (lo.len > 0 && lo.neg != hi.neg) ||
+            !std::equal(ref.data(), ref.data() + ref_len, lo.buf.data())) {
+            std::cout << "error in binary_split_fixed, frac_bits = " << frac_bits << std::endl;
+            return;
+        }
+    }
+
+    // 等比级数 sum_{k<n} 2^-k = 2 - 2^(1 - n)，定点结果精确
+    BinSplitSeries geo;
+    geo.p = [](lamp_ui, lamp_ptr out, bool&) -> lamp_ui {
+        out[0] = 1;
+        return 1;
+    };
+    geo.q = [](lamp_ui k, lamp_ptr out, bool&) -> lamp_ui {
+        out[0] = k == 0 ? 1 : 2;
+        return 1;
+    };
+    geo.a = geo.p;
+    for (lamp_ui n : {1ull, 5ull, 200ull, 5000ull}) {
+        const lamp_ui frac_bits = n + 77;
+        BinSplitNum out;
+        binary_split_fixed(geo, n, frac_bits, out);
+        // 2^(frac_bits + 1) - 2^(frac_bits + 1 - n)
+        std::vector<lamp_ui> ref((frac_bits + 1) / 64 + 1, 0);
+        for (lamp_ui bit = frac_bits + 1 - n; bit <= frac_bits; bit++) {
+            ref[bit / 64] |= 1ull << (bit % 64);
+        }
+        const lamp_ui ref_len = rlz(ref.data(), ref.size());
+        if (out.neg || out.len != ref_len || !std::equal(ref.data(), ref.data() + ref_len, out.buf.data())) {
+            std::cout << "error in binary_split_fixed, n = " << n << std::endl;
+            return;
+        }
+    }
+    BinSplitNum zero;
+    binary_split_fixed(geo, 0, 64, zero);
+    if (zero.len != 0) {
+        std::cout << "error in binary_split_fixed, n = 0" << std::endl;
+        return;
+    }
+    std::cout << "test binary_split passed" << std::endl;
+}
+
+};  // namespace test_short
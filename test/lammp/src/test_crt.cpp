@@ -0,0 +1,75 @@
+#include "../include/test_short.hpp"
+#include "../../../include/lammp/prod_tree.hpp"
+#include <random>
+#include <vector>
+
+namespace test_short {
+
+void test_crt() {
+    using namespace lammp;
+    using namespace lammp::Arithmetic;
+
+    // 随机取 x < M，用余数树求 x mod m_i，再重建回 x；模数为单字素数或混有多字素数
+    std::mt19937_64 rng(36);
+    for (lamp_ui max_len : {1ull, 3ull}) {
+        for (lamp_ui k : {1ull, 2ull, 5ull, 64ull, 500ull}) {
+            std::vector<std::vector<lamp_ui>> mods(k);
+            std::vector<lamp_ptr> mod_ptrs(k);
+            std::vector<lamp_ui> mod_lens(k);
+            lamp_ui total = 0;
+            for (lamp_ui i = 0; i < k; i++) {
+                const lamp_ui len = 1 + rng() % max_len;
+                mods[i].resize(len);
+                do {
+                    for (auto& w : mods[i]) {
+                        w = rng();
+                    }
+                    mods[i][0] |= 1;
+                    mods[i][len - 1] |= 1ull << 62;
+                } while (!abs_is_prime64(mods[i].data(), len));
+                mod_ptrs[i] = mods[i].data();
+                mod_lens[i] = len;
+                total += len;
+            }
+            CrtPlan plan(mod_ptrs.data(), mod_lens.data(), k);
+            if (!plan.valid()) {
+                std::cout << "error in CrtPlan, k = " << k << std::endl;
+                return;
+            }
+            // 每个模数不小于 2^62，取 62 * total 位的 x 保证 x < M
+            std::vector<lamp_ui> x(total, 0);
+            const lamp_ui x_bits = 62 * total;
+            for (lamp_ui i = 0; i < x_bits / 64; i++) {
+                x[i] = rng();
+            }
+            x[x_bits / 64] = rng() & ((1ull << (x_bits % 64)) - 1);
+            std::vector<std::vector<lamp_ui>> res(k);
+            std::vector<lamp_ptr> res_ptrs(k);
+            std::vector<lamp_ui> res_lens(k);
+            for (lamp_ui i = 0; i < k; i++) {
+                res[i].resize(mod_lens[i]);
+                res_ptrs[i] = res[i].data();
+            }
+            abs_mod_multi64(x.data(), total, mod_ptrs.data(), mod_lens.data(), k, res_ptrs.data(), res_lens.data());
+            std::vector<lamp_ui> out(plan.size());
+            const lamp_ui out_len = plan.reconstruct(res_ptrs.data(), res_lens.data(), out.data());
+            const lamp_ui x_len = rlz(x.data(), total);
+            if (out_len != x_len || !std::equal(x.data(), x.data() + x_len, out.data())) {
+                std::cout << "error in CrtPlan::reconstruct, max_len = " << max_len << ", k = " << k << std::endl;
+                return;
+            }
+        }
+    }
+
+    // 模数不互素
+    lamp_ui a = 6, b = 35, c = 9;
+    lamp_ptr bad[] = {&a, &b, &c};
+    lamp_ui bad_lens[] = {1, 1, 1};
+    if (CrtPlan(bad, bad_lens, 3).valid()) {
+        std::cout << "error in CrtPlan, gcd(6, 9) != 1" << std::endl;
+        return;
+    }
+    std::cout << "test CrtPlan passed" << std::endl;
+}
+
+};  // namespace test_short
@@ -0,0 +1,44 @@
+#include "../include/test_short.hpp"
+#include <vector>
+
+namespace test_short {
+
+void test_factorial() {
+    using namespace lammp;
+    using namespace lammp::Arithmetic;
+
+    // 与逐个乘单字的结果比较
+    std::vector<lamp_ui> ref(get_factorial_len(3000), 0);
+    ref[0] = 1;
+    lamp_ui ref_len = 1;
+    for (lamp_ui n = 0; n <= 3000; n++) {
+        if (n > 1) {
+            abs_mul_add_num64(ref.data(), ref_len, ref.data(), 0, n);
+            ref_len = rlz(ref.data(), ref_len + 1);
+        }
+        if (n > 400 && n != 3000) {
+            continue;
+        }
+        std::vector<lamp_ui> out(get_factorial_len(n));
+        const lamp_ui len = abs_factorial64(n, out.data());
+        if (len != ref_len || !std::equal(ref.data(), ref.data() + len, out.data())) {
+            std::cout << "error in abs_factorial64, n = " << n << std::endl;
+            return;
+        }
+    }
+
+    // 2^17! = 2^17 * (2^17 - 1)!，规模足以走到 NTT 乘法与并行分支
+    const lamp_ui n = 1 << 17;
+    std::vector<lamp_ui> a(get_factorial_len(n)), b(get_factorial_len(n) + 1, 0);
+    const lamp_ui a_len = abs_factorial64(n, a.data());
+    lamp_ui b_len = abs_factorial64(n - 1, b.data());
+    abs_mul_add_num64(b.data(), b_len, b.data(), 0, n);
+    b_len = rlz(b.data(), b_len + 1);
+    if (a_len != b_len || !std::equal(a.data(), a.data() + a_len, b.data())) {
+        std::cout << "error in abs_factorial64, n = " << n << std::endl;
+        return;
+    }
+    std::cout << "test abs_factorial64 passed" << std::endl;
+}
+
+};  // namespace test_short
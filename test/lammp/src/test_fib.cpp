@@ -0,0 +1,61 @@
+#include "../include/test_short.hpp"
+#include <vector>
+
+namespace test_short {
+
+void test_fib() {
+    using namespace lammp;
+    using namespace lammp::Arithmetic;
+
+    // 与逐项相加的结果比较，同时检查 F(n - 1) 与 L(n) = F(n) + 2F(n - 1)
+    const lamp_ui max_n = 2000;
+    const lamp_ui cap = get_fib_len(max_n) + 1;
+    std::vector<lamp_ui> cur(cap, 0), prev(cap, 0), next(cap, 0);
+    prev[0] = 1;  // F(-1) = 1
+    lamp_ui cur_len = 0, prev_len = 1;
+    for (lamp_ui n = 0; n <= max_n; n++) {
+        if (n > 0) {
+            abs_add_binary(cur.data(), cur_len, prev.data(), prev_len, next.data());
+            const lamp_ui next_len = rlz(next.data(), std::max(cur_len, prev_len) + 1);
+            std::swap(prev, cur);
+            std::swap(cur, next);
+            prev_len = cur_len;
+            cur_len = next_len;
+        }
+        std::vector<lamp_ui> f(get_fib_len(n)), g(get_fib_len(n)), l(get_fib_len(n) + 1);
+        lamp_ui g_len = 0;
+        const lamp_ui f_len = abs_fib64(n, f.data(), g.data(), &g_len);
+        if (f_len != cur_len || !std::equal(cur.data(), cur.data() + f_len, f.data()) || g_len != prev_len ||
+            !std::equal(prev.data(), prev.data() + g_len, g.data())) {
+            std::cout << "error in abs_fib64, n = " << n << std::endl;
+            return;
+        }
+        std::vector<lamp_ui> ref(cap + 1, 0);
+        lshift_in_word(prev.data(), prev_len, ref.data(), 1);
+        const lamp_ui twice_len = rlz(ref.data(), prev_len + 1);
+        abs_add_binary(cur.data(), cur_len, ref.data(), twice_len, ref.data());
+        const lamp_ui ref_len = rlz(ref.data(), std::max(cur_len, twice_len) + 1);
+        const lamp_ui l_len = abs_lucnum64(n, l.data());
+        if (l_len != ref_len || !std::equal(ref.data(), ref.data() + l_len, l.data())) {
+            std::cout << "error in abs_lucnum64, n = " << n << std::endl;
+            return;
+        }
+    }
+
+    // F(2n) = F(n) * L(n)，规模足以走到 NTT 平方与并行分支
+    const lamp_ui n = 3000001;
+    std::vector<lamp_ui> fn(get_fib_len(n)), ln(get_fib_len(n) + 1), f2n(get_fib_len(2 * n));
+    const lamp_ui fn_len = abs_fib64(n, fn.data());
+    const lamp_ui ln_len = abs_lucnum64(n, ln.data());
+    const lamp_ui f2n_len = abs_fib64(2 * n, f2n.data());
+    std::vector<lamp_ui> prod(fn_len + ln_len);
+    abs_mul64(fn.data(), fn_len, ln.data(), ln_len, prod.data());
+    const lamp_ui prod_len = rlz(prod.data(), fn_len + ln_len);
+    if (prod_len != f2n_len || !std::equal(prod.data(), prod.data() + prod_len, f2n.data())) {
+        std::cout << "error in abs_fib64, n = " << 2 * n << std::endl;
+        return;
+    }
+    std::cout << "test abs_fib64 passed" << std::endl;
+}
+
+};  // namespace test_short
@@ -0,0 +1,92 @@
+#include "../include/test_short.hpp"
+#include <random>
+#include <vector>
+
+namespace test_short {
+
+// 朴素欧几里得算法，每一步做一次长除法取模，作为 abs_gcd64 的参照
+static std::vector<uint64_t> naive_gcd(std::vector<uint64_t> a, std::vector<uint64_t> b) {
+    using namespace lammp::Arithmetic;
+    lamp_ui a_len = rlz(a.data(), a.size()), b_len = rlz(b.data(), b.size());
+    while (b_len > 0) {
+        std::vector<lamp_ui> r(b_len, 0);
+        const lamp_ui r_len = abs_mod64(a.data(), a_len, b.data(), b_len, r.data());
+        a.swap(b);
+        a_len = b_len;
+        b.swap(r);
+        b_len = r_len;
+    }
+    a.resize(a_len);
+    return a;
+}
+
+static std::vector<uint64_t> random_words(std::mt19937_64& rng, size_t len) {
+    std::vector<uint64_t> w(len);
+    for (auto& x : w) x = rng();
+    w[len - 1] |= 1;
+    return w;
+}
+
+void test_gcd() {
+    using namespace lammp;
+    using namespace lammp::Arithmetic;
+
+    std::mt19937_64 rng(2027);
+    // 覆盖单字、Lehmer 双字步以及半 GCD（不小于 HGCD_THRESHOLD 个字）
+    const lamp_ui lens[] = {1, 2, 7, 60, HGCD_THRESHOLD - 1, HGCD_THRESHOLD + 5, 2 * HGCD_THRESHOLD + 37};
+    for (lamp_ui len : lens) {
+        // 构造公因子，使 gcd 不为 1
+        std::vector<lamp_ui> g0 = random_words(rng, len / 3 + 1);
+        std::vector<lamp_ui> x = random_words(rng, len), y = random_words(rng, len - len / 7);
+        std::vector<lamp_ui> a(x.size() + g0.size()), b(y.size() + g0.size());
+        abs_mul64(x.data(), x.size(), g0.data(), g0.size(), a.data());
+        abs_mul64(y.data(), y.size(), g0.data(), g0.size(), b.data());
+
+        std::vector<lamp_ui> g(a.size()), s(b.size());
+        const lamp_ui g_len = abs_gcd64(a.data(), a.size(), b.data(), b.size(), g.data());
+        g.resize(g_len);
+        if (g != naive_gcd(a, b)) {
+            std::cout << "error in abs_gcd64, len = " << len << std::endl;
+            return;
+        }
+
+        // s * a ≡ g (mod b)
+        lamp_ui s_len;
+        bool s_neg;
+        std::vector<lamp_ui> g2(a.size());
+        const lamp_ui g2_len = abs_gcdext64(a.data(), a.size(), b.data(), b.size(), g2.data(), s.data(), s_len, s_neg);
+        g2.resize(g2_len);
+        std::vector<lamp_ui> sa(s_len + a.size(), 0), lhs(b.size(), 0), rhs(b.size(), 0);
+        abs_mul64(s.data(), s_len, a.data(), a.size(), sa.data());
+        abs_mod64(sa.data(), sa.size(), b.data(), b.size(), lhs.data());
+        abs_mod64(g2.data(), g2_len, b.data(), b.size(), rhs.data());
+        if (s_neg && rlz(lhs.data(), lhs.size()) > 0) {
+            abs_sub_binary(b.data(), b.size(), lhs.data(), lhs.size(), lhs.data());
+        }
+        if (g2 != g || lhs != rhs || s_len > b.size()) {
+            std::cout << "error in abs_gcdext64, len = " << len << std::endl;
+            return;
+        }
+
+        // 与 b 互素的 x 的逆元
+        std::vector<lamp_ui> inv(b.size(), 0), prod(x.size() + b.size(), 0), one(b.size(), 0);
+        lamp_ui inv_len;
+        const bool ok = abs_inv_mod64(x.data(), x.size(), y.data(), y.size(), inv.data(), inv_len);
+        std::vector<lamp_ui> xy_gcd = naive_gcd(x, y);
+        if (ok != (xy_gcd.size() == 1 && xy_gcd[0] == 1)) {
+            std::cout << "error in abs_inv_mod64, len = " << len << std::endl;
+            return;
+        }
+        if (ok) {
+            abs_mul64(inv.data(), y.size(), x.data(), x.size(), prod.data());
+            abs_mod64(prod.data(), prod.size(), y.data(), y.size(), one.data());
+            if (rlz(one.data(), one.size()) != 1 || one[0] != 1) {
+                std::cout << "error in abs_inv_mod64, len = " << len << std::endl;
+                return;
+            }
+        }
+    }
+    std::cout << "test abs_gcd64 passed" << std::endl;
+}
+
+};  // namespace test_short
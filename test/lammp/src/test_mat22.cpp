@@ -0,0 +1,164 @@
+#include "../include/test_short.hpp"
+#include "../../../include/lammp/mat22.hpp"
+#include <random>
+#include <vector>
+
+namespace test_short {
+
+namespace {
+
+struct _entry {
+    std::vector<lamp_ui> v;  // 不含前导零
+    bool neg = false;
+};
+
+using _mat = std::vector<_entry>;
+
+_entry _entry_mul(const _entry& x, const _entry& y) {
+    _entry out;
+    if (x.v.empty() || y.v.empty()) {
+        return out;
+    }
+    out.v.resize(x.v.size() + y.v.size());
+    lammp::Arithmetic::abs_mul64(lamp_ptr(x.v.data()), x.v.size(), lamp_ptr(y.v.data()), y.v.size(), out.v.data());
+    out.v.resize(lammp::Arithmetic::rlz(out.v.data(), out.v.size()));
+    out.neg = x.neg != y.neg;
+    return out;
+}
+
+_entry _entry_add(const _entry& x, const _entry& y) {
+    if (x.v.empty() || y.v.empty()) {
+        return x.v.empty() ? y : x;
+    }
+    _entry out;
+    out.v.resize(std::max(x.v.size(), y.v.size()) + 1, 0);
+    if (x.neg == y.neg) {
+        lammp::Arithmetic::abs_add_binary(lamp_ptr(x.v.data()), x.v.size(), lamp_ptr(y.v.data()), y.v.size(),
+                                          out.v.data());
+        out.neg = x.neg;
+    } else {
+        const auto sign = lammp::Arithmetic::abs_difference_binary(lamp_ptr(x.v.data()), x.v.size(),
+                                                                   lamp_ptr(y.v.data()), y.v.size(), out.v.data());
+        out.neg = sign > 0 ? x.neg : y.neg;
+    }
+    out.v.resize(lammp::Arithmetic::rlz(out.v.data(), out.v.size()));
+    out.neg = out.neg && !out.v.empty();
+    return out;
+}
+
+// 逐项相乘的参考结果
+_mat _mat_mul(const _mat& a, const _mat& b) {
+    _mat c(4);
+    for (int r = 0; r < 2; r++) {
+        for (int k = 0; k < 2; k++) {
+            c[r * 2 + k] = _entry_add(_entry_mul(a[r * 2], b[k]), _entry_mul(a[r * 2 + 1], b[k + 2]));
+        }
+    }
+    return c;
+}
+
+lammp::Arithmetic::Mat22 _view(_mat& m) {
+    lammp::Arithmetic::Mat22 v;
+    for (int i = 0; i < 4; i++) {
+        v.ptr[i] = m[i].v.data();
+        v.len[i] = m[i].v.size();
+        v.neg[i] = m[i].neg;
+    }
+    return v;
+}
+
+bool _mat_equal(const _mat& x, const lammp::Arithmetic::Mat22& y) {
+    for (int i = 0; i < 4; i++) {
+        if (x[i].v.size() != y.len[i] || x[i].neg != y.neg[i] || !std::equal(x[i].v.begin(), x[i].v.end(), y.ptr[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+_mat _random_mat(std::mt19937_64& rng, lamp_ui len, bool allow_neg) {
+    _mat m(4);
+    for (auto& e : m) {
+        // 长度在 [len / 2, len] 之间，偶尔为零
+        const lamp_ui l = rng() % 8 == 0 ? 0 : len / 2 + rng() % (len / 2 + 1);
+        e.v.resize(l);
+        for (auto& w : e.v) {
+            w = rng();
+        }
+        if (l > 0) {
+            e.v[l - 1] |= 1;
+        }
+        e.neg = allow_neg && l > 0 && (rng() & 1) != 0;
+    }
+    return m;
+}
+
+};  // namespace
+
+void test_mat22() {
+    using namespace lammp;
+    using namespace lammp::Arithmetic;
+
+    // 与逐项相乘比较，元素带符号，长度覆盖逐项、Winograd、变换域三条路径，也包含平方
+    std::mt19937_64 rng(39);
+    for (lamp_ui len : {1ull, 3ull, 40ull, 300ull, 2000ull}) {
+        for (bool allow_neg : {false, true}) {
+            _mat a = _random_mat(rng, len, allow_neg), b = _random_mat(rng, len, allow_neg);
+            Mat22 va = _view(a), vb = _view(b);
+            for (bool sqr : {false, true}) {
+                const Mat22& rhs = sqr ? va : vb;
+                const lamp_ui cap = get_mat22_mul_len(va, rhs);
+                std::vector<lamp_ui> buf(cap * 4);
+                Mat22 c;
+                for (int i = 0; i < 4; i++) {
+                    c.ptr[i] = buf.data() + cap * i;
+                }
+                mat22_mul(va, rhs, c);
+                if (!_mat_equal(_mat_mul(a, sqr ? a : b), c)) {
+                    std::cout << "error in mat22_mul, len = " << len << ", allow_neg = " << allow_neg
+                              << ", sqr = " << sqr << std::endl;
+                    return;
+                }
+            }
+        }
+    }
+
+    // 与逐次相乘比较
+    _mat a = _random_mat(rng, 2, true), ref(4);
+    ref[0].v = ref[3].v = {1};
+    Mat22 va = _view(a);
+    for (lamp_ui exp = 0; exp <= 40; exp++) {
+        _internal_buffer<0> buf;
+        Mat22 c;
+        mat22_pow(va, exp, buf, c);
+        if (!_mat_equal(ref, c)) {
+            std::cout << "error in mat22_pow, exp = " << exp << std::endl;
+            return;
+        }
+        ref = _mat_mul(ref, a);
+    }
+
+    // [1 1; 1 0]^n = [F(n + 1) F(n); F(n) F(n - 1)]，规模足以走到变换域平方
+    lamp_ui one = 1;
+    Mat22 fib = {{&one, &one, &one, nullptr}, {1, 1, 1, 0}, {false, false, false, false}};
+    for (lamp_ui n : {1ull, 2ull, 93ull, 1000000ull}) {
+        _internal_buffer<0> buf;
+        Mat22 c;
+        mat22_pow(fib, n, buf, c);
+        std::vector<lamp_ui> f1(get_fib_len(n + 1)), f0(get_fib_len(n + 1));
+        lamp_ui f0_len = 0;
+        const lamp_ui f1_len = abs_fib64(n + 1, f1.data(), f0.data(), &f0_len);
+        std::vector<lamp_ui> fm(get_fib_len(n));
+        const lamp_ui fm_len = abs_fib64(n - 1, fm.data());
+        if (c.len[0] != f1_len || !std::equal(f1.data(), f1.data() + f1_len, c.ptr[0]) || c.len[1] != f0_len ||
+            !std::equal(f0.data(), f0.data() + f0_len, c.ptr[1]) || c.len[2] != f0_len ||
+            !std::equal(f0.data(), f0.data() + f0_len, c.ptr[2]) || c.len[3] != fm_len ||
+            !std::equal(fm.data(), fm.data() + fm_len, c.ptr[3])) {
+            std::cout << "error in mat22_pow, F(" << n << ")" << std::endl;
+            return;
+        }
+    }
+    std::cout << "test mat22 passed" << std::endl;
+}
+
+};  // namespace test_short
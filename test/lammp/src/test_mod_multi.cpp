@@ -0,0 +1,51 @@
+#include "../include/test_short.hpp"
+#include <random>
+#include <vector>
+
+namespace test_short {
+
+void test_mod_multi() {
+    using namespace lammp;
+    using namespace lammp::Arithmetic;
+
+    // 与逐个 abs_mod64 比较：模数长度混杂，x 比乘积树短或长，包括只有一个模数与 x 为零的情况
+    std::mt19937_64 rng(35);
+    for (lamp_ui x_len : {0ull, 1ull, 5ull, 300ull, 20000ull}) {
+        for (lamp_ui count : {1ull, 2ull, 7ull, 100ull, 1000ull}) {
+            std::vector<lamp_ui> x(x_len + 1);
+            for (lamp_ui i = 0; i < x_len; i++) {
+                x[i] = rng();
+            }
+            std::vector<std::vector<lamp_ui>> mods(count), outs(count);
+            std::vector<lamp_ptr> mod_ptrs(count), out_ptrs(count);
+            std::vector<lamp_ui> mod_lens(count), out_lens(count);
+            for (lamp_ui i = 0; i < count; i++) {
+                const lamp_ui len = rng() % 4 == 0 ? 1 + rng() % 200 : 1 + rng() % 3;
+                mods[i].resize(len);
+                for (auto& w : mods[i]) {
+                    w = rng();
+                }
+                mods[i][len - 1] |= 1;
+                outs[i].resize(len);
+                mod_ptrs[i] = mods[i].data();
+                out_ptrs[i] = outs[i].data();
+                mod_lens[i] = len;
+            }
+            abs_mod_multi64(x.data(), x_len, mod_ptrs.data(), mod_lens.data(), count, out_ptrs.data(),
+                            out_lens.data());
+            for (lamp_ui i = 0; i < count; i++) {
+                std::vector<lamp_ui> ref(mod_lens[i] + 1, 0);
+                const lamp_ui ref_len =
+                    x_len == 0 ? 0 : abs_mod64(x.data(), x_len, mod_ptrs[i], mod_lens[i], ref.data());
+                if (out_lens[i] != ref_len || !std::equal(ref.data(), ref.data() + ref_len, outs[i].data())) {
+                    std::cout << "error in abs_mod_multi64, x_len = " << x_len << ", count = " << count
+                              << ", i = " << i << std::endl;
+                    return;
+                }
+            }
+        }
+    }
+    std::cout << "test abs_mod_multi64 passed" << std::endl;
+}
+
+};  // namespace test_short
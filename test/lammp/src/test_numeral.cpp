@@ -0,0 +1,261 @@
+#include "../include/test_short.hpp"
+#include "../../../include/lammp/numeral_table.h"
+#include "../../../include/lammp/thread_pool.hpp"
+#include <random>
+#include <string>
+#include <vector>
+
+namespace test_short {
+
+// 逐字除以 base_num 的朴素转换，作为 binary2base 的参照
+static std::vector<uint64_t> naive_to_base(std::vector<uint64_t> x, uint64_t base_num) {
+    using namespace lammp::Arithmetic;
+    std::vector<uint64_t> out;
+    lamp_ui len = rlz(x.data(), x.size());
+    while (len > 0) {
+        out.push_back(abs_div_rem_num64(x.data(), len, x.data(), base_num));
+        len = rlz(x.data(), len);
+    }
+    return out;
+}
+
+// binary2base 与 base2binary 往返，并与朴素转换比较（仅较短时），失败时返回 false
+static bool round_trip(const std::vector<uint64_t>& x, uint64_t base, bool check_naive) {
+    using namespace lammp::Arithmetic;
+    using namespace lammp::Arithmetic::Numeral;
+    std::vector<uint64_t> in = x, digits(get_buffer_size(x.size(), GET_BASE_D(base)), 0);
+    digits.resize(binary2base(in.data(), in.size(), base, digits.data()));
+    if (in != x) {
+        return false;
+    }
+    for (auto d : digits) {
+        if (d >= GET_BASE_NUM(base)) {
+            return false;
+        }
+    }
+    if (check_naive && digits != naive_to_base(x, GET_BASE_NUM(base))) {
+        return false;
+    }
+    std::vector<uint64_t> back(get_buffer_size(digits.size(), 1.0 / GET_BASE_D(base)), 0);
+    const std::vector<uint64_t> digits_in = digits;
+    back.resize(base2binary(digits.data(), digits.size(), base, back.data()));
+    return digits == digits_in && back.size() == rlz(lamp_ptr(x.data()), x.size()) &&
+           std::equal(back.begin(), back.end(), x.begin());
+}
+
+// binary2base 的结果按高位在前写成字符串，作为 binary2str 的参照
+static std::string base_chars(std::vector<uint64_t> x, uint64_t base) {
+    using namespace lammp::Arithmetic;
+    using namespace lammp::Arithmetic::Numeral;
+    std::vector<uint64_t> digits(get_buffer_size(x.size() + 1, GET_BASE_D(base)), 0);
+    const lamp_ui len = rlz(x.data(), x.size());
+    digits.resize(len == 0 ? 0 : binary2base(x.data(), len, base, digits.data()));
+    std::string out;
+    for (auto it = digits.rbegin(); it != digits.rend(); ++it) {
+        std::string limb(GET_BASE_LEN(base), '0');
+        for (auto c = limb.rbegin(); c != limb.rend(); ++c, *it /= base) {
+            *c = "0123456789abcdefghijklmnopqrstuvwxyz"[*it % base];
+        }
+        out += limb;
+    }
+    out.erase(0, std::min(out.find_first_not_of('0'), out.size()));
+    return out.empty() ? "0" : out;
+}
+
+static bool check_str(const std::vector<uint64_t>& x, uint64_t base) {
+    std::vector<uint64_t> in = x;
+    std::string out;
+    const bool ok = lammp::Arithmetic::Numeral::binary2str(in.data(), in.size(), base, [&](const char* p, uint64_t n) {
+        out.append(p, n);
+        return true;
+    });
+    return ok && in == x && out == base_chars(x, base);
+}
+
+void test_numeral() {
+    using namespace lammp;
+    using namespace lammp::Arithmetic;
+
+    // 长度覆盖经典算法、递归与尾部不足 MIN_LEN 的情况，进制取 10、7、36
+    std::mt19937_64 rng(41);
+    for (lamp_ui base : {10ull, 7ull, 36ull}) {
+        for (lamp_ui len : {1ull, 130ull, 1000ull, 4097ull, 30000ull}) {
+            std::vector<uint64_t> x(len);
+            for (auto& w : x) {
+                w = rng();
+            }
+            if (!round_trip(x, base, len <= 4097)) {
+                std::cout << "error in binary2base/base2binary, base = " << base << ", len = " << len << std::endl;
+                return;
+            }
+        }
+    }
+
+    // 常用进制由编译期常量的经典算法处理，2 的幂进制只做移位
+    for (lamp_ui base : {2ull, 4ull, 8ull, 16ull, 32ull}) {
+        for (lamp_ui len : {1ull, 2ull, 63ull, 130ull, 1000ull}) {
+            std::vector<uint64_t> x(len);
+            for (auto& w : x) {
+                w = rng();
+            }
+            x.back() |= 1ull << 63;
+            if (!round_trip(x, base, true)) {
+                std::cout << "error in binary2base/base2binary, base = " << base << ", len = " << len << std::endl;
+                return;
+            }
+        }
+    }
+
+    // 经典算法的叶子最高字为零：2^(64 * 200) + 1 的低位叶子只有最低字非零
+    std::vector<uint64_t> sparse(201, 0);
+    sparse[0] = 1;
+    sparse[200] = 1;
+    if (!round_trip(sparse, 10, true)) {
+        std::cout << "error in binary2base with a zero-topped leaf" << std::endl;
+        return;
+    }
+
+    // 高半部分全为零：129 个字分为 128 + 1，128 个字的高 64 个字为零，递归时跳过与基数幂的乘法
+    std::vector<uint64_t> hole(129, 0);
+    for (size_t i = 0; i < 64; i++) {
+        hole[i] = rng() | (1ull << 63);
+    }
+    hole[128] = 1;
+    if (!round_trip(hole, 10, true)) {
+        std::cout << "error in binary2base with a zero high half" << std::endl;
+        return;
+    }
+
+    // 缩放余数树的截断：base_num^k、base_num^k - 1（尾部全为零或全为 base_num - 1）与 2^(64 * len) - 1
+    for (lamp_ui base : {10ull, 7ull}) {
+        for (lamp_ui k : {130ull, 1000ull, 2048ull}) {
+            std::vector<uint64_t> one(k + 1, 0), x(k + 2, 0);
+            one[k] = 1;
+            x.resize(Numeral::base2binary(one.data(), one.size(), base, x.data()));
+            std::vector<uint64_t> ones(k, ~uint64_t(0));
+            if (!round_trip(x, base, true) || !round_trip(ones, base, true)) {
+                std::cout << "error in binary2base, base = " << base << ", base_num^" << k << std::endl;
+                return;
+            }
+            abs_sub_binary_num(x.data(), x.size(), 1, x.data());
+            x.resize(rlz(x.data(), x.size()));
+            if (!round_trip(x, base, true)) {
+                std::cout << "error in binary2base, base = " << base << ", base_num^" << k << " - 1" << std::endl;
+                return;
+            }
+        }
+    }
+
+    // 缓存上限很小时只为本次转换临时计算；清空缓存后多个线程同时转换，共享同一份幂次表
+    std::vector<std::vector<uint64_t>> xs(8);
+    for (size_t i = 0; i < xs.size(); i++) {
+        xs[i].resize(2000 + 997 * i);
+        for (auto& w : xs[i]) {
+            w = rng();
+        }
+    }
+    Numeral::set_pow_cache_limit(1000);
+    if (!round_trip(xs.back(), 10, false)) {
+        std::cout << "error in binary2base with a small cache limit" << std::endl;
+        return;
+    }
+    Numeral::set_pow_cache_limit(Numeral::POW_CACHE_DEFAULT_WORDS);
+    Numeral::clear_pow_cache();
+    std::vector<int> ok(xs.size(), 0);
+    ThreadPool::global().parallelFor(xs.size(), [&](size_t i) { ok[i] = round_trip(xs[i], 10, false); });
+    for (size_t i = 0; i < xs.size(); i++) {
+        if (!ok[i] || !round_trip(xs[i], 10, false)) {
+            std::cout << "error in concurrent binary2base, len = " << xs[i].size() << std::endl;
+            return;
+        }
+    }
+
+    // binary2base_srt 的倒数与幂次一起计入缓存上限：上限只够放下各层幂次时，倒数只为本次转换计算
+    {
+        auto to_base = [&](const std::vector<uint64_t>& x) {
+            std::vector<uint64_t> in = x, digits(Numeral::get_buffer_size(x.size(), GET_BASE_D(10)), 0);
+            digits.resize(Numeral::binary2base(in.data(), in.size(), 10, digits.data()));
+            return digits;
+        };
+        Numeral::clear_pow_cache();
+        const auto expect = to_base(xs.back());
+        const lamp_ui with_inv = Numeral::pow_cache_words();
+        Numeral::clear_pow_cache();
+        Numeral::set_pow_cache_limit(with_inv - 1);
+        const bool same = to_base(xs.back()) == expect;
+        const lamp_ui used = Numeral::pow_cache_words();
+        Numeral::set_pow_cache_limit(Numeral::POW_CACHE_DEFAULT_WORDS);
+        Numeral::clear_pow_cache();
+        if (!same || with_inv == 0 || used == 0 || used >= with_inv) {
+            std::cout << "error in binary2base_srt, cache words = " << used << ", limit = " << with_inv - 1 << std::endl;
+            return;
+        }
+    }
+
+    // 高位在前的流式输出：随机数、零，以及 base_num^(MIN_LEN * 2^k) 附近的分段边界
+    for (lamp_ui base : {10ull, 7ull, 36ull, 2ull, 16ull}) {
+        for (lamp_ui len : {0ull, 1ull, 130ull, 4097ull, 30000ull}) {
+            if (len == 30000 && base != 10) {
+                continue;
+            }
+            std::vector<uint64_t> x(len);
+            for (auto& w : x) {
+                w = rng();
+            }
+            if (!check_str(x, base)) {
+                std::cout << "error in binary2str, base = " << base << ", len = " << len << std::endl;
+                return;
+            }
+        }
+        for (lamp_ui limbs : {Numeral::MIN_LEN, Numeral::MIN_LEN * 4}) {
+            std::vector<uint64_t> one(limbs + 1, 0), x(limbs * 2, 0);
+            one[limbs] = 1;
+            x.resize(Numeral::base2binary(one.data(), one.size(), base, x.data()));
+            for (int delta = 0; delta < 2; delta++) {
+                if (!check_str(x, base)) {
+                    std::cout << "error in binary2str, base = " << base << ", base_num^" << limbs << " - " << delta
+                              << std::endl;
+                    return;
+                }
+                abs_sub_binary_num(x.data(), x.size(), 1, x.data());
+            }
+        }
+    }
+
+    // 中止后不再调用 sink
+    std::vector<uint64_t> big(5000, ~uint64_t(0));
+    int calls = 0;
+    if (Numeral::binary2str(big.data(), big.size(), 10, [&](const char*, uint64_t) { return ++calls < 3; }) ||
+        calls != 3) {
+        std::cout << "error in binary2str, abort" << std::endl;
+        return;
+    }
+
+    // base_num2str：与逐位取余比较，十进制覆盖 10^k 附近、2^64 - 1（20 位）以及截断到 len 位
+    std::vector<uint64_t> vals = {0, 1, 9, 10, 99999999, 100000000, 9999999999999999ull, 10000000000000000ull,
+                                  9999999999999999999ull, ~uint64_t(0)};
+    for (int i = 0; i < 2000; i++) {
+        vals.push_back(rng() >> (rng() % 64));
+    }
+    for (uint64_t base : {10ull, 2ull, 7ull, 16ull, 36ull}) {
+        for (uint64_t len : {uint64_t(GET_BASE_LEN(base)), uint64_t(1), uint64_t(8), uint64_t(17), uint64_t(20)}) {
+            for (uint64_t v : vals) {
+                std::string expect(len, '0'), msb(len, '?'), lsb(len, '?');
+                uint64_t t = v;
+                for (auto c = expect.rbegin(); c != expect.rend(); ++c, t /= base) {
+                    *c = "0123456789abcdefghijklmnopqrstuvwxyz"[t % base];
+                }
+                Numeral::base_num2str(v, base, len, &msb[0], true);
+                Numeral::base_num2str(v, base, len, &lsb[0], false);
+                if (msb != expect || std::string(lsb.rbegin(), lsb.rend()) != expect) {
+                    std::cout << "error in base_num2str, base = " << base << ", len = " << len << ", v = " << v
+                              << std::endl;
+                    return;
+                }
+            }
+        }
+    }
+    std::cout << "test numeral passed" << std::endl;
+}
+
+};  // namespace test_short
@@ -0,0 +1,60 @@
+#include "../include/test_short.hpp"
+#include <random>
+#include <vector>
+
+namespace test_short {
+
+void test_pow() {
+    using namespace lammp;
+    using namespace lammp::Arithmetic;
+
+    // 单字奇数、单字偶数、2 的幂、多字奇数、多字偶数底数，与逐次相乘的结果比较
+    std::mt19937_64 rng(34);
+    std::vector<std::vector<lamp_ui>> bases = {{3}, {10}, {1ull << 20}, {0, 1}, {rng(), rng() | 1, rng()},
+                                               {0, rng() << 1, rng(), rng()}};
+    for (int i = 0; i < 4; i++) {
+        bases.push_back({rng() >> (i * 16)});
+    }
+    const lamp_ui max_e = 150;
+    for (auto& base : bases) {
+        const lamp_ui base_len = base.size();
+        std::vector<lamp_ui> ref(base_len * max_e + 1, 0), tmp(base_len * max_e + 1, 0);
+        ref[0] = 1;
+        lamp_ui ref_len = 1;
+        for (lamp_ui e = 0; e <= max_e; e++) {
+            if (e > 0) {
+                abs_mul64(ref.data(), ref_len, base.data(), base_len, tmp.data());
+                ref_len = rlz(tmp.data(), ref_len + base_len);
+                std::swap(ref, tmp);
+            }
+            std::vector<lamp_ui> out(get_pow_len(base.data(), base_len, e));
+            const lamp_ui len = abs_pow64(base.data(), base_len, e, out.data());
+            if (len != ref_len || !std::equal(ref.data(), ref.data() + len, out.data())) {
+                std::cout << "error in abs_pow64, base[0] = " << base[0] << ", e = " << e << std::endl;
+                return;
+            }
+        }
+    }
+
+    // b^(2e + 1) = (b^e)^2 * b，规模足以走到 NTT 平方
+    for (auto& base : bases) {
+        const lamp_ui base_len = base.size();
+        const lamp_ui e = 200000 / base_len;
+        std::vector<lamp_ui> half(get_pow_len(base.data(), base_len, e));
+        std::vector<lamp_ui> full(get_pow_len(base.data(), base_len, 2 * e + 1));
+        const lamp_ui half_len = abs_pow64(base.data(), base_len, e, half.data());
+        const lamp_ui full_len = abs_pow64(base.data(), base_len, 2 * e + 1, full.data());
+        std::vector<lamp_ui> sq(2 * half_len), ref(2 * half_len + base_len);
+        abs_sqr64(half.data(), half_len, sq.data());
+        const lamp_ui sq_len = rlz(sq.data(), 2 * half_len);
+        abs_mul64(sq.data(), sq_len, base.data(), base_len, ref.data());
+        const lamp_ui ref_len = rlz(ref.data(), sq_len + base_len);
+        if (full_len != ref_len || !std::equal(ref.data(), ref.data() + ref_len, full.data())) {
+            std::cout << "error in abs_pow64, base[0] = " << base[0] << ", e = " << 2 * e + 1 << std::endl;
+            return;
+        }
+    }
+    std::cout << "test abs_pow64 passed" << std::endl;
+}
+
+};  // namespace test_short
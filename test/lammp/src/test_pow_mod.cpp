@@ -0,0 +1,176 @@
+#include "../include/test_short.hpp"
+#include "../../../include/lammp/lampz.h"
+#include <random>
+#include <vector>
+
+namespace test_short {
+
+// 朴素的二进制幂，每一步乘法后做一次长除法取模，作为 abs_pow_mod64 的参照
+static std::vector<uint64_t> naive_pow_mod(const std::vector<uint64_t>& base,
+                                           const std::vector<uint64_t>& exp,
+                                           std::vector<uint64_t> mod) {
+    using namespace lammp::Arithmetic;
+    const lamp_ui n = mod.size();
+    std::vector<lamp_ui> res(n, 0), b(n, 0), prod(2 * n, 0);
+    std::vector<lamp_ui> base_copy = base;
+    abs_mod64(base_copy.data(), base_copy.size(), mod.data(), n, b.data());
+    res[0] = 1;
+    if (n == 1 && mod[0] == 1) {
+        res[0] = 0;
+    }
+    for (lamp_ui i = exp.size() * 64; i > 0; i--) {
+        abs_mul64(res.data(), n, res.data(), n, prod.data());
+        std::fill(res.begin(), res.end(), 0);
+        abs_mod64(prod.data(), 2 * n, mod.data(), n, res.data());
+        if ((exp[(i - 1) / 64] >> ((i - 1) % 64)) & 1) {
+            abs_mul64(res.data(), n, b.data(), n, prod.data());
+            std::fill(res.begin(), res.end(), 0);
+            abs_mod64(prod.data(), 2 * n, mod.data(), n, res.data());
+        }
+    }
+    return res;
+}
+
+void test_pow_mod() {
+    using namespace lammp;
+    using namespace lammp::Arithmetic;
+
+    std::mt19937_64 rng(2025);
+    // 覆盖逐字 REDC、乘法 REDC 以及偶数模数
+    const lamp_ui mod_lens[] = {1, 2, 5, 17, 32, 33, 48};
+    for (lamp_ui mod_len : mod_lens) {
+        for (int even = 0; even < 2; even++) {
+            std::vector<lamp_ui> mod(mod_len), base(mod_len + 3), exp(2);
+            for (auto& w : mod) w = rng();
+            for (auto& w : base) w = rng();
+            for (auto& w : exp) w = rng();
+            mod[mod_len - 1] |= 1ull << 63;
+            if (even) {
+                mod[0] &= ~lamp_ui(0) << 13;
+            } else {
+                mod[0] |= 1;
+            }
+            std::vector<lamp_ui> res(mod_len, 0);
+            abs_pow_mod64(base.data(), base.size(), exp.data(), exp.size(), mod.data(), mod_len, res.data());
+            std::vector<lamp_ui> ref = naive_pow_mod(base, exp, mod);
+            if (res != ref) {
+                std::cout << "error in abs_pow_mod64, mod_len = " << mod_len << (even ? " (even)" : " (odd)")
+                          << std::endl;
+                return;
+            }
+        }
+    }
+    // 模数超过 KARATSUBA_MAX_THRESHOLD 个字时 REDC 中的乘法走 NTT，朴素参照太慢，
+    // 改为检查 base^(e1 + e2) = base^e1 * base^e2 (mod mod)；每步三次 NTT 乘法，指数取 16 位以控制耗时
+    const lamp_ui ntt_mod_lens[] = {2000, 3000};
+    for (lamp_ui mod_len : ntt_mod_lens) {
+        for (int even = 0; even < 2; even++) {
+            std::vector<lamp_ui> mod(mod_len), base(mod_len + 3);
+            for (auto& w : mod) w = rng();
+            for (auto& w : base) w = rng();
+            mod[mod_len - 1] |= 1ull << 63;
+            if (even) {
+                mod[0] &= ~lamp_ui(0) << 13;
+            } else {
+                mod[0] |= 1;
+            }
+            lamp_ui e1 = rng() >> 48, e2 = rng() >> 48, e12 = e1 + e2;
+            std::vector<lamp_ui> r1(mod_len, 0), r2(mod_len, 0), r12(mod_len, 0), ref(mod_len, 0), prod(2 * mod_len, 0);
+            abs_pow_mod64(base.data(), base.size(), &e1, 1, mod.data(), mod_len, r1.data());
+            abs_pow_mod64(base.data(), base.size(), &e2, 1, mod.data(), mod_len, r2.data());
+            abs_pow_mod64(base.data(), base.size(), &e12, 1, mod.data(), mod_len, r12.data());
+            abs_mul64(r1.data(), mod_len, r2.data(), mod_len, prod.data());
+            abs_mod64(prod.data(), 2 * mod_len, mod.data(), mod_len, ref.data());
+            if (r12 != ref) {
+                std::cout << "error in abs_pow_mod64, mod_len = " << mod_len << (even ? " (even)" : " (odd)")
+                          << std::endl;
+                return;
+            }
+        }
+    }
+    std::cout << "test abs_pow_mod64 passed" << std::endl;
+}
+
+void test_pow_mod_batch() {
+    using namespace lammp;
+    using namespace lammp::Arithmetic;
+
+    std::mt19937_64 rng(2026);
+    const lamp_ui count = 37;
+    // 单字奇数（多路交织）、多字奇数、偶数模数
+    const lamp_ui mod_lens[] = {1, 3, 40};
+    for (lamp_ui mod_len : mod_lens) {
+        for (int shared = 0; shared < 2; shared++) {
+            std::vector<lamp_ui> mod(mod_len);
+            for (auto& w : mod) w = rng();
+            mod[mod_len - 1] |= 1ull << 63;
+            mod[0] = mod_len == 40 ? mod[0] & ~lamp_ui(0xff) : mod[0] | 1;
+            std::vector<std::vector<lamp_ui>> bases(count), exps(shared ? 1 : count);
+            std::vector<lamp_ptr> base_ptrs, exp_ptrs, out_ptrs;
+            std::vector<lamp_ui> base_lens, exp_lens;
+            std::vector<lamp_ui> outs(count * mod_len);
+            for (lamp_ui i = 0; i < count; i++) {
+                bases[i].resize(1 + rng() % 3);
+                for (auto& w : bases[i]) w = rng();
+                base_ptrs.push_back(bases[i].data());
+                base_lens.push_back(bases[i].size());
+                out_ptrs.push_back(outs.data() + i * mod_len);
+            }
+            for (auto& e : exps) {
+                e.resize(2);
+                for (auto& w : e) w = rng();
+                exp_ptrs.push_back(e.data());
+                exp_lens.push_back(e.size());
+            }
+            abs_pow_mod64_batch(base_ptrs.data(), base_lens.data(), count, exp_ptrs.data(), exp_lens.data(),
+                                exps.size(), mod.data(), mod_len, out_ptrs.data());
+            std::vector<lamp_ui> ref(mod_len);
+            for (lamp_ui i = 0; i < count; i++) {
+                const lamp_ui k = shared ? 0 : i;
+                abs_pow_mod64(base_ptrs[i], base_lens[i], exp_ptrs[k], exp_lens[k], mod.data(), mod_len, ref.data());
+                if (!std::equal(ref.begin(), ref.end(), out_ptrs[i])) {
+                    std::cout << "error in abs_pow_mod64_batch, mod_len = " << mod_len << std::endl;
+                    return;
+                }
+            }
+        }
+    }
+
+    // lampz_pow_mod_batch 就地计算：z 即底数数组，模数是 z[0]（其结果 0 最先写入），负底数需要用模数修正符号
+    const lamp_sz n = 9;
+    lampz_t z[n], ref[n], e, m;
+    __lampz_init(e);
+    __lampz_init(m);
+    lampz_set_ui(e, 65537);
+    for (lamp_sz i = 0; i < n; i++) {
+        __lampz_init(z[i]);
+        __lampz_init(ref[i]);
+        const lamp_ui len = i == 0 ? 5 : 1 + rng() % 7;
+        __lampz_talloc(z[i], len);
+        for (lamp_ui j = 0; j < len; j++) {
+            z[i]->begin[j] = rng();
+        }
+        z[i]->begin[len - 1] |= 1;
+        z[i]->len = (i % 2 == 1) ? -lamp_si(len) : lamp_si(len);
+    }
+    lampz_copy(m, z[0]);
+    for (lamp_sz i = 0; i < n; i++) {
+        lampz_pow_mod(ref[i], z[i], e, m);
+    }
+    lampz_pow_mod_batch(z, z, n, &e, 1, z[0]);
+    for (lamp_sz i = 0; i < n; i++) {
+        const lamp_sz len = lampz_get_len(ref[i]);
+        if (lampz_get_len(z[i]) != len || lampz_get_sign(z[i]) != lampz_get_sign(ref[i]) ||
+            !std::equal(ref[i]->begin, ref[i]->begin + len, z[i]->begin)) {
+            std::cout << "error in lampz_pow_mod_batch, aliased z[" << i << "]" << std::endl;
+            return;
+        }
+        lampz_free(z[i]);
+        lampz_free(ref[i]);
+    }
+    lampz_free(e);
+    lampz_free(m);
+    std::cout << "test abs_pow_mod64_batch passed" << std::endl;
+}
+
+};  // namespace test_short
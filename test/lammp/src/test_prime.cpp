@@ -0,0 +1,73 @@
+#include "../include/test_short.hpp"
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace test_short {
+
+void test_prime() {
+    using namespace lammp;
+    using namespace lammp::Arithmetic;
+
+    // 小数与试除结果比较
+    for (lamp_ui x = 0; x < 5000; x++) {
+        bool expect = x >= 2;
+        for (lamp_ui p = 2; p * p <= x; p++) {
+            if (x % p == 0) {
+                expect = false;
+                break;
+            }
+        }
+        if (abs_is_prime64(&x, 1) != expect) {
+            std::cout << "error in abs_is_prime64, x = " << x << std::endl;
+            return;
+        }
+    }
+
+    // 以 2 为底的强伪素数与 Carmichael 数，以及 Mersenne 数 2^p - 1
+    lamp_ui composites[] = {2047, 3215031751ull, 3825123056546413051ull, 1093ull * 1093, 3511ull * 3511, 41041, 825265};
+    for (lamp_ui x : composites) {
+        if (abs_is_prime64(&x, 1)) {
+            std::cout << "error in abs_is_prime64, x = " << x << std::endl;
+            return;
+        }
+    }
+    const std::pair<lamp_ui, bool> mersenne[] = {{61, true}, {67, false}, {127, true}, {521, true}, {523, false},
+                                                 {607, true}, {1279, true}, {1283, false}};
+    for (auto& m : mersenne) {
+        const lamp_ui len = (m.first + 63) / 64;
+        std::vector<lamp_ui> x(len, ~lamp_ui(0));
+        if (m.first % 64 != 0) {
+            x[len - 1] = (lamp_ui(1) << (m.first % 64)) - 1;
+        }
+        if (abs_is_prime64(x.data(), len) != m.second) {
+            std::cout << "error in abs_is_prime64, x = 2^" << m.first << " - 1" << std::endl;
+            return;
+        }
+    }
+
+    // 批量结果与逐个测试一致
+    std::mt19937_64 rng(2031);
+    const lamp_ui count = 300;
+    std::vector<std::vector<lamp_ui>> nums(count);
+    std::vector<lamp_ptr> ptrs(count);
+    std::vector<lamp_ui> lens(count);
+    for (lamp_ui i = 0; i < count; i++) {
+        lens[i] = 1 + i % 5;
+        nums[i].resize(lens[i]);
+        for (auto& w : nums[i]) w = rng();
+        nums[i][0] |= 1;
+        ptrs[i] = nums[i].data();
+    }
+    std::unique_ptr<bool[]> res(new bool[count]);
+    abs_is_prime64_batch(ptrs.data(), lens.data(), count, res.get());
+    for (lamp_ui i = 0; i < count; i++) {
+        if (res[i] != abs_is_prime64(ptrs[i], lens[i])) {
+            std::cout << "error in abs_is_prime64_batch, i = " << i << std::endl;
+            return;
+        }
+    }
+    std::cout << "test abs_is_prime64 passed" << std::endl;
+}
+
+};  // namespace test_short
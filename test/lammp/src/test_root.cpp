@@ -0,0 +1,72 @@
+#include "../include/test_short.hpp"
+#include <random>
+#include <vector>
+
+namespace test_short {
+
+void test_root() {
+    using namespace lammp;
+    using namespace lammp::Arithmetic;
+
+    std::mt19937_64 rng(2030);
+    const lamp_ui lens[] = {1, 2, 5, 40, 300};
+    const lamp_ui ks[] = {3, 5, 7, 64, 101};
+    for (lamp_ui len : lens) {
+        for (lamp_ui k : ks) {
+            std::vector<lamp_ui> x(len);
+            for (auto& w : x) w = rng();
+            if (x[len - 1] == 0) x[len - 1] = 1;
+
+            // root^k + rem == x 且 (root + 1)^k > x
+            const lamp_ui root_len = (len + k - 1) / k;
+            std::vector<lamp_ui> root(root_len, 0), rem(len, 0);
+            const lamp_ui rem_len = abs_rootrem64(x.data(), len, k, root.data(), rem.data());
+            std::vector<lamp_ui> p(root_len * k + 2, 0), t(root_len * k + 2, 0);
+            auto pow_k = [&](std::vector<lamp_ui>& r) {
+                // p = r^k，逐次乘以 r
+                const lamp_ui r_len = rlz(r.data(), r.size());
+                std::fill(p.begin(), p.end(), 0);
+                std::copy(r.begin(), r.begin() + r_len, p.begin());
+                lamp_ui p_len = r_len;
+                for (lamp_ui i = 1; i < k; i++) {
+                    std::fill(t.begin(), t.end(), 0);
+                    abs_mul64(p.data(), p_len, r.data(), r_len, t.data());
+                    p_len = rlz(t.data(), p_len + r_len);
+                    std::swap(p, t);
+                }
+                return p_len;
+            };
+            lamp_ui p_len = pow_k(root);
+            std::vector<lamp_ui> sum(std::max(p_len, len) + 1, 0);
+            abs_add_binary(p.data(), p_len, rem.data(), rem_len, sum.data());
+            bool ok = abs_compare(sum.data(), rlz(sum.data(), sum.size()), x.data(), len) == 0;
+            std::vector<lamp_ui> root1(root_len + 1, 0);
+            abs_mul_add_num64(root.data(), root_len, root1.data(), 1, 1);
+            p.resize((root_len + 1) * k + 2);
+            t.resize(p.size());
+            p_len = pow_k(root1);
+            ok = ok && abs_compare(p.data(), p_len, x.data(), len) > 0;
+            if (!ok) {
+                std::cout << "error in abs_rootrem64, len = " << len << ", k = " << k << std::endl;
+                return;
+            }
+
+            // root^k 是完全幂，root^k + 2（root > 1 时）不是
+            if (rlz(root.data(), root_len) == 1 && root[0] < 2) {
+                continue;
+            }
+            p.resize(root_len * k + 2);
+            t.resize(p.size());
+            p_len = pow_k(root);
+            const bool is_pp = abs_is_perfect_power64(p.data(), p_len);
+            abs_mul_add_num64(p.data(), p_len, p.data(), 2, 1);
+            if (!is_pp || abs_is_perfect_power64(p.data(), p_len + 1)) {
+                std::cout << "error in abs_is_perfect_power64, len = " << len << ", k = " << k << std::endl;
+                return;
+            }
+        }
+    }
+    std::cout << "test abs_rootrem64 passed" << std::endl;
+}
+
+};  // namespace test_short
@@ -0,0 +1,132 @@
+#include "../include/test_short.hpp"
+#include <random>
+#include <vector>
+
+namespace test_short {
+
+namespace {
+
+// 2^p - 1 或 2^p + 1
+std::vector<uint64_t> _modulus(uint64_t p, bool plus) {
+    std::vector<uint64_t> m(p / 64 + 1, 0);
+    for (uint64_t bit = 0; bit < p; bit++) {
+        if (!plus) {
+            m[bit / 64] |= 1ull << (bit % 64);
+        }
+    }
+    if (plus) {
+        m[0] = 1;
+        m[p / 64] |= 1ull << (p % 64);
+    }
+    m.resize(lammp::Arithmetic::rlz(m.data(), m.size()));
+    return m;
+}
+
+// 参考结果：x mod m（sqr 时为 x^2 mod m），用普通的乘法与除法
+std::vector<uint64_t> _ref(std::vector<uint64_t> x, const std::vector<uint64_t>& m, bool sqr) {
+    using namespace lammp::Arithmetic;
+    x.resize(rlz(x.data(), x.size()));
+    if (sqr && !x.empty()) {
+        std::vector<lamp_ui> s(x.size() * 2);
+        abs_mul64(x.data(), x.size(), x.data(), x.size(), s.data());
+        x = s;
+        x.resize(rlz(x.data(), x.size()));
+    }
+    if (x.empty()) {
+        return x;
+    }
+    std::vector<lamp_ui> r(m.size() + 1, 0);
+    r.resize(abs_mod64(x.data(), x.size(), lamp_ptr(m.data()), m.size(), r.data()));
+    return r;
+}
+
+};  // namespace
+
+void test_sqr_mod() {
+    using namespace lammp;
+    using namespace lammp::Arithmetic;
+
+    // 与完整平方后取模比较；p 覆盖单字、非整字、任意 p 的完整平方，以及 p = bits * 2^k 的循环、负循环卷积
+    std::mt19937_64 rng(40);
+    for (lamp_ui p : {1ull, 7ull, 64ull, 65ull, 127ull, 521ull, 4096ull, 86243ull, 65536ull, 196608ull, 655360ull,
+                      1048576ull}) {
+        for (bool plus : {false, true}) {
+            const std::vector<lamp_ui> m = _modulus(p, plus);
+            std::vector<std::vector<lamp_ui>> xs;
+            for (lamp_ui len : {lamp_ui(0), lamp_ui(1), p / 64 + 1, p / 32 + 5}) {
+                std::vector<lamp_ui> x(len);
+                for (auto& w : x) {
+                    w = rng();
+                }
+                xs.push_back(x);
+            }
+            // m - 1 ≡ -1
+            std::vector<lamp_ui> m1 = m;
+            abs_sub_binary_num(m1.data(), m1.size(), 1, m1.data());
+            xs.push_back(m1);
+            if (plus) {
+                // 2^p 在卷积路径中单独处理
+                std::vector<lamp_ui> top(p / 64 + 1, 0);
+                top[p / 64] = 1ull << (p % 64);
+                xs.push_back(top);
+            }
+            for (auto& x : xs) {
+                std::vector<lamp_ui> out(p / 64 + 1, 0);
+                const std::vector<lamp_ui> ref_mod = _ref(x, m, false), ref_sqr = _ref(x, m, true);
+                lamp_ui len = plus ? abs_mod_fermat64(x.data(), x.size(), p, out.data())
+                                   : abs_mod_mersenne64(x.data(), x.size(), p, out.data());
+                if (len != ref_mod.size() || !std::equal(ref_mod.begin(), ref_mod.end(), out.data())) {
+                    std::cout << "error in abs_mod_" << (plus ? "fermat64" : "mersenne64") << ", p = " << p
+                              << ", x_len = " << x.size() << std::endl;
+                    return;
+                }
+                len = plus ? abs_sqr_mod_fermat64(x.data(), x.size(), p, out.data())
+                           : abs_sqr_mod_mersenne64(x.data(), x.size(), p, out.data());
+                if (len != ref_sqr.size() || !std::equal(ref_sqr.begin(), ref_sqr.end(), out.data())) {
+                    std::cout << "error in abs_sqr_mod_" << (plus ? "fermat64" : "mersenne64") << ", p = " << p
+                              << ", x_len = " << x.size() << std::endl;
+                    return;
+                }
+            }
+        }
+    }
+
+    // Lucas-Lehmer：s = 4，s = s^2 - 2 重复 p - 2 次，M_p 为素数当且仅当 s = 0
+    for (lamp_ui p : {521ull, 607ull, 1279ull, 523ull}) {
+        std::vector<lamp_ui> s(p / 64 + 2, 0), m = _modulus(p, false);
+        s[0] = 4;
+        lamp_ui len = 1;
+        for (lamp_ui i = 0; i + 2 < p; i++) {
+            len = abs_sqr_mod_mersenne64(s.data(), len, p, s.data());
+            if (len == 0 || (len == 1 && s[0] < 2)) {
+                abs_add_binary(s.data(), len, m.data(), m.size(), s.data());
+                len = rlz(s.data(), m.size() + 1);
+            }
+            abs_sub_binary_num(s.data(), len, 2, s.data());
+            len = rlz(s.data(), len);
+        }
+        if ((len == 0) != (p != 523)) {
+            std::cout << "error in Lucas-Lehmer test, p = " << p << std::endl;
+            return;
+        }
+    }
+
+    // Pépin：F_m = 2^(2^m) + 1 为素数当且仅当 3^((F_m - 1) / 2) ≡ -1，F_4 为素数，F_5 不是
+    for (lamp_ui m : {4ull, 5ull}) {
+        const lamp_ui p = 1ull << m;
+        std::vector<lamp_ui> x(p / 64 + 1, 0);
+        x[0] = 3;
+        lamp_ui len = 1;
+        for (lamp_ui i = 0; i + 1 < p; i++) {
+            len = abs_sqr_mod_fermat64(x.data(), len, p, x.data());
+        }
+        const bool minus_one = len == 1 && x[0] == 1ull << p;  // 2^p ≡ -1
+        if (minus_one != (m == 4)) {
+            std::cout << "error in Pepin test, m = " << m << std::endl;
+            return;
+        }
+    }
+    std::cout << "test sqr_mod passed" << std::endl;
+}
+
+};  // namespace test_short
@@ -0,0 +1,147 @@
+#include "../include/test_short.hpp"
+#include <random>
+#include <vector>
+
+namespace test_short {
+
+void test_div_recursive() {
+    using namespace lammp;
+    using namespace lammp::Arithmetic;
+
+    std::mt19937_64 rng(2028);
+    // 覆盖分块（商长于除数）与多层递归，结果与 abs_div_knuth 比较
+    const lamp_ui lens[][2] = {{DIV_RECURSIVE_THRESHOLD, DIV_RECURSIVE_THRESHOLD},
+                               {3 * DIV_RECURSIVE_THRESHOLD + 7, 2 * DIV_RECURSIVE_THRESHOLD + 3},
+                               {2 * DIV_RECURSIVE_THRESHOLD + 1, 7 * DIV_RECURSIVE_THRESHOLD + 5},
+                               {9 * DIV_RECURSIVE_THRESHOLD, 4 * DIV_RECURSIVE_THRESHOLD}};
+    for (auto& len : lens) {
+        const lamp_ui n = len[0], m = len[1];
+        std::vector<lamp_ui> a(n + m + 1, 0), b(n);
+        for (lamp_ui i = 0; i < n + m; i++) a[i] = rng();
+        for (auto& w : b) w = rng();
+        b[n - 1] |= 1ull << 63;
+        std::vector<lamp_ui> q(m + 1, 0), r(n, 0), q_ref(m + 1, 0);
+        abs_div_recursive(a.data(), n + m, b.data(), n, q.data(), r.data());
+        abs_div_knuth(a.data(), n + m, b.data(), n, q_ref.data(), nullptr);
+        if (q != q_ref || !std::equal(r.begin(), r.end(), a.begin())) {
+            std::cout << "error in abs_div_recursive, n = " << n << ", m = " << m << std::endl;
+            return;
+        }
+    }
+
+    // abs_div64 / abs_mod64 的商与余数和 abs_div_knuth 比较，除数均已规格化；
+    // in_place 时商、余数直接写回被除数
+    auto check = [](std::vector<lamp_ui> a, std::vector<lamp_ui> b, bool in_place) {
+        const lamp_ui len = a.size(), n = b.size();
+        std::vector<lamp_ui> ref(a), q_ref(len - n + 1, 0);
+        ref.push_back(0);
+        abs_div_knuth(ref.data(), len, b.data(), n, q_ref.data(), nullptr);
+        std::vector<lamp_ui> q(len + 1, 0), r(n, 0), a_copy(a);
+        if (in_place) {
+            abs_div64(a.data(), len, b.data(), n, a.data());
+            abs_mod64(a_copy.data(), len, b.data(), n, a_copy.data());
+            q.assign(a.begin(), a.begin() + (len - n + 1));
+            r.assign(a_copy.begin(), a_copy.begin() + n);
+        } else {
+            abs_div64(a.data(), len, b.data(), n, q.data());
+            abs_mod64(a.data(), len, b.data(), n, r.data());
+            q.resize(len - n + 1);
+        }
+        return q == q_ref && std::equal(r.begin(), r.end(), ref.begin());
+    };
+    const lamp_ui n = 4 * DIV_RECURSIVE_THRESHOLD, m = 4 * DIV_RECURSIVE_THRESHOLD;
+    // B^n - 1：商取最大值 B^m - 1，余数取 B^n - 2，每一层的商估计都偏大
+    {
+        std::vector<lamp_ui> b(n, ~0ull), q(m, ~0ull), a(n + m, 0);
+        abs_mul64(b.data(), n, q.data(), m, a.data());
+        std::vector<lamp_ui> r(b);
+        r[0]--;
+        abs_add_binary(a.data(), n + m, r.data(), n, a.data());
+        if (!check(a, b, false) || !check(a, b, true)) {
+            std::cout << "error in abs_div64, divisor B^n - 1" << std::endl;
+            return;
+        }
+    }
+    // 2^(64n - 1)：被除数全 1，商与余数都取最大值
+    {
+        std::vector<lamp_ui> b(n, 0), a(n + m, ~0ull);
+        b[n - 1] = 1ull << 63;
+        if (!check(a, b, false)) {
+            std::cout << "error in abs_div64, divisor 2^(64n - 1)" << std::endl;
+            return;
+        }
+    }
+    // 除数 2^(64n - 1) + 2^(64(n - 1)) - 1：高半部分最小、低半部分最大，被除数只有最高位。
+    // 每一层由高半部分估计的商都偏大，需要加回修正；Knuth 基础情形中 q_hat 取 2^64 - 1
+    {
+        std::vector<lamp_ui> b(n, ~0ull), a(n + m, 0);
+        b[n - 1] = 1ull << 63;
+        a[n + m - 1] = 1ull << 63;
+        if (!check(a, b, false) || !check(a, b, true)) {
+            std::cout << "error in abs_div64, add-back at every level" << std::endl;
+            return;
+        }
+        for (lamp_ui i = n; i < n + m; i++) a[i] = ~0ull;
+        a[n + m - 1] = 1ull << 62;
+        if (!check(a, b, false)) {
+            std::cout << "error in abs_div64, add-back at every level" << std::endl;
+            return;
+        }
+    }
+    // 商长、除数长在阈值两侧：分别走 abs_div_knuth 与 abs_div_recursive
+    const lamp_ui sides[] = {DIV_RECURSIVE_THRESHOLD - 1, DIV_RECURSIVE_THRESHOLD, DIV_RECURSIVE_THRESHOLD + 1};
+    for (lamp_ui n2 : sides) {
+        for (lamp_ui m2 : sides) {
+            std::vector<lamp_ui> a(n2 + m2), b(n2);
+            for (auto& w : a) w = rng();
+            for (auto& w : b) w = rng();
+            b[n2 - 1] |= 1ull << 63;
+            if (!check(a, b, false) || !check(a, b, true)) {
+                std::cout << "error in abs_div64, n = " << n2 << ", m = " << m2 << std::endl;
+                return;
+            }
+        }
+    }
+    std::cout << "test abs_div_recursive passed" << std::endl;
+}
+
+void test_sqrt() {
+    using namespace lammp;
+    using namespace lammp::Arithmetic;
+
+    std::mt19937_64 rng(2029);
+    const lamp_ui lens[] = {1, 2, 3, 8, 33, 250, 1001};
+    for (lamp_ui len : lens) {
+        std::vector<lamp_ui> x(len);
+        for (auto& w : x) w = rng();
+        x[len - 1] >>= rng() % 64;
+        if (x[len - 1] == 0) x[len - 1] = 1;
+
+        // root^2 + rem == x 且 rem <= 2 * root
+        const lamp_ui root_len = (len + 1) / 2;
+        std::vector<lamp_ui> root(root_len, 0), rem(root_len + 1, 0), sq(2 * root_len + 1, 0);
+        const lamp_ui rem_len = abs_sqrtrem64(x.data(), len, root.data(), rem.data());
+        abs_sqr64(root.data(), root_len, sq.data());
+        abs_add_binary(sq.data(), 2 * root_len, rem.data(), rem_len, sq.data());
+        std::vector<lamp_ui> twice(root_len + 1, 0);
+        lshift_in_word(root.data(), root_len, twice.data(), 1);
+        if (abs_compare(sq.data(), rlz(sq.data(), 2 * root_len + 1), x.data(), len) != 0 ||
+            abs_compare(rem.data(), rem_len, twice.data(), rlz(twice.data(), root_len + 1)) > 0) {
+            std::cout << "error in abs_sqrtrem64, len = " << len << std::endl;
+            return;
+        }
+
+        // root^2 是完全平方数，root^2 - 1（非零时）不是
+        std::fill(sq.begin(), sq.end(), 0);
+        abs_sqr64(root.data(), root_len, sq.data());
+        const bool is_sq = abs_is_square64(sq.data(), 2 * root_len);
+        abs_sub_binary_num(sq.data(), 2 * root_len, 1, sq.data());
+        if (!is_sq || (rlz(sq.data(), 2 * root_len) > 0 && abs_is_square64(sq.data(), 2 * root_len))) {
+            std::cout << "error in abs_is_square64, len = " << len << std::endl;
+            return;
+        }
+    }
+    std::cout << "test abs_sqrtrem64 passed" << std::endl;
+}
+
+};  // namespace test_short
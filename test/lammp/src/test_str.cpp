@@ -0,0 +1,207 @@
+#include "../include/test_short.hpp"
+#include "../../../include/lammp/lampz.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace test_short {
+
+namespace {
+
+const char* _path = "lammp_test_str.tmp";
+
+// 把字符串写入文件，返回可读的 FILE*（已回到开头）
+FILE* _file_of(const std::string& s) {
+    FILE* f = std::fopen(_path, "wb+");
+    std::fwrite(s.data(), 1, s.size(), f);
+    std::fflush(f);
+    std::rewind(f);
+    return f;
+}
+
+bool _same(const lampz_t x, const lampz_t y) {
+    const lamp_sz len = lampz_get_len(x);
+    return !lampz_is_nan(y) && x->len == y->len && std::equal(x->begin, x->begin + len, y->begin);
+}
+
+// 读入 s，返回是否成功
+bool _read(lampz_t z, const std::string& s, uint64_t base, bool mmap) {
+    FILE* f = _file_of(s);
+    lamp_sz peak = 0;
+    const lamp_sz n = mmap ? lampz_set_str_mmap(z, _path, base, &peak) : lampz_inp_str_fd(z, fileno(f), base, &peak);
+    std::fclose(f);
+    return n == s.size() && !lampz_is_nan(z) && peak > 0;
+}
+
+};  // namespace
+
+void test_str() {
+    using namespace lammp;
+    using namespace lammp::Arithmetic;
+
+    // lampz_out_str_fd 写出后分别用 lampz_inp_str_fd 与 lampz_set_str_mmap 读回，长度覆盖单个叶子、合并与不足一个叶子的尾部
+    std::mt19937_64 rng(44);
+    for (lamp_ui base : {10ull, 7ull, 36ull, 16ull}) {
+        for (lamp_ui len : {1ull, 2ull, 100ull, 5000ull, 40000ull}) {
+            if (len == 40000 && base != 10) {
+                continue;
+            }
+            lampz_t x, y;
+            __lampz_init(x);
+            __lampz_init(y);
+            __lampz_talloc(x, len);
+            for (lamp_ui i = 0; i < len; i++) {
+                x->begin[i] = rng();
+            }
+            x->len = (len % 2 == 0) ? -lamp_si(len) : lamp_si(len);
+            FILE* f = std::fopen(_path, "wb+");
+            const lamp_sz n = lampz_out_str_fd(fileno(f), x, base);
+            std::fclose(f);
+            for (bool mmap : {false, true}) {
+                f = std::fopen(_path, "rb");
+                lamp_sz peak = 0;
+                const lamp_sz m =
+                    mmap ? lampz_set_str_mmap(y, _path, base, &peak) : lampz_inp_str_fd(y, fileno(f), base, &peak);
+                std::fclose(f);
+                if (n == 0 || m != n || !_same(x, y)) {
+                    std::cout << "error in lampz_inp_str_fd, base = " << base << ", len = " << len
+                              << ", mmap = " << mmap << std::endl;
+                    return;
+                }
+                // 最后一次折叠同时持有结果、被折叠的两块与基数幂；除去 1 MiB 的读取缓冲后在结果的 1 到 4 倍之间
+                const lamp_sz blocks = mmap ? peak : peak - (lamp_sz(1) << 20);
+                if (len >= 5000 && (blocks < len * sizeof(lamp_ui) || blocks > 4 * len * sizeof(lamp_ui))) {
+                    std::cout << "error in lampz_inp_str_fd, peak_block_bytes = " << peak << ", len = " << len
+                              << ", mmap = " << mmap << std::endl;
+                    return;
+                }
+            }
+            lampz_free(x);
+            lampz_free(y);
+        }
+    }
+
+    // 幂次缓存上限为 0 时，读取所用的 P_j 只为本次读取计算
+    {
+        lampz_t x, y;
+        __lampz_init(x);
+        __lampz_init(y);
+        __lampz_talloc(x, 5000);
+        for (lamp_ui i = 0; i < 5000; i++) {
+            x->begin[i] = rng();
+        }
+        x->len = 5000;
+        FILE* f = std::fopen(_path, "wb+");
+        const lamp_sz n = lampz_out_str_fd(fileno(f), x, 10);
+        std::fclose(f);
+        Numeral::clear_pow_cache();
+        Numeral::set_pow_cache_limit(0);
+        lamp_sz peak = 0;
+        const lamp_sz m = lampz_set_str_mmap(y, _path, 10, &peak);
+        Numeral::set_pow_cache_limit(Numeral::POW_CACHE_DEFAULT_WORDS);
+        if (n == 0 || m != n || !_same(x, y)) {
+            std::cout << "error in lampz_set_str_mmap, pow cache disabled" << std::endl;
+            return;
+        }
+        lampz_free(x);
+        lampz_free(y);
+    }
+
+    // 前后空白、前导零、零与负零；非法输入置为 nan
+    lampz_t z, expect;
+    __lampz_init(z);
+    __lampz_init(expect);
+    const std::vector<std::pair<std::string, lamp_si>> cases = {{"  \n-000123\n", -123}, {"0", 0}, {"-0", 0}, {"\t42", 42}};
+    for (const auto& c : cases) {
+        lampz_set_si(expect, c.second);
+        for (bool mmap : {false, true}) {
+            if (!_read(z, c.first, 10, mmap) || !_same(expect, z)) {
+                std::cout << "error in lampz_inp_str_fd, input = " << c.first << std::endl;
+                return;
+            }
+        }
+    }
+    if (!_read(z, "18446744073709551616", 10, false) || z->len != 2 || z->begin[0] != 0 || z->begin[1] != 1) {
+        std::cout << "error in lampz_inp_str_fd, input = 2^64" << std::endl;
+        return;
+    }
+    for (const std::string bad : {"", "  ", "-", "12a", "1 2", "--1", "12\n3"}) {
+        for (bool mmap : {false, true}) {
+            lampz_set_ui(z, 1);
+            if (_read(z, bad, 10, mmap) || !lampz_is_nan(z)) {
+                std::cout << "error in lampz_inp_str_fd, invalid input = \"" << bad << "\"" << std::endl;
+                return;
+            }
+        }
+    }
+    // 十进制逐 8、16 个字符的 SWAR 解析：非法字符出现在块内任意位置（含只差一的 '/'、':'）都应被发现
+    const std::string digits = "314159265358979323846264338327950288419716939937510582097494459230781640628620";
+    for (lamp_ui pos = 0; pos < digits.size(); pos++) {
+        for (char bad : {'/', ':', 'a', char(0xB0)}) {
+            std::string s = digits;
+            s[pos] = bad;
+            lampz_set_ui(z, 1);
+            if (_read(z, s, 10, false) || !lampz_is_nan(z)) {
+                std::cout << "error in lampz_inp_str_fd, invalid char at " << pos << std::endl;
+                return;
+            }
+        }
+    }
+
+    // lampz_set_str、lampz_to_str（小端序字符串）与 lampz_out_str_fd 的输出一致：十进制与十六进制（含大写）的整块解析，
+    // 以及 2 的幂进制的按位打包（8、32 进制的字符跨越字的边界）
+    for (lamp_ui base : {10ull, 16ull, 2ull, 4ull, 8ull, 32ull}) {
+        for (lamp_ui len : {1ull, 3ull, 50ull}) {
+            lampz_t x, y;
+            __lampz_init(x);
+            __lampz_init(y);
+            __lampz_talloc(x, len);
+            for (lamp_ui i = 0; i < len; i++) {
+                x->begin[i] = rng();
+            }
+            x->len = lamp_si(len);
+            FILE* f = std::fopen(_path, "wb+");
+            const lamp_sz n = lampz_out_str_fd(fileno(f), x, base);
+            std::rewind(f);
+            std::string s(n, '0');
+            const bool ok = std::fread(&s[0], 1, n, f) == n;
+            std::fclose(f);
+            std::reverse(s.begin(), s.end());
+            std::string t(lampz_to_str_len(x, base), '?');
+            t.resize(lampz_to_str(&t[0], t.size(), x, base));
+            if (t != s) {
+                std::cout << "error in lampz_to_str, base = " << base << ", len = " << len << std::endl;
+                return;
+            }
+            for (bool upper : {false, true}) {
+                if (upper) {
+                    std::transform(s.begin(), s.end(), s.begin(), [](char c) { return char(std::toupper(c)); });
+                }
+                lampz_set_str(y, s.data(), s.size(), base);
+                if (!ok || !_same(x, y)) {
+                    std::cout << "error in lampz_set_str, base = " << base << ", len = " << len << std::endl;
+                    return;
+                }
+            }
+            lampz_free(x);
+            lampz_free(y);
+        }
+    }
+    // 一个字的十进制可达 20 位（2^64 - 1），lampz_to_str_len 的长度恰好够用
+    lampz_set_ui(z, ~uint64_t(0));
+    std::vector<char> buf(lampz_to_str_len(z, 10));
+    const std::string max_word(buf.data(), lampz_to_str(buf.data(), buf.size(), z, 10));
+    if (max_word != "51615590737044764481") {
+        std::cout << "error in lampz_to_str, 2^64 - 1" << std::endl;
+        return;
+    }
+    lampz_free(z);
+    lampz_free(expect);
+    std::remove(_path);
+    std::cout << "test str passed" << std::endl;
+}
+
+};  // namespace test_short